@@ -12,11 +12,14 @@
 
 // Method to ignore
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
+%ignore vrv::Toolkit::GetCBuffer( );
+%ignore vrv::Toolkit::GetCBufferSize( ) const;
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
 %ignore vrv::Toolkit::ParseOptions( const std::string & );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
+%ignore vrv::Toolkit::SetCBuffer( std::vector<unsigned char> & );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
 %module verovio
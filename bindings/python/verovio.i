@@ -12,14 +12,20 @@
 
 // Method to ignore
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
+%ignore vrv::Toolkit::GetCBuffer( );
+%ignore vrv::Toolkit::GetCBufferSize( ) const;
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
+%ignore vrv::Toolkit::SetCBuffer( std::vector<unsigned char> & );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
 %module(package="verovio") verovio
 %include "std_string.i"
+%include "std_vector.i"
+%template(StringVector) std::vector<std::string>;
+%template(ByteVector) std::vector<unsigned char>;
 %include "../../include/vrv/toolkit.h"
 
 %{
@@ -18,12 +18,18 @@ verovio.vrvToolkit.editInfo = Module.cwrap( 'vrvToolkit_editInfo', 'string', ['n
 // char *getAvailableOptions(Toolkit *ic)
 verovio.vrvToolkit.getAvailableOptions = Module.cwrap( 'vrvToolkit_getAvailableOptions', 'string', ['number'] );
 
+// const unsigned char *getBinaryBuffer(Toolkit *ic)
+verovio.vrvToolkit.getBinaryBuffer = Module.cwrap( 'vrvToolkit_getBinaryBuffer', 'number', ['number'] );
+
 // char *getElementAttr(Toolkit *ic, const char *xmlId)
 verovio.vrvToolkit.getElementAttr = Module.cwrap( 'vrvToolkit_getElementAttr', 'string', ['number', 'string'] );
 
 // char *getElementsAtTime(Toolkit *ic, int time)
 verovio.vrvToolkit.getElementsAtTime = Module.cwrap( 'vrvToolkit_getElementsAtTime', 'string', ['number', 'number'] );
 
+// char *getElementsAtTimes(Toolkit *ic, const char *jsonTimes)
+verovio.vrvToolkit.getElementsAtTimes = Module.cwrap( 'vrvToolkit_getElementsAtTimes', 'string', ['number', 'string'] );
+
 // char *vrvToolkit_getExpansionIdsForElement(Toolkit *tk, const char *xmlId);
 verovio.vrvToolkit.getExpansionIdsForElement = Module.cwrap( 'vrvToolkit_getExpansionIdsForElement', 'string', ['number', 'string'] );
 
@@ -87,6 +93,9 @@ verovio.vrvToolkit.renderData = Module.cwrap( 'vrvToolkit_renderData', 'string',
 // char *renderToMidi(Toolkit *ic, const char *rendering_options)
 verovio.vrvToolkit.renderToMIDI = Module.cwrap( 'vrvToolkit_renderToMIDI', 'string', ['number', 'string'] );
 
+// int renderToMIDIBinary(Toolkit *ic)
+verovio.vrvToolkit.renderToMIDIBinary = Module.cwrap( 'vrvToolkit_renderToMIDIBinary', 'number', ['number'] );
+
 // char *renderToPAE(Toolkit *ic)
 verovio.vrvToolkit.renderToPAE = Module.cwrap( 'vrvToolkit_renderToPAE', 'string' );
 
@@ -96,6 +105,9 @@ verovio.vrvToolkit.renderToSVG = Module.cwrap( 'vrvToolkit_renderToSVG', 'string
 // char *renderToTimemap(Toolkit *ic)
 verovio.vrvToolkit.renderToTimemap = Module.cwrap( 'vrvToolkit_renderToTimemap', 'string', ['number'] );
 
+// int renderToTimemapBinary(Toolkit *ic)
+verovio.vrvToolkit.renderToTimemapBinary = Module.cwrap( 'vrvToolkit_renderToTimemapBinary', 'number', ['number'] );
+
 // void setOptions(Toolkit *ic, const char *options) 
 verovio.vrvToolkit.setOptions = Module.cwrap( 'vrvToolkit_setOptions', null, ['number', 'string'] );
 
@@ -143,6 +155,11 @@ verovio.toolkit.prototype.getElementsAtTime = function ( millisec )
     return JSON.parse( verovio.vrvToolkit.getElementsAtTime( this.ptr, millisec ) );
 };
 
+verovio.toolkit.prototype.getElementsAtTimes = function ( millisecs )
+{
+    return JSON.parse( verovio.vrvToolkit.getElementsAtTimes( this.ptr, JSON.stringify( millisecs ) ) );
+};
+
 verovio.toolkit.prototype.getExpansionIdsForElement = function ( xmlId )
 {
     return JSON.parse( verovio.vrvToolkit.getExpansionIdsForElement( this.ptr, xmlId ) );
@@ -278,6 +295,13 @@ verovio.toolkit.prototype.renderToMIDI = function ( options )
     return verovio.vrvToolkit.renderToMIDI( this.ptr, JSON.stringify( options ) );
 };
 
+verovio.toolkit.prototype.renderToMIDIBinary = function ()
+{
+    var dataSize = verovio.vrvToolkit.renderToMIDIBinary( this.ptr );
+    var dataPtr = verovio.vrvToolkit.getBinaryBuffer( this.ptr );
+    return Module.HEAPU8.slice( dataPtr, dataPtr + dataSize ).buffer;
+};
+
 verovio.toolkit.prototype.renderToMidi = function ( options )
 {
     console.warn( "Method renderToMidi is deprecated; use renderToMIDI instead" );
@@ -299,6 +323,13 @@ verovio.toolkit.prototype.renderToTimemap = function ()
     return JSON.parse( verovio.vrvToolkit.renderToTimemap( this.ptr ) );
 };
 
+verovio.toolkit.prototype.renderToTimemapBinary = function ()
+{
+    var dataSize = verovio.vrvToolkit.renderToTimemapBinary( this.ptr );
+    var dataPtr = verovio.vrvToolkit.getBinaryBuffer( this.ptr );
+    return Module.HEAPU8.slice( dataPtr, dataPtr + dataSize ).buffer;
+};
+
 verovio.toolkit.prototype.setOptions = function ( options )
 {
     verovio.vrvToolkit.setOptions( this.ptr, JSON.stringify( options ) );
@@ -138,6 +138,11 @@ public:
     virtual ClassId GetClassId() const { return BEAM; }
     ///@}
 
+    /**
+     * Overriding CloneReset() method to be called after copy / assignment calls.
+     */
+    virtual void CloneReset();
+
     int GetNoteCount() const { return this->GetChildCount(NOTE); }
 
     /**
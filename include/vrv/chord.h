@@ -55,6 +55,11 @@ public:
     virtual ClassId GetClassId() const { return CHORD; }
     ///@}
 
+    /**
+     * Overriding CloneReset() method to be called after copy / assignment calls.
+     */
+    virtual void CloneReset();
+
     /**
      * @name Getter to interfaces
      */
@@ -68,6 +68,7 @@ public:
         m_contentHeight = 0;
         m_userScaleX = 1.0;
         m_userScaleY = 1.0;
+        m_textExtentCache = NULL;
     }
     virtual ~DeviceContext(){};
     virtual ClassId GetClassId() const;
@@ -94,6 +95,11 @@ public:
     double GetUserScaleY() { return m_userScaleY; }
     ///@}
 
+    /**
+     * Set the cache in which the text extends are looked up and stored (none by default)
+     */
+    void SetTextExtentCache(TextExtentCache *textExtentCache) { m_textExtentCache = textExtentCache; }
+
     /**
      * @name Setters
      * Non-virtual methods cannot be overridden and manage the Pen, Brush and FontInfo stacks
@@ -278,7 +284,7 @@ public:
     static int RGB2Int(char red, char green, char blue) { return (red << 16 | green << 8 | blue); }
 
 private:
-    void AddGlyphToTextExtend(Glyph *glyph, TextExtend *extend);
+    void AddGlyphToTextExtend(const Glyph *glyph, TextExtend *extend);
 
 public:
     //
@@ -304,6 +310,9 @@ private:
     /** stores the scale as requested by the used */
     double m_userScaleX;
     double m_userScaleY;
+
+    /** the cache for the text extends (if any) */
+    TextExtentCache *m_textExtentCache;
 };
 
 } // namespace vrv
@@ -8,7 +8,11 @@
 #ifndef __VRV_DC_BASE_H__
 #define __VRV_DC_BASE_H__
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 //----------------------------------------------------------------------------
 
@@ -280,6 +284,38 @@ public:
     // no copy ctor or assignment operator - the defaults are ok
 };
 
+// ---------------------------------------------------------------------------
+// TextExtentCache
+// ---------------------------------------------------------------------------
+
+/**
+ * This class stores the text extends calculated for a document.
+ * The extends are looked up by string, text font style, point size and type size flag. The cache has to be reset
+ * when the fonts or the options change. Access is synchronized since pages can be laid out in parallel.
+ */
+
+class TextExtentCache {
+public:
+    TextExtentCache() {}
+    TextExtentCache(const TextExtentCache &) = delete;
+    TextExtentCache &operator=(const TextExtentCache &) = delete;
+
+    /** Set the extend if the string was measured before and return true */
+    bool Get(const std::wstring &string, const Resources::StyleAttributes &style, int pointSize, bool typeSize,
+        TextExtend &extend) const;
+    /** Store the extend calculated for a string */
+    void Set(const std::wstring &string, const Resources::StyleAttributes &style, int pointSize, bool typeSize,
+        const TextExtend &extend);
+    /** Remove all the extends */
+    void Reset();
+
+private:
+    using FontKey = std::tuple<Resources::StyleAttributes, int, bool>;
+    mutable std::mutex m_mutex;
+    /** The extends by string for each font (style, point size and type size flag) */
+    std::map<FontKey, std::unordered_map<std::wstring, TextExtend>> m_extends;
+};
+
 } // namespace vrv
 
 #endif // __AX_DC_BASE_H__
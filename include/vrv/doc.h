@@ -23,12 +23,120 @@ namespace vrv {
 class CastOffPagesParams;
 class FontInfo;
 class Glyph;
+class Measure;
 class Pages;
 class Page;
+class RunningElement;
 class Score;
 
 enum DocType { Raw = 0, Rendering, Transcription, Facs };
 
+//----------------------------------------------------------------------------
+// TimeIndexEntry
+//----------------------------------------------------------------------------
+
+/**
+ * An entry of the time index of the document (see Doc::FindNotesAtTime).
+ * Entries are sorted by onset and m_maxOffset is the maximum offset of all the entries up to this one, which makes
+ * it possible to stop the backward scan of the overlapping entries early.
+ */
+struct TimeIndexEntry {
+    double m_onset;
+    double m_offset;
+    double m_maxOffset;
+    /** The position of the object in the document order */
+    int m_order;
+    /** The repeat (1-based) for measures */
+    int m_repeat;
+    Object *m_object;
+};
+
+//----------------------------------------------------------------------------
+// MidiTimemapData
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the timing values of the measures and notes calculated for the MIDI timemap, in document order.
+ * It can be given to a document loaded again from the same data with the same timing options (see
+ * Doc::SetMidiTimemapData) for the values to be restored instead of being calculated again. The key identifies the
+ * data and the options and is set by the toolkit.
+ */
+class MidiTimemapData {
+public:
+    MidiTimemapData() { Reset(); }
+    void Reset();
+    bool IsEmpty() const { return m_values.empty(); }
+
+public:
+    std::string m_key;
+    /** The tempo adjustment the values were calculated with */
+    double m_tempoAdjustment;
+    /** The number of measures, notes and beatRpts */
+    int m_objectCount;
+    std::vector<double> m_values;
+};
+
+//----------------------------------------------------------------------------
+// DrawingPageValues
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the values used when laying out and drawing a page. They are set in Doc::SetDrawingPage.
+ * Each thread laying out and drawing pages in parallel has its own instance (see Doc::SetThreadDrawingValues).
+ * The pages dimensions and margins are based on the page ones, the document ones or the default in the following
+ * order and if available. Most of the other values are based on the options and remain the same for all pages.
+ */
+class DrawingPageValues {
+public:
+    DrawingPageValues() { Reset(); }
+    ~DrawingPageValues();
+    DrawingPageValues(const DrawingPageValues &) = delete;
+    DrawingPageValues &operator=(const DrawingPageValues &) = delete;
+    void Reset();
+
+public:
+    /** The page currently being drawn */
+    Page *m_page;
+    /** The current page height */
+    int m_pageHeight;
+    /** The current page width */
+    int m_pageWidth;
+    /** The current page content height (without margings) */
+    int m_pageContentHeight;
+    /** The current page content width (without margins) */
+    int m_pageContentWidth;
+    /** The current page bottom margin */
+    int m_pageMarginBottom;
+    /** The current page left margin */
+    int m_pageMarginLeft;
+    /** The current page right margin */
+    int m_pageMarginRight;
+    /** The current page top margin */
+    int m_pageMarginTop;
+    /** the current beam minimal slope */
+    float m_beamMinSlope;
+    /** the current beam maximal slope */
+    float m_beamMaxSlope;
+    /** Height of a beam (10 and 6 by default) */
+    int m_beamWidth;
+    /** Height of a beam spacing (white) (10 and 6 by default) */
+    int m_beamWhiteWidth;
+    /** Ledger line length and normal and grace size */
+    int m_ledgerLine;
+    /** Brevis width */
+    int m_brevisWidth;
+    /** Smufl font size (100 par defaut) */
+    int m_smuflFontSize;
+    /** Lyric font size  */
+    int m_lyricFontSize;
+    /** Current music font */
+    FontInfo m_smuflFont;
+    /** Current lyric font */
+    FontInfo m_lyricFont;
+    /** The copies of the running elements owned by these values (see Doc::CopyRunningElements) */
+    std::map<RunningElement *, RunningElement *> m_runningElements;
+};
+
 //----------------------------------------------------------------------------
 // Doc
 //----------------------------------------------------------------------------
@@ -121,6 +229,19 @@ public:
      */
     int GetPageCount();
 
+    /**
+     * @name Methods for the uuid index of the document
+     * The index is built when looking up an object for the second time without uuid changes or object deletions in
+     * between (see Object::GetUuidRevision). Objects added afterwards are not indexed until found by a tree walk.
+     * GetIndexedObject returns NULL if the uuid is not indexed. CheckUuidIndex compares the index to a tree walk and
+     * is meant for debugging.
+     */
+    ///@{
+    Object *GetIndexedObject(const std::string &uuid);
+    void AddToUuidIndex(Object *object);
+    bool CheckUuidIndex();
+    ///@}
+
     /**
      * Return true if the MIDI generation is already done
      */
@@ -176,6 +297,12 @@ public:
     FontInfo *GetDrawingLyricFont(int staffSize);
     ///@}
 
+    /**
+     * The text extends calculated when drawing the document.
+     * The cache needs to be reset when the fonts or the options are changed.
+     */
+    TextExtentCache *GetTextExtentCache() { return &m_textExtentCache; }
+
     /**
      * @name Getters for the object margins (left and right).
      * The margins are given in x * MEI UNIT
@@ -207,6 +334,31 @@ public:
      */
     bool HasMidiTimemap();
 
+    /**
+     * Mark the MIDI timemap as to be calculated again.
+     * To be called when the content is modified because changes in the timing cannot be detected otherwise.
+     */
+    void InvalidateMidiTimemap();
+
+    /**
+     * Get the values of the MIDI timemap of the document. The data is left empty if it has not been calculated.
+     */
+    void GetMidiTimemapData(MidiTimemapData &data);
+
+    /**
+     * Set the data from which the MIDI timemap will be restored when it is needed.
+     * The data is not owned by the document and has to remain valid until the document is reset.
+     */
+    void SetMidiTimemapData(const MidiTimemapData *data) { m_midiTimemapData = data; }
+
+    /**
+     * Find the measure and the notes sounding at the given time (in milliseconds).
+     * This is equivalent to looking for the first measure enclosing the time and then for the notes of that measure
+     * with a MeasureOnsetOffsetComparison and a NoteOnsetOffsetComparison, but it uses a time index built with the
+     * MIDI timemap. The notes are returned in document order. Returns NULL if no measure encloses the time.
+     */
+    Measure *FindNotesAtTime(int millisec, ListOfObjects *notes);
+
     /**
      * Export the document to a MIDI file.
      * Run trough all the layers and fill the midi file content.
@@ -222,6 +374,23 @@ public:
         std::map<double, std::vector<std::string>> &realTimeToOnElements,
         std::map<double, std::vector<std::string>> &realTimeToOffElements, std::map<double, int> &realTimeToTempo);
 
+    /**
+     * Extract a timemap from the document to a binary buffer.
+     * All values are little-endian. The buffer starts with a 24-byte header:
+     * - the signature "VRVT" and the format version (uint32, currently 1)
+     * - the number of entries, of id indices and of ids, and the size in bytes of the id table (uint32)
+     * It is followed by the entries sorted by real time, each of 32 bytes:
+     * - the real time in ms and the score time in quarter notes (float64)
+     * - the tempo (int32), carried over from the previous entry when it does not change
+     * - the position of the first id index of the entry, the number of "on" ids and the number of "off" ids (uint32)
+     * Then come the id indices (uint32, "on" ids followed by the "off" ids of each entry) and the id table
+     * with the null-terminated ids, each id appearing only once.
+     */
+    bool ExportTimemapBinary(std::vector<unsigned char> &output);
+    void PrepareBinaryTimemap(std::vector<unsigned char> &output, std::map<double, double> &realTimeToScoreTime,
+        std::map<double, std::vector<std::string>> &realTimeToOnElements,
+        std::map<double, std::vector<std::string>> &realTimeToOffElements, std::map<double, int> &realTimeToTempo);
+
     /**
      * Set the initial scoreDef of each page.
      * This is necessary for integrating changes that occur within a page.
@@ -278,6 +447,18 @@ public:
      */
     void CastOffDocBase(bool useSb, bool usePb, bool smart = false);
 
+    /**
+     * Cast off the measures left on the pending page by a progressive cast-off (see Options::m_breaksProgressive).
+     * The pages already cast off are kept. Nothing is done if the document is entirely cast off.
+     */
+    void CastOffPendingDoc();
+
+    /**
+     * Return true if the end of the document still has to be cast off with Doc::CastOffPendingDoc.
+     * The pending measures are then all on the last page.
+     */
+    bool IsCastOffPending() const { return m_isCastOffPending; }
+
     /**
      * Casts off the running elements (headers and footer)
      * Called from Doc::CastOffDoc
@@ -299,6 +480,25 @@ public:
      */
     void CastOffEncodingDoc();
 
+    /**
+     * Redo the layout of the pages with modified measures (see Measure::Modify) and of the pages with spanning
+     * elements attached to them, keeping the current cast-off.
+     * Return false if the cast-off has to be redone, that is when the width or the height of a measure or of a
+     * system changed, or when the modification can affect other pages (e.g., a clef change).
+     */
+    bool LayOutModifiedMeasures();
+
+    /**
+     * Reset the modification flag of all the measures once the layout has been redone.
+     */
+    void ResetLayoutModified();
+
+    /**
+     * Mark the cast-off as invalid for modifications not tracked by the measures (e.g., in a scoreDef).
+     * LayOutModifiedMeasures will return false until the layout is redone.
+     */
+    void InvalidateCastOff() { m_isCastOffInvalid = true; }
+
     /**
      * Convert the doc from score-based to page-based MEI.
      * Containers will be converted to boundaryStart / boundaryEnd.
@@ -352,14 +552,53 @@ public:
      * We need to call this because otherwise looking at the page idx will fail.
      * See Doc::LayOut for an example.
      */
-    void ResetDrawingPage() { m_drawingPage = NULL; }
+    void ResetDrawingPage() { this->GetDrawingValues()->m_page = NULL; }
 
     /**
      * Getter to the drawPage. Normally, getting the page should
      * be done with Doc::SetDrawingPage. This is only a method for
      * asserting that currently have the right page.
      */
-    Page *GetDrawingPage() const { return m_drawingPage; }
+    Page *GetDrawingPage() const { return this->GetDrawingValues()->m_page; }
+
+    /**
+     * Return the values of the page being drawn for the calling thread.
+     */
+    ///@{
+    DrawingPageValues *GetDrawingValues()
+    {
+        return (s_threadDrawingValues && (s_threadDrawingDoc == this)) ? s_threadDrawingValues : &m_drawingValues;
+    }
+    const DrawingPageValues *GetDrawingValues() const
+    {
+        return (s_threadDrawingValues && (s_threadDrawingDoc == this)) ? s_threadDrawingValues : &m_drawingValues;
+    }
+    ///@}
+
+    /**
+     * Set the drawing values to be used by the calling thread instead of the ones of the doc.
+     * This makes it possible to lay out and draw different pages in parallel, each thread with its own values.
+     * Passing NULL restores the values of the doc for the calling thread.
+     */
+    void SetThreadDrawingValues(DrawingPageValues *drawingValues);
+
+    /**
+     * Copy the running elements (headers and footers) to the drawing values.
+     * Running elements are shared by the pages and are modified when laying out and drawing a page.
+     * The copies keep the uuids of the originals and are used when the drawing values are the ones of the thread.
+     */
+    void CopyRunningElements(DrawingPageValues *drawingValues);
+
+    /**
+     * Return the running element to use with the current drawing values, i.e., the original or its copy.
+     */
+    RunningElement *GetDrawingRunningElement(RunningElement *runningElement);
+
+    /**
+     * Return the ranges of pages (first and last page indexes) that can be laid out and drawn independently.
+     * Pages sharing elements, for example with a slur or an ending across a page break, are in the same range.
+     */
+    std::vector<std::pair<int, int>> GetIndependentPageRanges();
 
     /**
      * Return the width adjusted to the content of the current drawing page.
@@ -417,6 +656,36 @@ private:
      */
     int CalcMusicFontSize();
 
+    /**
+     * Build the time index of the measures and notes from the MIDI timemap.
+     */
+    void PrepareTimeIndex();
+
+    /**
+     * Restore the MIDI timemap from the data set with SetMidiTimemapData.
+     * Return false if the data does not match the document.
+     */
+    bool RestoreMidiTimemap(const MidiTimemapData &data);
+
+    /**
+     * Cast off the content page, which is the last page of the document, into systems and pages.
+     * The scoreDefs have to be set again once done.
+     * Called from Doc::CastOffDocBase and Doc::CastOffPendingDoc
+     */
+    void CastOffContentPage(bool useSb, bool usePb, bool smart);
+
+    /**
+     * @name Methods for the progressive cast-off
+     * DetachPendingPage moves the content following the first measures of the content page to a new page,
+     * and returns it (or NULL if there are not more measures than the number given).
+     * MoveLastPageToPendingPage moves back the content of the last page, which might not be complete, to the front
+     * of the pending page.
+     */
+    ///@{
+    Page *DetachPendingPage(int measureCount);
+    void MoveLastPageToPendingPage(Page *pendingPage);
+    ///@}
+
 public:
     /**
      * A copy of the header tree stored as pugi::xml_document
@@ -439,27 +708,6 @@ public:
      */
     ScoreDef m_mdivScoreDef;
 
-    /** The current page height */
-    int m_drawingPageHeight;
-    /** The current page width */
-    int m_drawingPageWidth;
-    /** The current page content height (without margings) */
-    int m_drawingPageContentHeight;
-    /** The current page content width (without margins) */
-    int m_drawingPageContentWidth;
-    /** The current page bottom margin */
-    int m_drawingPageMarginBottom;
-    /** The current page left margin */
-    int m_drawingPageMarginLeft;
-    /** The current page right margin */
-    int m_drawingPageMarginRight;
-    /** The current page top margin */
-    int m_drawingPageMarginTop;
-    /** the current beam minimal slope */
-    float m_drawingBeamMinSlope;
-    /** the current beam maximal slope */
-    float m_drawingBeamMaxSlope;
-
     /**
      * Record notation type for document.
      * (This should be improved by storing a vector of all notation types of the document for cases mixing notations)
@@ -483,34 +731,18 @@ private:
      */
     Options *m_options;
 
-    /*
-     * The following values are set in the Doc::SetDrawingPage.
-     * They are all current values to be used when drawing a page in a View and
-     * reset for every page. However, most of them are based on the m_staffDefin values
-     * and will remain the same. This can be optimized.
-     * The pages dimensions and margins are based on the page ones, the document ones or
-     * the default in the following order and if available.
+    /**
+     * The values of the page being drawn (see DrawingPageValues)
      */
+    DrawingPageValues m_drawingValues;
 
-    /** The page currently being drawn */
-    Page *m_drawingPage;
-    /** Height of a beam (10 and 6 by default) */
-    int m_drawingBeamWidth;
-    /** Height of a beam spacing (white) (10 and 6 by default) */
-    int m_drawingBeamWhiteWidth;
-    /** Ledger line length and normal and grace size */
-    int m_drawingLedgerLine;
-    /** Brevis width */
-    int m_drawingBrevisWidth;
-
-    /** Smufl font size (100 par defaut) */
-    int m_drawingSmuflFontSize;
-    /** Lyric font size  */
-    int m_drawingLyricFontSize;
-    /** Current music font */
-    FontInfo m_drawingSmuflFont;
-    /** Current lyric font */
-    FontInfo m_drawingLyricFont;
+    /**
+     * The doc and the drawing values for the calling thread (see Doc::SetThreadDrawingValues)
+     */
+    ///@{
+    static thread_local const Doc *s_threadDrawingDoc;
+    static thread_local DrawingPageValues *s_threadDrawingValues;
+    ///@}
 
     /**
      * A flag to indicate whether the currentScoreDef has been set or not.
@@ -532,6 +764,11 @@ private:
      */
     double m_MIDITimemapTempo;
 
+    /**
+     * The data from which the MIDI timemap can be restored (see SetMidiTimemapData), NULL if none
+     */
+    const MidiTimemapData *m_midiTimemapData;
+
     /**
      * A flag to indicate whereas the document contains analytical markup to be converted.
      * This is currently limited to @fermata and @tie. Other attribute markup (@accid and @artic)
@@ -545,6 +782,29 @@ private:
      */
     bool m_isMensuralMusicOnly;
 
+    /** The uuid index and the uuid revision when it was last invalidated */
+    MapOfStrObjects m_uuidIndex;
+    unsigned long m_uuidIndexRevision;
+    /** A flag indicating that the uuid index has been built for the current revision */
+    bool m_uuidIndexBuilt;
+
+    /** The time index of the measures (one entry per repeat) and of the notes of each measure */
+    std::vector<TimeIndexEntry> m_measureTimeIndex;
+    std::vector<std::vector<TimeIndexEntry>> m_noteTimeIndex;
+    /** The uuid revision when the time index was built */
+    unsigned long m_timeIndexRevision;
+
+    /** The text extends calculated so far */
+    TextExtentCache m_textExtentCache;
+
+    /** A flag indicating that the cast-off has to be redone (see InvalidateCastOff) */
+    bool m_isCastOffInvalid;
+
+    /** A flag indicating that the last page has still to be cast off (see CastOffPendingDoc) */
+    bool m_isCastOffPending;
+    /** The smart breaks flag of the progressive cast-off to be used for the pending page */
+    bool m_castOffPendingSmart;
+
     /** Page width (MEI scoredef@page.width) - currently not saved */
     int m_pageWidth;
     /** Page height (MEI scoredef@page.height) - currently not saved */
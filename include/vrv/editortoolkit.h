@@ -9,18 +9,54 @@
 #define __VRV_EDITOR_TOOLKIT_H__
 
 #include <cmath>
+#include <map>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 //--------------------------------------------------------------------------------
 
 #include "doc.h"
 #include "view.h"
+#include "zone.h"
 
 #include "jsonxx.h"
 
 namespace vrv {
 
+//--------------------------------------------------------------------------------
+// EditorUndoStep
+//--------------------------------------------------------------------------------
+
+/**
+ * This class holds the reverse operations of an undo step.
+ * A step is either a single action (including a chain) or all the actions of a transaction.
+ */
+class EditorUndoStep {
+public:
+    EditorUndoStep() {}
+    ~EditorUndoStep();
+    EditorUndoStep(const EditorUndoStep &) = delete;
+    EditorUndoStep &operator=(const EditorUndoStep &) = delete;
+
+    bool IsEmpty() const { return m_operations.empty(); }
+
+public:
+    /**
+     * The reverse operations in the order they were recorded, as pairs of uuid and object.
+     * The object is a detached copy (with the same uuids) of the object before the step, or NULL for an object
+     * created during the step and to be removed.
+     */
+    std::vector<std::pair<std::string, Object *>> m_operations;
+    /** The uuids of the objects saved or created in the step */
+    std::set<std::string> m_uuids;
+    /** The coordinates of the zones of the objects saved */
+    std::map<std::string, AttCoordinated> m_zones;
+    /** The number of zones of the surface before the step, or -1 */
+    int m_surfaceZoneCount = -1;
+};
+
 //--------------------------------------------------------------------------------
 // EditorToolkit
 //--------------------------------------------------------------------------------
@@ -32,8 +68,12 @@ public:
         m_doc = doc;
         m_view = view;
         m_editInfo.reset();
+        m_currentStep = NULL;
+        m_inTransaction = false;
+        m_drawingDeferred = false;
+        m_redoLayout = false;
     }
-    virtual ~EditorToolkit() {}
+    virtual ~EditorToolkit();
 
     /**
      * In child classes, this parses the provided editor action and then performs the correct action.
@@ -44,10 +84,70 @@ public:
      */
     virtual std::string EditInfo() { return m_editInfo.json(); }
 
+    /**
+     * To be called after each editor action.
+     * Closes the undo step of an action performed outside a transaction.
+     * Returns true when the layout of the document has to be redone by the toolkit.
+     */
+    bool EndAction();
+
+protected:
+    /**
+     * Transaction functions.
+     * All the actions between BeginTransaction and CommitTransaction make one undo step, and updating the
+     * drawing is deferred to the commit.
+     */
+    ///@{
+    bool BeginTransaction();
+    bool CommitTransaction();
+    bool IsInTransaction() const { return m_inTransaction; }
+    ///@}
+
+    /**
+     * Undo the last step, or roll back the current transaction.
+     */
+    bool Undo();
+
+    /**
+     * Record the reverse operations of the current step.
+     * SaveForUndo keeps a copy of an object before it gets modified. It does nothing if the object, or one of its
+     * ancestors, was already saved or created in the step. SaveCreatedForUndo records an object added in the step.
+     * Within a transaction, both also mark the drawing to be updated at the commit.
+     */
+    ///@{
+    bool SaveForUndo(Object *object);
+    void SaveCreatedForUndo(Object *object);
+    ///@}
+
+    /**
+     * Update the drawing after a modification, or defer it to the commit of the current transaction.
+     */
+    void UpdateDrawing();
+
+    /**
+     * Prepare the drawing again after the document was modified.
+     * By default, laying out the document again is left to the toolkit.
+     */
+    virtual void RedoDrawing();
+
+private:
+    EditorUndoStep *GetCurrentStep();
+    void CloseCurrentStep();
+
 protected:
     Doc *m_doc;
     View *m_view;
     jsonxx::Object m_editInfo;
+
+private:
+    /** The steps that can be undone, in the order they were recorded */
+    std::vector<EditorUndoStep *> m_undoSteps;
+    /** The step being recorded */
+    EditorUndoStep *m_currentStep;
+    /** Flags for the transaction and the deferred drawing update */
+    bool m_inTransaction;
+    bool m_drawingDeferred;
+    bool m_redoLayout;
 };
 } // namespace vrv
 
@@ -87,6 +87,16 @@ protected:
     bool AdjustClefLineFromPosition(Clef *clef, Staff *staff = NULL);
     ///@}
 
+    /**
+     * Prepare the drawing and lay out the drawing page again, unless the layout comes from the facsimile.
+     */
+    virtual void RedoDrawing();
+
+    /**
+     * Save the staff of an element for undo, or the measure when the modification can affect other staves.
+     */
+    void SaveElementForUndo(const std::string &elementId, bool withMeasure);
+
 private:
     jsonxx::Object m_infoObject;
 };
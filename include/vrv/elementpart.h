@@ -33,6 +33,7 @@ public:
     ///@{
     Dots();
     virtual ~Dots();
+    virtual Object *Clone() const { return new Dots(*this); }
     virtual void Reset();
     virtual std::string GetClassName() const { return "Dots"; }
     virtual ClassId GetClassId() const { return DOTS; }
@@ -106,6 +107,7 @@ public:
     ///@{
     Flag();
     virtual ~Flag();
+    virtual Object *Clone() const { return new Flag(*this); }
     virtual void Reset();
     virtual std::string GetClassName() const { return "Flag"; }
     virtual ClassId GetClassId() const { return FLAG; }
@@ -162,6 +164,7 @@ public:
     ///@{
     TupletBracket();
     virtual ~TupletBracket();
+    virtual Object *Clone() const { return new TupletBracket(*this); }
     virtual void Reset();
     virtual std::string GetClassName() const { return "TupletBracket"; }
     virtual ClassId GetClassId() const { return TUPLET_BRACKET; }
@@ -256,6 +259,7 @@ public:
     ///@{
     TupletNum();
     virtual ~TupletNum();
+    virtual Object *Clone() const { return new TupletNum(*this); }
     virtual void Reset();
     virtual std::string GetClassName() const { return "TupletNum"; }
     virtual ClassId GetClassId() const { return TUPLET_NUM; }
@@ -328,6 +332,7 @@ public:
     ///@{
     Stem();
     virtual ~Stem();
+    virtual Object *Clone() const { return new Stem(*this); }
     virtual void Reset();
     virtual std::string GetClassName() const { return "Stem"; }
     virtual ClassId GetClassId() const { return STEM; }
@@ -152,6 +152,14 @@ public:
     virtual ~FloatingPositioner(){};
     virtual ClassId GetClassId() const { return FLOATING_POSITIONER; }
 
+    /**
+     * @name Allocate and release the positioners (including curve positioners) with the LayoutPool
+     */
+    ///@{
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+    ///@}
+
     virtual void ResetPositioner();
 
     /**
@@ -322,6 +330,20 @@ public:
     bool IsCrossStaff() const { return m_crossStaff != NULL; }
     ///@}
 
+    /**
+     * @name Setter and getters for the parameters the curve was last drawn with in a BBoxDeviceContext.
+     * They are used for updating the bounding box of the curve without redrawing the page.
+     */
+    ///@{
+    void SetDrawingParams(int x1, int x2, Staff *staff, char spanningType, Object *graphic);
+    int GetDrawingX1() const { return m_drawingX1; }
+    int GetDrawingX2() const { return m_drawingX2; }
+    Staff *GetDrawingStaff() const { return m_drawingStaff; }
+    char GetDrawingSpanningType() const { return m_drawingSpanningType; }
+    Object *GetDrawingGraphic() const { return m_drawingGraphic; }
+    bool HasDrawingParams() const { return m_drawingStaff != NULL; }
+    ///@}
+
 private:
     //
 public:
@@ -339,6 +361,17 @@ private:
     Staff* m_crossStaff;
     ///@}
 
+    /**
+     * @name The parameters the curve was last drawn with
+     */
+    ///@{
+    int m_drawingX1;
+    int m_drawingX2;
+    Staff *m_drawingStaff;
+    char m_drawingSpanningType;
+    Object *m_drawingGraphic;
+    ///@}
+
     ArrayOfCurveSpannedElements m_spannedElements;
 
     /** The cached min or max value (depending on the curvature) */
@@ -37,6 +37,11 @@ public:
     virtual ClassId GetClassId() const { return FTREM; }
     ///@}
 
+    /**
+     * Overriding CloneReset() method to be called after copy / assignment calls.
+     */
+    virtual void CloneReset();
+
     /**
      * Add an element (a note or a chord) to a fTrem.
      * Only Note or Chord elements will be actually added to the fTrem.
@@ -314,6 +314,7 @@ public:
  * member 1: a flag indicating we are processing floating object to be put in between
  * member 2: the doc
  * member 3: a pointer to the functor for passing it to the system aligner
+ * member 4: a buffer for the overflowing boxes overlapping with the current positioner
  **/
 
 class AdjustFloatingPositionersParams : public FunctorParams {
@@ -329,6 +330,7 @@ public:
     bool m_inBetween;
     Doc *m_doc;
     Functor *m_functor;
+    ArrayOfBoundingBoxes m_overlappingBBoxes;
 };
 
 //----------------------------------------------------------------------------
@@ -1382,6 +1384,20 @@ public:
     Object *m_element;
 };
 
+//----------------------------------------------------------------------------
+// FillUuidIndexParams
+//----------------------------------------------------------------------------
+
+/**
+ * member 0: the uuid index to fill
+ **/
+
+class FillUuidIndexParams : public FunctorParams {
+public:
+    FillUuidIndexParams(MapOfStrObjects *uuidIndex) { m_uuidIndex = uuidIndex; }
+    MapOfStrObjects *m_uuidIndex;
+};
+
 //----------------------------------------------------------------------------
 // FindChildByComparisonParams
 //----------------------------------------------------------------------------
@@ -2111,7 +2127,8 @@ public:
  * member 3: the previous measure (for setting cautionary scoreDef)
  * member 4: the current system (for setting the system scoreDef)
  * member 5: the flag indicating whereas full labels have to be drawn
- * member 6: the doc
+ * member 6: the flag indicating whereas the system continues the previous one (pending page)
+ * member 7: the doc
  **/
 
 class ScoreDefSetCurrentParams : public FunctorParams {
@@ -2124,6 +2141,7 @@ public:
         m_previousMeasure = NULL;
         m_currentSystem = NULL;
         m_drawLabels = false;
+        m_continueSystem = false;
         m_doc = doc;
     }
     ScoreDef *m_currentScoreDef;
@@ -2132,6 +2150,7 @@ public:
     Measure *m_previousMeasure;
     System *m_currentSystem;
     bool m_drawLabels;
+    bool m_continueSystem;
     Doc *m_doc;
 };
 
@@ -36,12 +36,13 @@ public:
     ///@{
     Glyph();
     Glyph(std::string path, std::string codeStr);
+    Glyph(std::string path, std::string codeStr, int unitsPerEm);
     Glyph(int unitsPerEm);
     virtual ~Glyph();
     ///@}
 
     /** Get the bounds of the glyph */
-    void GetBoundingBox(int &x, int &y, int &w, int &h);
+    void GetBoundingBox(int &x, int &y, int &w, int &h) const;
 
     /**
      * Set the bounds of the glyph
@@ -54,16 +55,16 @@ public:
     int GetUnitsPerEm() const { return m_unitsPerEm; }
 
     /** Get the path */
-    std::string GetPath() { return m_path; }
+    std::string GetPath() const { return m_path; }
 
     /** Get the code string */
-    std::string GetCodeStr() { return m_codeStr; }
+    std::string GetCodeStr() const { return m_codeStr; }
 
     /**
      * @name Setter and getter for the horizAdvX
      */
     ///@{
-    int GetHorizAdvX() { return m_horizAdvX; }
+    int GetHorizAdvX() const { return m_horizAdvX; }
     void SetHorizAdvX(double horizAdvX) { m_horizAdvX = (int)(horizAdvX * 10.0); }
     ///@}
 
@@ -76,12 +77,12 @@ public:
     /**
      * Check if the glyph has anchor provided.
      */
-    bool HasAnchor(SMuFLGlyphAnchor anchor);
+    bool HasAnchor(SMuFLGlyphAnchor anchor) const;
 
     /**
      * Return the SMuFL anchor for the glyph.
      */
-    const Point *GetAnchor(SMuFLGlyphAnchor anchor);
+    const Point *GetAnchor(SMuFLGlyphAnchor anchor) const;
 
 private:
     //
@@ -79,6 +79,14 @@ public:
     virtual ClassId GetClassId() const { return ALIGNMENT; }
     ///@}
 
+    /**
+     * @name Allocate and release the alignments with the LayoutPool
+     */
+    ///@{
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+    ///@}
+
     /**
      * Delete the grace aligners in the map
      */
@@ -303,6 +311,14 @@ public:
     virtual ClassId GetClassId() const { return ALIGNMENT_REFERENCE; }
     ///@}
 
+    /**
+     * @name Allocate and release the references with the LayoutPool
+     */
+    ///@{
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+    ///@}
+
     /**
      * Override the method of adding AlignmentReference children
      */
@@ -533,7 +549,11 @@ public:
     virtual int JustifyX(FunctorParams *functorParams);
 
 private:
-    //
+    /**
+     * Return the index of the right barline alignment (-1 if not found)
+     */
+    int GetRightBarLineAlignmentIdx() const;
+
 public:
     //
 private:
@@ -582,6 +602,14 @@ public:
     virtual void Reset();
     ///@}
 
+    /**
+     * @name Allocate and release the grace aligners with the LayoutPool
+     */
+    ///@{
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+    ///@}
+
     /**
      * Retrieve the alignmnet of the type at that time.
      * The alignment object is added if not found.
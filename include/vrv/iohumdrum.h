@@ -400,6 +400,7 @@ public:
 
     std::string GetHumdrumString();
     std::string GetMeiString();
+    void ReleaseHumdrumData();
 
 protected:
     void clear();
@@ -457,9 +457,26 @@ public:
 
     virtual bool Import(const std::string &mei);
 
+    /**
+     * Import the MEI data from a seekable stream without building the XML tree of the complete document.
+     * The measures are replaced by placeholders in a skeleton of the document. The content of each measure
+     * is read from the stream and parsed only when the measure is read.
+     */
+    bool ImportStream(std::istream &mei);
+
 private:
     bool ReadDoc(pugi::xml_node root);
 
+    /**
+     * @name Methods for the streamed import.
+     * ReadStreamSkeleton copies the document without the measures and keeps their position in the stream.
+     * LoadStreamedMeasure parses the content of a measure placeholder and returns the measure node.
+     */
+    ///@{
+    bool ReadStreamSkeleton(std::istream &mei, std::string &skeleton);
+    pugi::xml_node LoadStreamedMeasure(pugi::xml_node measure, pugi::xml_document &fragment);
+    ///@}
+
     ///@{
     bool ReadMdiv(Object *parent, pugi::xml_node parentNode, bool isVisible);
     bool ReadMdivChildren(Object *parent, pugi::xml_node parentNode, bool isVisible);
@@ -774,6 +791,14 @@ private:
      */
     std::string m_comment;
 
+    /**
+     * @name The stream being imported by ImportStream (NULL otherwise) and the offset and size of its measures
+     */
+    ///@{
+    std::istream *m_stream;
+    std::vector<std::pair<std::streamoff, std::streamsize>> m_streamedMeasures;
+    ///@}
+
     //----------------//
     // Static members //
     //----------------//
@@ -296,6 +296,24 @@ private:
     std::string GetContentOfChild(const pugi::xml_node node, const std::string &child) const;
     ///@}
 
+    /*
+     * @name Helper methods for evaluating an XPath expression on a node.
+     * The compiled queries are cached in m_xpathQueries and reused for all subsequent calls.
+     */
+    ///@{
+    pugi::xpath_node SelectNode(const pugi::xml_node node, const char *xpath) const;
+    pugi::xpath_node_set SelectNodes(const pugi::xml_node node, const char *xpath) const;
+    const pugi::xpath_query &GetXPathQuery(const char *xpath) const;
+    ///@}
+
+    /*
+     * @name Helper method for retrieving the first measure with @n=measureN added to the section.
+     * Returns NULL if not found.
+     */
+    ///@{
+    Measure *FindMeasureByN(const std::string &measureN) const;
+    ///@}
+
     /*
      * @name Methods for opening and closing ties and slurs.
      * Opened ties and slurs are stacked together with musicxml::OpenTie
@@ -465,6 +483,11 @@ private:
     std::queue<musicxml::ClefChange> m_clefChangeQueue;
     /* stack of new arpeggios that get more notes added. */
     std::vector<std::pair<Arpeg *, musicxml::OpenArpeggio>> m_ArpeggioStack;
+    /* The measures added to the section and the first of them for each @n, to avoid searching the section */
+    std::vector<Measure *> m_sectionMeasures;
+    std::map<std::string, Measure *> m_measuresByN;
+    /* The compiled XPath queries, by expression */
+    mutable std::map<std::string, pugi::xpath_query, std::less<>> m_xpathQueries;
     /* a map for the measure counts storing the index of each measure created */
     std::map<Measure *, int> m_measureCounts;
     /* measure rests */
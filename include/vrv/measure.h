@@ -66,6 +66,16 @@ public:
      */
     bool IsMeasuredMusic() const { return m_measuredMusic; }
 
+    /**
+     * Overriding Modify() method for marking the measure as modified for the incremental layout.
+     * The flag is reset once the layout has been redone (see Doc::LayOutModifiedMeasures).
+     */
+    ///@{
+    virtual void Modify(bool modified = true);
+    bool IsLayoutModified() const { return m_isLayoutModified; }
+    void ResetLayoutModified() { m_isLayoutModified = false; }
+    ///@}
+
     /**
      * Methods for adding allowed content
      */
@@ -245,6 +255,23 @@ public:
      */
     double GetRealTimeOffsetMilliseconds(int repeat) const;
 
+    /**
+     * Return the number of real time offsets (i.e., of repeats) and the real time duration in millisecond.
+     */
+    ///@{
+    int GetRealTimeOffsetCount() const { return (int)m_realTimeOffsetMilliseconds.size(); }
+    int GetRealTimeDurationMilliseconds() const;
+    ///@}
+
+    /**
+     * Store and restore the values calculated for the MIDI timemap (see Doc::GetMidiTimemapData).
+     * Restoring returns false if the values do not match.
+     */
+    ///@{
+    void StoreTimemapValues(std::vector<double> &values) const;
+    bool RestoreTimemapValues(const std::vector<double> &values, int &position);
+    ///@}
+
     //----------//
     // Functors //
     //----------//
@@ -513,6 +540,11 @@ private:
      */
     bool m_hasAlignmentRefWithMultipleLayers;
 
+    /**
+     * A flag indicating that the content of the measure was modified since the last layout
+     */
+    bool m_isLayoutModified;
+
     /**
      * Start time state variables.
      */
@@ -75,6 +75,11 @@ public:
     virtual ClassId GetClassId() const { return NOTE; }
     ///@}
 
+    /**
+     * Overriding CloneReset() method to be called after copy / assignment calls.
+     */
+    virtual void CloneReset();
+
     /**
      * @name Getter to interfaces
      */
@@ -220,6 +225,15 @@ public:
     char GetMIDIPitch() const;
     ///@}
 
+    /**
+     * Store and restore the values calculated for the MIDI timemap (see Doc::GetMidiTimemapData).
+     * Restoring returns false if the values do not match.
+     */
+    ///@{
+    void StoreTimemapValues(std::vector<double> &values) const;
+    bool RestoreTimemapValues(const std::vector<double> &values, int &position);
+    ///@}
+
 public:
     //----------//
     // Functors //
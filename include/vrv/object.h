@@ -8,6 +8,8 @@
 #ifndef __VRV_OBJECT_H__
 #define __VRV_OBJECT_H__
 
+#include <atomic>
+#include <bitset>
 #include <cstdlib>
 #include <ctime>
 #include <functional>
@@ -44,6 +46,63 @@ class Zone;
 #define FORWARD true
 #define BACKWARD false
 
+//----------------------------------------------------------------------------
+// AttClassRegistry
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the MEI att classes and the interfaces implemented by a class of Object.
+ * Registries are immutable and shared by all the objects registering the same att classes and interfaces
+ * in the same order, which in practice means all the objects of a class.
+ * Each registry keeps the registries obtained by adding one more att class or interface to it. They are
+ * created the first time they are reached and never deleted, so a constructor only walks from the empty
+ * registry to the one of its class without allocating anything.
+ */
+class AttClassRegistry {
+public:
+    /**
+     * Return the registry with no att class and no interface
+     */
+    static const AttClassRegistry *GetEmpty();
+
+    /**
+     * @name Return the registry with the att class or the interface (and its att classes) added.
+     */
+    ///@{
+    const AttClassRegistry *AddAttClass(AttClassId attClassId) const;
+    const AttClassRegistry *AddInterface(const std::vector<AttClassId> *attClasses, InterfaceId interfaceId) const;
+    ///@}
+
+    /**
+     * @name Constant-time membership checks
+     */
+    ///@{
+    bool HasAttClass(AttClassId attClassId) const { return m_attClasses.test(attClassId); }
+    bool HasInterface(InterfaceId interfaceId) const { return m_interfaces.test(interfaceId); }
+    ///@}
+
+private:
+    AttClassRegistry(const AttClassRegistry *parent, int key);
+
+    /**
+     * Look for the registry extending this one with key and create it if it does not exist.
+     * Att classes are keyed by their AttClassId and interfaces by ATT_CLASS_max + InterfaceId
+     */
+    const AttClassRegistry *GetNext(int key, const std::vector<AttClassId> *attClasses) const;
+
+public:
+    //
+private:
+    std::bitset<ATT_CLASS_max> m_attClasses;
+    std::bitset<INTERFACE_TIME_SPANNING + 1> m_interfaces;
+    /** The key of the att class or interface added last */
+    int m_key;
+    /** The first registry extending this one - lock-free to read, written under a mutex */
+    mutable std::atomic<AttClassRegistry *> m_next;
+    /** The next registry extending the same parent */
+    std::atomic<AttClassRegistry *> m_sibling;
+};
+
 //----------------------------------------------------------------------------
 // Object
 //----------------------------------------------------------------------------
@@ -121,16 +180,13 @@ public:
      * @name Methods for registering a MEI att class and for registering interfaces regrouping MEI att classes.
      */
     ///@{
-    void RegisterAttClass(AttClassId attClassId) { m_attClasses.push_back(attClassId); }
-    bool HasAttClass(AttClassId attClassId) const
-    {
-        return std::find(m_attClasses.begin(), m_attClasses.end(), attClassId) != m_attClasses.end();
-    }
-    void RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId);
-    bool HasInterface(InterfaceId interfaceId) const
+    void RegisterAttClass(AttClassId attClassId) { m_attClassRegistry = m_attClassRegistry->AddAttClass(attClassId); }
+    bool HasAttClass(AttClassId attClassId) const { return m_attClassRegistry->HasAttClass(attClassId); }
+    void RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId)
     {
-        return std::find(m_interfaces.begin(), m_interfaces.end(), interfaceId) != m_interfaces.end();
+        m_attClassRegistry = m_attClassRegistry->AddInterface(attClasses, interfaceId);
     }
+    bool HasInterface(InterfaceId interfaceId) const { return m_attClassRegistry->HasInterface(interfaceId); }
     ///@}
 
     virtual DurationInterface *GetDurationInterface() { return NULL; }
@@ -383,6 +439,7 @@ public:
     /**
      * Look for a descendant with the specified uuid (returns NULL if not found)
      * This method is a wrapper for the Object::FindByUuid functor.
+     * When looking through the entire subtree of an object in a Doc, the uuid index of the Doc is used first.
      */
     Object *FindDescendantByUuid(std::string uuid, int deepness = UNLIMITED_DEPTH, bool direction = FORWARD);
 
@@ -481,7 +538,7 @@ public:
     /**
      * Mark the object and its parent (if any) as modified
      */
-    void Modify(bool modified = true);
+    virtual void Modify(bool modified = true);
 
     /**
      * @name Setter and getter of the attribute flag
@@ -551,6 +608,12 @@ public:
 
     static std::string GenerateRandUuid();
 
+    /**
+     * Return the revision number of the uuids.
+     * It is incremented every time an object is deleted or a uuid changed.
+     */
+    static unsigned long GetUuidRevision() { return s_uuidRevision; }
+
     static bool sortByUlx(Object *a, Object *b);
 
     //----------//
@@ -572,6 +635,11 @@ public:
      */
     virtual int FindByUuid(FunctorParams *functorParams);
 
+    /**
+     * Add each Object to a uuid index (the first Object is kept for duplicated uuids).
+     */
+    virtual int FillUuidIndex(FunctorParams *functorParams);
+
     /**
      * Find a Object with a Comparison functor .     */
     virtual int FindByComparison(FunctorParams *functorParams);
@@ -1313,14 +1381,10 @@ private:
     ///@}
 
     /**
-     * A vector for storing the list of AttClassId (MEI att classes) implemented.
-     */
-    std::vector<AttClassId> m_attClasses;
-
-    /**
-     * A vector for storing the list of InterfaceId (group of MEI att classes) implemented.
+     * The shared registry of the AttClassId (MEI att classes) and InterfaceId (group of MEI att classes)
+     * implemented.
      */
-    std::vector<InterfaceId> m_interfaces;
+    const AttClassRegistry *m_attClassRegistry;
 
     /**
      * String for storing a comments attached to the object when printing an MEI element.
@@ -1350,6 +1414,11 @@ private:
      * A static counter for uuid generation.
      */
     static thread_local unsigned long s_objectCounter;
+
+    /**
+     * A static revision number for invalidating uuid indexes (see Object::GetUuidRevision)
+     */
+    static thread_local unsigned long s_uuidRevision;
 };
 
 //----------------------------------------------------------------------------
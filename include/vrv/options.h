@@ -560,9 +560,12 @@ public:
     // These options are only given for documentation - except for m_scale
     // They are ordered by short option alphabetical order
     OptionBool m_standardOutput;
+    OptionBool m_server;
+    OptionString m_serverSocket;
     OptionBool m_help;
     OptionBool m_allPpages;
     OptionString m_inputFrom;
+    OptionInt m_threads;
     OptionString m_outfile;
     OptionInt m_page;
     OptionString m_resourcePath;
@@ -579,6 +582,7 @@ public:
     OptionBool m_adjustPageHeight;
     OptionBool m_adjustPageWidth;
     OptionIntMap m_breaks;
+    OptionBool m_breaksProgressive;
     OptionDbl m_breaksSmartSb;
     OptionIntMap m_condense;
     OptionBool m_condenseFirstPage;
@@ -609,6 +613,7 @@ public:
     OptionBool m_preserveAnalyticalMarkup;
     OptionBool m_removeIds;
     OptionBool m_shrinkToFit;
+    OptionBool m_streamMei;
     OptionBool m_svgBoundingBoxes;
     OptionBool m_svgViewBox;
     OptionBool m_svgHtml5;
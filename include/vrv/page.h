@@ -88,6 +88,18 @@ public:
      */
     void LayOut(bool force = false);
 
+    /**
+     * Mark the layout of the page as to be done again the next time it is drawn.
+     * The layout sizes of the previous layout are kept.
+     */
+    void ResetLayoutDone() { m_layoutDone = false; }
+
+    /**
+     * Return the widths and overflows of the measures and the heights and overflows of the systems as stored
+     * by LayOut before the justification. These are the values determining the cast-off of the page.
+     */
+    const std::vector<int> &GetLayoutSizes() const { return m_layoutSizes; }
+
     /**
      * Do the layout for a transcription page (with layout information).
      * This only calculates positioning or layer element parts using provided layout of parents.
@@ -221,6 +233,11 @@ private:
      * the force parameter is set.
      */
     bool m_layoutDone;
+
+    /**
+     * The measure and system sizes before justification (see GetLayoutSizes).
+     */
+    std::vector<int> m_layoutSizes;
 };
 
 } // namespace vrv
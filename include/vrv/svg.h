@@ -25,7 +25,9 @@ public:
      */
     ///@{
     Svg();
+    Svg(const Svg &svg);
     virtual ~Svg();
+    virtual Object *Clone() const { return new Svg(*this); }
     virtual void Reset();
     virtual std::string GetClassName() const { return "Svg"; }
     virtual ClassId GetClassId() const { return SVG; }
@@ -10,7 +10,8 @@
 
 #include <fstream>
 #include <iostream>
-#include <list>
+#include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
@@ -24,6 +25,60 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// SvgNode
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a node of the SVG tree written by the SvgDeviceContext.
+ * Only elements that are still open or that can be resumed are kept as nodes. Other elements are serialized as soon
+ * as they are closed into the buffer of the device context and their parent node only keeps the position of the text.
+ */
+class SvgNode {
+public:
+    /**
+     * A child is either a node or a serialized text in the buffer (when m_node is NULL)
+     */
+    struct Child {
+        const char *m_text = NULL;
+        size_t m_length = 0;
+        SvgNode *m_node = NULL;
+    };
+
+    /**
+     * Where a child has to be inserted.
+     * Elements drawn with SvgDeviceContext::AppendChild go before the first <g> child.
+     */
+    enum Position { APPEND = 0, PREPEND, BEFORE_FIRST_G };
+
+    /**
+     * Reset the node for reusing it.
+     */
+    void Reset(const char *name, SvgNode *parent);
+
+    /**
+     * Return true if one of the children is still a node
+     */
+    bool HasChildNodes() const;
+
+    /**
+     * Return a pointer to the (escaped) value of an attribute and set its length, or NULL if not found
+     */
+    const char *GetAttribute(const char *name, size_t &length) const;
+
+public:
+    const char *m_name;
+    SvgNode *m_parent;
+    int m_depth;
+    // the serialized attributes, each of them preceded by a space
+    std::string m_attributes;
+    std::vector<Child> m_children;
+    // the index of the child starting with the first <g> element
+    size_t m_firstG;
+    // the node can be resumed and needs to be kept until the end of the page
+    bool m_isResumable;
+};
+
 //----------------------------------------------------------------------------
 // SvgDeviceContext
 //----------------------------------------------------------------------------
@@ -32,6 +87,8 @@ namespace vrv {
  * This class implements a drawing context for generating SVG files.
  * The music font is embedded by incorporating ./data/[fontname]/[glyph].xml glyphs within
  * the SVG file.
+ * The SVG is written while drawing and closed elements are serialized immediately. Formatting options (indent, raw
+ * format, html5) have to be set before drawing.
  */
 class SvgDeviceContext : public DeviceContext {
 public:
@@ -242,7 +299,60 @@ private:
 
     std::string GetColour(int colour);
 
-    pugi::xml_node AppendChild(std::string name);
+    /**
+     * @name Methods for opening and closing nodes.
+     * Closing a node serializes it into its parent unless it can be resumed or has children that can be resumed.
+     */
+    ///@{
+    SvgNode *OpenNode(const char *name, SvgNode::Position position, bool isG = false);
+    void CloseNode();
+    ///@}
+
+    /**
+     * Insert a child node or a serialized child.
+     * A serialized child is merged with the previous one when they follow each other in the buffer.
+     */
+    void InsertChild(SvgNode *parent, const SvgNode::Child &child, SvgNode::Position position, bool isG);
+
+    /**
+     * Replace a node by its serialization in the children of its parent.
+     * The node cannot have child nodes anymore.
+     */
+    void ReplaceChild(SvgNode *node);
+
+    /**
+     * Replace all the child nodes by their serialization
+     */
+    void SerializeChildNodes(SvgNode *node);
+
+    /**
+     * Copy the text to the buffer and return it as a child
+     */
+    SvgNode::Child StoreText(const std::string &text);
+
+    /**
+     * @name Methods for writing an element without children (or with text only) directly into its parent.
+     * AppendChild starts the element before the first <g> child of the current node.
+     */
+    ///@{
+    std::string &AppendChild(const char *name);
+    std::string &StartLeaf(const char *name, SvgNode *parent, SvgNode::Position position);
+    void EndLeaf();
+    void EndLeaf(const std::string &text);
+    ///@}
+
+    /**
+     * @name Methods for serializing attributes and nodes as pugixml does.
+     */
+    ///@{
+    void WriteAttribute(std::string &output, const char *name, const std::string &value);
+    void WriteAttribute(std::string &output, const char *name, const char *value);
+    void WriteAttribute(std::string &output, const char *name, int value);
+    void WriteAttribute(std::string &output, const char *name, float value);
+    void WriteEscaped(std::string &output, const char *text, bool attribute);
+    void WriteIndent(std::string &output, int depth);
+    void WritePugiNode(std::string &output, pugi::xml_node node, int depth);
+    ///@}
 
 public:
     //
@@ -254,11 +364,10 @@ private:
      */
     bool m_vrvTextFont;
 
-    // we use a std::stringstream because we want to prepend the <defs> which will know only when we reach the end of
-    // the page
+    // the <defs> are known only when we reach the end of the page but have to be written first
     // some viewer seem to support to have the <defs> at the end, but some do not (pdf2svg, for example)
-    // for this reason, the full svg is finally written a string from the destructor or when Flush() is called
-    std::ostringstream m_outdata;
+    // for this reason, the full svg is finally written to the string when Commit() is called
+    std::string m_outdata;
 
     bool m_committed; // did we flushed the file?
     int m_originX, m_originY;
@@ -267,12 +376,25 @@ private:
     // they will be added at the end of the file as <defs>
     std::set<std::string> m_smuflGlyphs;
 
-    // pugixml data
-    pugi::xml_document m_svgDoc;
-    pugi::xml_node m_svgNode;
-    pugi::xml_node m_pageNode;
-    pugi::xml_node m_currentNode;
-    std::list<pugi::xml_node> m_svgNodeStack;
+    // the nodes of the SVG tree
+    SvgNode *m_svgNode;
+    SvgNode *m_pageNode;
+    SvgNode *m_currentNode;
+    std::vector<SvgNode *> m_svgNodeStack;
+    // the nodes that can be resumed, by id
+    std::map<std::string, SvgNode *> m_resumableNodes;
+    // all the nodes allocated and the ones that can be reused
+    std::vector<std::unique_ptr<SvgNode>> m_nodes;
+    std::vector<SvgNode *> m_freeNodes;
+    // the buffer with the serialized text, allocated by blocks that are never moved
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    size_t m_blockSize;
+    size_t m_blockUsed;
+    // the element currently written by StartLeaf
+    std::string m_leaf;
+    const char *m_leafName;
+    SvgNode *m_leafParent;
+    SvgNode::Position m_leafPosition;
 
     // output as mm (for pdf generation with a 72 dpi)
     bool m_mmOutput;
@@ -19,11 +19,46 @@ namespace vrv {
 class BoundaryEnd;
 class DeviceContext;
 class Ending;
+class FindSpannedLayerElementsParams;
 class Measure;
 class ScoreDef;
 class Slur;
 class Staff;
 
+//----------------------------------------------------------------------------
+// SpannedElementList
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the layer elements and ties of a system (or of one of its staves) in processing order.
+ * The running maximum of the right position of the layer elements is kept for skipping the ones that
+ * cannot be spanned from a given position with a binary search.
+ */
+class SpannedElementList {
+public:
+    /**
+     * @name Add an object (layer element or tie) and clear the list
+     */
+    ///@{
+    void Add(Object *object);
+    void Clear();
+    ///@}
+
+    /**
+     * Call Object::FindSpannedLayerElements on the objects as a functor processing would do, but starting
+     * from the first one that can be spanned from params->m_minPos.
+     */
+    void FindSpannedLayerElements(FindSpannedLayerElementsParams *params) const;
+
+private:
+    /** The layer elements and ties in processing order */
+    std::vector<Object *> m_objects;
+    /** The running maximum of the right position of the layer elements */
+    std::vector<int> m_maxRights;
+    /** The indexes of the ties in m_objects */
+    std::vector<int> m_tieIndexes;
+};
+
 //----------------------------------------------------------------------------
 // System
 //----------------------------------------------------------------------------
@@ -119,6 +154,17 @@ public:
      */
     curvature_CURVEDIR GetPreferredCurveDirection(LayerElement *start, LayerElement *end, Slur *slur);
 
+    /**
+     * @name Reset and query the index of the layer elements and ties used for finding the elements spanned by slurs.
+     * The index is reset in View::DrawSystem and filled on the first query, once the content has been drawn.
+     * The query gives the same result as processing Object::FindSpannedLayerElements on the system, limited to
+     * the staff staffN if given. Only the class ids listed in System::s_spannedElementClassIds are indexed.
+     */
+    ///@{
+    void ResetSpannedElementIndex();
+    void FindSpannedLayerElements(FindSpannedLayerElementsParams *params, int staffN = VRV_UNSET);
+    ///@}
+
     /**
      * @name Setter and getter of the drawing visible flag
      */
@@ -330,6 +376,19 @@ private:
      * This does not mean that a staff is hidden, but only that it can be optimized.
      */
     bool m_drawingIsOptimized;
+
+    /**
+     * @name The index of the layer elements and ties for all the staves and for each staff @n.
+     * Filled by System::FindSpannedLayerElements when not valid.
+     */
+    ///@{
+    bool m_spannedElementIndexIsValid;
+    SpannedElementList m_spannedElements;
+    std::map<int, SpannedElementList> m_spannedElementsByStaff;
+    ///@}
+
+    /** The class ids indexed for finding spanned elements */
+    static const std::vector<ClassId> s_spannedElementClassIds;
 };
 
 } // namespace vrv
@@ -20,6 +20,7 @@
 namespace vrv {
 
 class EditorToolkit;
+class Input;
 
 enum FileFormat {
     UNKNOWN = 0,
@@ -259,6 +260,9 @@ public:
     /**
      * Edit the MEI data
      *
+     * Actions between a "begin" and a "commit" action make one transaction for which the drawing is updated (and
+     * the layout redone) only once at the commit. An "undo" action reverts the last transaction or action.
+     *
      * @param editorAction The editor actions as a stringified JSON object
      * @return True if the edit action was successfully applied
      **/
@@ -300,6 +304,19 @@ public:
      */
     bool RenderToSVGFile(const std::string &filename, int pageNo = 1);
 
+    /**
+     * Render all the pages to SVG.
+     *
+     * Pages are laid out and rendered in parallel with the given number of threads.
+     * Pages sharing elements (e.g., a slur across a page break) are rendered by the same thread.
+     * This methods is not available in the JavaScript version of the toolkit.
+     *
+     * @param threads The number of threads to use
+     * @param xmlDeclaration True for including the xml declaration in the SVG output
+     * @return The SVG pages as strings in page order
+     */
+    std::vector<std::string> RenderAllPagesToSVG(int threads = 1, bool xmlDeclaration = false);
+
     /**
      * Render the document to MIDI
      *
@@ -317,6 +334,14 @@ public:
      */
     bool RenderToMIDIFile(const std::string &filename);
 
+    /**
+     * Render the document to MIDI without encoding it
+     *
+     * @param @output The buffer to which the MIDI file is written
+     * @return True if the MIDI file was successfully rendered
+     */
+    bool RenderToMIDIBinary(std::vector<unsigned char> &output);
+
     /**
      * Render a document to Plaine and Easie
      *
@@ -354,6 +379,27 @@ public:
      */
     bool RenderToTimemapFile(const std::string &filename);
 
+    /**
+     * Render a document to a binary timemap
+     *
+     * The timemap has the same content as the JSON one without the string building and parsing.
+     * See Doc::ExportTimemapBinary for a description of the format.
+     *
+     * @param @output The buffer to which the timemap is written
+     * @return True if the timemap was successfully rendered
+     */
+    bool RenderToTimemapBinary(std::vector<unsigned char> &output);
+
+    /**
+     * Render a document to a binary timemap and save it to the file
+     *
+     * This methods is not available in the JavaScript version of the toolkit.
+     *
+     * @param @filename The output filename
+     * @return True if the file was successfully written
+     */
+    bool RenderToTimemapBinaryFile(const std::string &filename);
+
     //@}
 
     /**
@@ -441,6 +487,16 @@ public:
      */
     std::string GetElementsAtTime(int millisec);
 
+    /**
+     * Returns arrays of IDs of elements being played for a list of times
+     *
+     * This is the batch version of GetElementsAtTime and avoids one call per time.
+     *
+     * @param jsonTimes A stringified JSON array of times in milliseconds
+     * @return A stringified JSON array with one object with the page and notes being played for each time
+     */
+    std::string GetElementsAtTimes(const std::string &jsonTimes);
+
     /**
      * Return the page on which the element is the ID (xml:id) is rendered
      *
@@ -519,7 +575,8 @@ public:
      * Redo the layout of the loaded data
      *
      * This can be called once the rendering option were changed, for example with a new page (sceen) height or a new
-     * zoom level.
+     * zoom level. If the options did not change since the last layout, only the pages with measures modified by the
+     * editor are laid out again, unless the cast-off has to be redone.
      */
     void RedoLayout();
 
@@ -580,6 +637,25 @@ public:
      */
     const char *GetCString();
 
+    /**
+     * Move the data to the binary internal buffer
+     *
+     * @ingroup nodoc
+     */
+    void SetCBuffer(std::vector<unsigned char> &data);
+
+    /**
+     * Return the content of the binary internal buffer and its size
+     *
+     * Return NULL (and a size of 0) if the buffer is empty
+     *
+     * @ingroup nodoc
+     */
+    ///@{
+    const unsigned char *GetCBuffer();
+    int GetCBufferSize() const { return (int)m_cBuffer.size(); }
+    ///@}
+
     /**
      * Write the Humdrum buffer to the outputstream
      *
@@ -649,6 +725,37 @@ private:
     bool LoadZipFile(const std::string &filename);
     bool LoadZipData(const std::vector<unsigned char> &bytes);
     void GetClassIds(const std::vector<std::string> &classStrings, std::vector<ClassId> &classIds);
+    jsonxx::Object GetElementsAtTimeObject(int millisec);
+    std::string GetLayoutOptions() const;
+    std::string GetMidiTimemapKey(const std::string &data) const;
+
+    /**
+     * Import Humdrum data converted from another input format (MusicXML, MEI, MuseData or EsAC).
+     * The data is imported directly into m_doc and the HumdrumInput used is returned with meiData left empty.
+     * Selecting an mdiv, an app, a choice or a subst with an XPath query needs the MEIInput. In that case, the
+     * data is imported into a temporary document written to meiData and a MEIInput still to be run is returned.
+     * Return NULL if the Humdrum data cannot be imported.
+     */
+    Input *ImportConvertedHumdrum(const std::string &humdrum, std::string &meiData);
+
+    /**
+     * Import MEI data from a seekable stream without loading it entirely in memory (see option --stream-mei).
+     */
+    bool LoadMEIStream(std::istream &stream);
+
+    /**
+     * Prepare the document once the data has been imported with the given input, and lay it out if necessary.
+     * The input is deleted.
+     */
+    bool PrepareImportedDoc(Input *input);
+
+    /**
+     * @name Render a page (1-based) with the given view
+     */
+    ///@{
+    bool RenderToDeviceContext(View *view, int pageNo, DeviceContext *deviceContext);
+    std::string RenderToSVG(View *view, int pageNo, bool xmlDeclaration);
+    ///@}
 
 public:
     //
@@ -660,11 +767,28 @@ private:
 
     Options *m_options;
 
+    /**
+     * The options of the last layout, empty if the incremental layout cannot be used.
+     */
+    std::string m_layoutOptions;
+
+    /**
+     * The MIDI timemap data kept when loading the same data again and the key of the data currently loaded.
+     * The key is empty if the document does not match the data anymore (e.g., after editing).
+     */
+    MidiTimemapData m_midiTimemapData;
+    std::string m_midiTimemapKey;
+
     /**
      * The C buffer string.
      */
     char *m_cString;
 
+    /**
+     * The C binary buffer.
+     */
+    std::vector<unsigned char> m_cBuffer;
+
     EditorToolkit *m_editorToolkit;
 
     //----------------//
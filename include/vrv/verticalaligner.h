@@ -13,6 +13,7 @@
 namespace vrv {
 
 class AdjustFloatingPositionerGrpsParams;
+class AdjustFloatingPositionersParams;
 class AttSpacing;
 class FloatingObject;
 class ScoreDef;
@@ -21,6 +22,9 @@ class StaffDef;
 class System;
 class SystemAligner;
 
+// in drawing units - the width of the buckets of the HorizontalBBoxIndex used for the overflowing boxes
+#define OVERFLOW_BBOX_BUCKET_WIDTH 16
+
 //----------------------------------------------------------------------------
 // SystemAligner
 //----------------------------------------------------------------------------
@@ -132,6 +136,55 @@ private:
     System *m_system;
 };
 
+//----------------------------------------------------------------------------
+// HorizontalBBoxIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class indexes bounding boxes by the horizontal extent of their content.
+ * The extent is divided in buckets of a fixed width and each box is added to all the buckets it covers.
+ * The position of the boxes is cached when they are added and must not change as long as the index is used.
+ */
+class HorizontalBBoxIndex {
+public:
+    HorizontalBBoxIndex(int bucketWidth);
+
+    /**
+     * Add a box to the index. Boxes without content bounding box are ignored since they cannot overlap.
+     */
+    void Add(BoundingBox *box);
+
+    /**
+     * Remove all the boxes from the index
+     */
+    void Clear();
+
+    /**
+     * Fill the array with the boxes overlapping horizontally with the content of the box.
+     * The boxes are in the order in which they were added, which is the same as with a linear
+     * BoundingBox::HorizontalContentOverlap test over all of them.
+     */
+    void FindHorizontalContentOverlaps(const BoundingBox *box, ArrayOfBoundingBoxes &overlaps);
+
+private:
+    int GetBucket(int x) const;
+
+public:
+    //
+private:
+    struct Entry {
+        BoundingBox *m_box;
+        int m_left;
+        int m_right;
+    };
+    std::vector<Entry> m_entries;
+    // the entries (by index) in each bucket
+    std::map<int, std::vector<int>> m_buckets;
+    int m_bucketWidth;
+    // a buffer for the candidates of a search
+    std::vector<int> m_candidates;
+};
+
 //----------------------------------------------------------------------------
 // StaffAlignment
 //----------------------------------------------------------------------------
@@ -151,6 +204,14 @@ public:
     virtual ClassId GetClassId() const { return STAFF_ALIGNMENT; }
     ///@}
 
+    /**
+     * @name Allocate and release the staff alignments with the LayoutPool
+     */
+    ///@{
+    static void *operator new(size_t size);
+    static void operator delete(void *block, size_t size);
+    ///@}
+
     /**
      * @name Setter and getter for y
      */
@@ -183,6 +244,11 @@ public:
      */
     FloatingPositioner *GetCorrespFloatingPositioner(FloatingObject *object);
 
+    /**
+     * Return a const reference to the FloatingPositioner objects of the alignment
+     */
+    const ArrayOfFloatingPositioners &GetFloatingPositioners() const { return m_floatingPositioners; }
+
     /**
      * @name Setter and getter of the staff from which the alignment is created alignment.
      * Used for accessing the staff @n, the size, etc.
@@ -269,6 +335,14 @@ public:
     void ReAdjustFloatingPositionersGrps(AdjustFloatingPositionerGrpsParams *params,
         const ArrayOfFloatingPositioners &positioners, ArrayOfIntPairs &grpIdYRel);
 
+    /**
+     * Adjust the positioners of the class (or all the ones placed between staves) given in the params.
+     * Called for each class in turn from StaffAlignment::AdjustFloatingPositioners.
+     * The indexes hold the overflowing boxes above and below and are kept up-to-date.
+     */
+    void AdjustFloatingPositionersForClass(AdjustFloatingPositionersParams *params,
+        HorizontalBBoxIndex &overflowAboveIndex, HorizontalBBoxIndex &overflowBelowIndex);
+
     //----------//
     // Functors //
     //----------//
@@ -132,6 +132,13 @@ public:
      */
     void SetDoc(Doc *doc);
 
+    /**
+     * Copy the tie and slur thickness coefficients of another view.
+     * The coefficients are set when drawing the first tie or slur, which makes the output dependent on the
+     * drawing order. Views drawing pages in parallel copy the ones of the main view.
+     */
+    void CopyThicknessCoeficients(const View &view);
+
     /**
      * @name Methods for converting coordinates from the logical world to the device
      * context world.
@@ -165,6 +172,14 @@ public:
      */
     void DrawCurrentPage(DeviceContext *dc, bool background = true);
 
+    /**
+     * Redraw only the slurs of the current page with the parameters kept when the page was drawn.
+     * This updates the bounding boxes of the slurs after they have been adjusted without redrawing
+     * the entire page. It can be called only with a BBoxDeviceContext after DrawCurrentPage.
+     * Defined in view_slur.cpp
+     */
+    void DrawCurrentPageSlurs(DeviceContext *dc);
+
     /**
      * Return the pixel per unit factor of the current page (if any, 1.0 otherwise)
      */
@@ -10,6 +10,7 @@
 
 #include <cstring>
 #include <map>
+#include <memory>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string>
@@ -23,6 +24,10 @@
 
 #include "atttypes.h"
 
+namespace pugi {
+class xml_document;
+}
+
 namespace vrv {
 
 class Glyph;
@@ -124,6 +129,8 @@ bool Check(Object *object);
 /**
  * This class provides static resource values.
  * The default values can be changed by setters.
+ * The fonts are loaded once and shared (read-only) by all threads. Each thread only keeps the music font and the
+ * text style it has selected.
  */
 
 class Resources {
@@ -132,6 +139,29 @@ public:
     using GlyphMap = std::map<wchar_t, Glyph>;
     using GlyphTextMap = std::map<StyleAttributes, GlyphMap>;
 
+    /**
+     * A SMuFL font as used for the rendering, i.e., the glyphs of the font completed by the ones of Bravura.
+     * The glyphs of the SMuFL private use area are looked up in a flat table indexed by their code.
+     */
+    class MusicFont {
+    public:
+        /** Returns the glyph (if exists) for a glyph code */
+        const Glyph *GetGlyph(wchar_t smuflCode) const;
+        /** Add the glyphs of a font, replacing the ones with the same code */
+        void AddGlyphs(const std::shared_ptr<const GlyphMap> &glyphs);
+        /** The number of glyphs in the font */
+        int GetGlyphCount() const { return m_glyphCount; }
+
+    private:
+        /** The glyphs of the private use area (U+E000 to U+F8FF) */
+        std::vector<const Glyph *> m_table;
+        /** The glyphs outside the private use area, if any */
+        std::map<wchar_t, const Glyph *> m_otherGlyphs;
+        /** The glyphs of the fonts the font is made of */
+        std::vector<std::shared_ptr<const GlyphMap>> m_glyphs;
+        int m_glyphCount = 0;
+    };
+
     //----------------//
     // Static methods //
     //----------------//
@@ -141,28 +171,44 @@ public:
      */
     ///@{
     /** Resource path */
-    static std::string GetPath() { return s_path; }
-    static void SetPath(const std::string &path) { s_path = path; }
+    static std::string GetPath();
+    static void SetPath(const std::string &path);
     /** Init the SMufL music and text fonts */
     static bool InitFonts();
-    /** Init the text font (bounding boxes and ASCII only) */
-    static bool InitTextFont(const std::string &fontName, const StyleAttributes &style);
     /** Select a particular font */
     static bool SetFont(const std::string &fontName);
     /** Returns the glyph (if exists) for a glyph code in the current SMuFL font */
-    static Glyph *GetGlyph(wchar_t smuflCode);
+    static const Glyph *GetGlyph(wchar_t smuflCode);
     /** Returns the glyph (if exists) for a glyph name in the current SMuFL font */
-    static Glyph *GetGlyph(const std::string &smuflName);
+    static const Glyph *GetGlyph(const std::string &smuflName);
     /** Returns the glyph (if exists) for a glyph name in the current SMuFL font */
     static wchar_t GetGlyphCode(const std::string &smuflName);
     /** Set current text style*/
     static void SelectTextFont(data_FONTWEIGHT fontWeight, data_FONTSTYLE fontStyle);
+    /** Return the current text style */
+    static StyleAttributes GetCurrentTextStyle() { return s_currentStyle; }
     /** Returns the glyph (if exists) for the text font (bounding box and ASCII only) */
-    static Glyph *GetTextGlyph(wchar_t code);
+    static const Glyph *GetTextGlyph(wchar_t code);
     ///@}
 
+    /**
+     * Return the parsed content of an XML resource file (e.g., a glyph or the woff font).
+     * Files are loaded only once and then shared (read-only) across threads.
+     * Returns NULL if the file cannot be loaded.
+     */
+    static std::shared_ptr<const pugi::xml_document> GetXmlResource(const std::string &filename);
+
 private:
-    static bool LoadFont(const std::string &fontName);
+    /**
+     * @name Methods for loading the fonts into the store.
+     * They have to be called with the store locked.
+     */
+    ///@{
+    static std::shared_ptr<const GlyphMap> LoadFont(const std::string &path, const std::string &fontName);
+    static const MusicFont *GetMusicFont(const std::string &path, const std::string &fontName);
+    /** Load the text font (bounding boxes and ASCII only) */
+    static bool LoadTextFont(const std::string &path, const std::string &fontName, GlyphMap &glyphs);
+    ///@}
 
 private:
     //----------------//
@@ -170,11 +216,16 @@ private:
     //----------------//
 
     /** The path to the resources directory (e.g., for the svg/ subdirectory with fonts as XML */
-    static thread_local std::string s_path;
-    /** The loaded SMuFL font */
-    static thread_local GlyphMap s_font;
-    /** A text font used for bounding box calculations */
-    static thread_local GlyphTextMap s_textFont;
+    static std::string s_path;
+    /** The SMuFL fonts loaded so far by path and name, shared by all threads */
+    static std::map<std::string, std::unique_ptr<const MusicFont>> s_musicFonts;
+    /** The glyphs of each font directory loaded so far by path and name */
+    static std::map<std::string, std::shared_ptr<const GlyphMap>> s_fontGlyphs;
+    /** The text fonts (for bounding box calculations) by path, shared by all threads */
+    static std::map<std::string, std::unique_ptr<const GlyphTextMap>> s_textFonts;
+    /** The SMuFL font and the text fonts used by the thread */
+    static thread_local const MusicFont *s_currentFont;
+    static thread_local const GlyphTextMap *s_currentTextFonts;
     static thread_local StyleAttributes s_currentStyle;
     static const StyleAttributes k_defaultStyle;
     /**
@@ -182,6 +233,33 @@ private:
      * The map in generated by ./fonts/generate_all.sh into ./src/smufl.cpp
      */
     static const std::map<std::string, wchar_t> s_smuflNames;
+    /** The XML resources (glyphs and woff font) loaded so far, shared by all threads */
+    static std::map<std::string, std::shared_ptr<const pugi::xml_document>> s_xmlResources;
+};
+
+//----------------------------------------------------------------------------
+// LayoutPool
+//----------------------------------------------------------------------------
+
+/**
+ * This class provides the memory for the objects created and deleted in large numbers every time the layout is
+ * redone (e.g., Alignment, AlignmentReference, StaffAlignment or FloatingPositioner).
+ * Blocks are carved out of chunks by size class and go back to a free list when the object is deleted, so
+ * successive layouts reuse the same memory instead of going through the allocator for every object.
+ * The pool is shared by all threads because positioners are also created when pages are rendered in parallel.
+ * The chunks are kept until the end of the process.
+ */
+class LayoutPool {
+public:
+    /**
+     * Return a block of the given size. Sizes beyond the largest size class are allocated with operator new.
+     */
+    static void *Allocate(size_t size);
+
+    /**
+     * Give back a block obtained with Allocate with the same size.
+     */
+    static void Release(void *block, size_t size);
 };
 
 //----------------------------------------------------------------------------
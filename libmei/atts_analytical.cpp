@@ -47,9 +47,11 @@ void AttHarmAnl::ResetHarmAnl()
 bool AttHarmAnl::ReadHarmAnl(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToHarmAnlForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToHarmAnlForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -93,9 +95,11 @@ void AttHarmonicFunction::ResetHarmonicFunction()
 bool AttHarmonicFunction::ReadHarmonicFunction(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("deg")) {
-        this->SetDeg(StrToStr(element.attribute("deg").value()));
-        element.remove_attribute("deg");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("deg"))) {
+        this->SetDeg(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -139,9 +143,11 @@ void AttIntervalHarmonic::ResetIntervalHarmonic()
 bool AttIntervalHarmonic::ReadIntervalHarmonic(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("inth")) {
-        this->SetInth(StrToStr(element.attribute("inth").value()));
-        element.remove_attribute("inth");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("inth"))) {
+        this->SetInth(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -185,9 +191,11 @@ void AttIntervalMelodic::ResetIntervalMelodic()
 bool AttIntervalMelodic::ReadIntervalMelodic(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("intm")) {
-        this->SetIntm(StrToStr(element.attribute("intm").value()));
-        element.remove_attribute("intm");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("intm"))) {
+        this->SetIntm(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -231,9 +239,11 @@ void AttKeySigAnl::ResetKeySigAnl()
 bool AttKeySigAnl::ReadKeySigAnl(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("mode")) {
-        this->SetMode(StrToMode(element.attribute("mode").value()));
-        element.remove_attribute("mode");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("mode"))) {
+        this->SetMode(StrToMode(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -279,19 +289,21 @@ void AttKeySigDefaultAnl::ResetKeySigDefaultAnl()
 bool AttKeySigDefaultAnl::ReadKeySigDefaultAnl(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("key.accid")) {
-        this->SetKeyAccid(StrToAccidentalGestural(element.attribute("key.accid").value()));
-        element.remove_attribute("key.accid");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("key.accid"))) {
+        this->SetKeyAccid(StrToAccidentalGestural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("key.mode")) {
-        this->SetKeyMode(StrToMode(element.attribute("key.mode").value()));
-        element.remove_attribute("key.mode");
+    if ((attr = element.attribute("key.mode"))) {
+        this->SetKeyMode(StrToMode(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("key.pname")) {
-        this->SetKeyPname(StrToPitchname(element.attribute("key.pname").value()));
-        element.remove_attribute("key.pname");
+    if ((attr = element.attribute("key.pname"))) {
+        this->SetKeyPname(StrToPitchname(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -353,9 +365,11 @@ void AttMelodicFunction::ResetMelodicFunction()
 bool AttMelodicFunction::ReadMelodicFunction(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("mfunc")) {
-        this->SetMfunc(StrToMelodicfunction(element.attribute("mfunc").value()));
-        element.remove_attribute("mfunc");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("mfunc"))) {
+        this->SetMfunc(StrToMelodicfunction(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -399,9 +413,11 @@ void AttPitchClass::ResetPitchClass()
 bool AttPitchClass::ReadPitchClass(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("pclass")) {
-        this->SetPclass(StrToInt(element.attribute("pclass").value()));
-        element.remove_attribute("pclass");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("pclass"))) {
+        this->SetPclass(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -445,9 +461,11 @@ void AttSolfa::ResetSolfa()
 bool AttSolfa::ReadSolfa(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("psolfa")) {
-        this->SetPsolfa(StrToStr(element.attribute("psolfa").value()));
-        element.remove_attribute("psolfa");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("psolfa"))) {
+        this->SetPsolfa(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttArpegLog::ResetArpegLog()
 bool AttArpegLog::ReadArpegLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("order")) {
-        this->SetOrder(StrToArpegLogOrder(element.attribute("order").value()));
-        element.remove_attribute("order");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("order"))) {
+        this->SetOrder(StrToArpegLogOrder(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -93,9 +95,11 @@ void AttBTremLog::ResetBTremLog()
 bool AttBTremLog::ReadBTremLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToBTremLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToBTremLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -139,9 +143,11 @@ void AttBeamPresent::ResetBeamPresent()
 bool AttBeamPresent::ReadBeamPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("beam")) {
-        this->SetBeam(StrToStr(element.attribute("beam").value()));
-        element.remove_attribute("beam");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("beam"))) {
+        this->SetBeam(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -188,24 +194,26 @@ void AttBeamRend::ResetBeamRend()
 bool AttBeamRend::ReadBeamRend(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToBeamRendForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToBeamRendForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("place")) {
-        this->SetPlace(StrToBeamplace(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToBeamplace(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("slash")) {
-        this->SetSlash(StrToBoolean(element.attribute("slash").value()));
-        element.remove_attribute("slash");
+    if ((attr = element.attribute("slash"))) {
+        this->SetSlash(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("slope")) {
-        this->SetSlope(StrToDbl(element.attribute("slope").value()));
-        element.remove_attribute("slope");
+    if ((attr = element.attribute("slope"))) {
+        this->SetSlope(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -276,9 +284,11 @@ void AttBeamSecondary::ResetBeamSecondary()
 bool AttBeamSecondary::ReadBeamSecondary(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("breaksec")) {
-        this->SetBreaksec(StrToInt(element.attribute("breaksec").value()));
-        element.remove_attribute("breaksec");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("breaksec"))) {
+        this->SetBreaksec(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -322,9 +332,11 @@ void AttBeamedWith::ResetBeamedWith()
 bool AttBeamedWith::ReadBeamedWith(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("beam.with")) {
-        this->SetBeamWith(StrToOtherstaff(element.attribute("beam.with").value()));
-        element.remove_attribute("beam.with");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("beam.with"))) {
+        this->SetBeamWith(StrToOtherstaff(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -369,14 +381,16 @@ void AttBeamingLog::ResetBeamingLog()
 bool AttBeamingLog::ReadBeamingLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("beam.group")) {
-        this->SetBeamGroup(StrToStr(element.attribute("beam.group").value()));
-        element.remove_attribute("beam.group");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("beam.group"))) {
+        this->SetBeamGroup(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("beam.rests")) {
-        this->SetBeamRests(StrToBoolean(element.attribute("beam.rests").value()));
-        element.remove_attribute("beam.rests");
+    if ((attr = element.attribute("beam.rests"))) {
+        this->SetBeamRests(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -429,9 +443,11 @@ void AttBeatRptLog::ResetBeatRptLog()
 bool AttBeatRptLog::ReadBeatRptLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("beatdef")) {
-        this->SetBeatdef(StrToDbl(element.attribute("beatdef").value()));
-        element.remove_attribute("beatdef");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("beatdef"))) {
+        this->SetBeatdef(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -475,9 +491,11 @@ void AttBracketSpanLog::ResetBracketSpanLog()
 bool AttBracketSpanLog::ReadBracketSpanLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToStr(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -521,9 +539,11 @@ void AttCutout::ResetCutout()
 bool AttCutout::ReadCutout(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("cutout")) {
-        this->SetCutout(StrToCutoutCutout(element.attribute("cutout").value()));
-        element.remove_attribute("cutout");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("cutout"))) {
+        this->SetCutout(StrToCutoutCutout(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -567,9 +587,11 @@ void AttExpandable::ResetExpandable()
 bool AttExpandable::ReadExpandable(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("expand")) {
-        this->SetExpand(StrToBoolean(element.attribute("expand").value()));
-        element.remove_attribute("expand");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("expand"))) {
+        this->SetExpand(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -613,9 +635,11 @@ void AttFTremLog::ResetFTremLog()
 bool AttFTremLog::ReadFTremLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToFTremLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToFTremLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -659,9 +683,11 @@ void AttGlissPresent::ResetGlissPresent()
 bool AttGlissPresent::ReadGlissPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("gliss")) {
-        this->SetGliss(StrToGlissando(element.attribute("gliss").value()));
-        element.remove_attribute("gliss");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("gliss"))) {
+        this->SetGliss(StrToGlissando(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -705,9 +731,11 @@ void AttGraceGrpLog::ResetGraceGrpLog()
 bool AttGraceGrpLog::ReadGraceGrpLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("attach")) {
-        this->SetAttach(StrToGraceGrpLogAttach(element.attribute("attach").value()));
-        element.remove_attribute("attach");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("attach"))) {
+        this->SetAttach(StrToGraceGrpLogAttach(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -752,14 +780,16 @@ void AttGraced::ResetGraced()
 bool AttGraced::ReadGraced(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("grace")) {
-        this->SetGrace(StrToGrace(element.attribute("grace").value()));
-        element.remove_attribute("grace");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("grace"))) {
+        this->SetGrace(StrToGrace(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("grace.time")) {
-        this->SetGraceTime(StrToPercent(element.attribute("grace.time").value()));
-        element.remove_attribute("grace.time");
+    if ((attr = element.attribute("grace.time"))) {
+        this->SetGraceTime(StrToPercent(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -813,14 +843,16 @@ void AttHairpinLog::ResetHairpinLog()
 bool AttHairpinLog::ReadHairpinLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToHairpinLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToHairpinLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("niente")) {
-        this->SetNiente(StrToBoolean(element.attribute("niente").value()));
-        element.remove_attribute("niente");
+    if ((attr = element.attribute("niente"))) {
+        this->SetNiente(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -879,39 +911,41 @@ void AttHarpPedalLog::ResetHarpPedalLog()
 bool AttHarpPedalLog::ReadHarpPedalLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("c")) {
-        this->SetC(StrToHarpPedalLogC(element.attribute("c").value()));
-        element.remove_attribute("c");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("c"))) {
+        this->SetC(StrToHarpPedalLogC(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("d")) {
-        this->SetD(StrToHarpPedalLogD(element.attribute("d").value()));
-        element.remove_attribute("d");
+    if ((attr = element.attribute("d"))) {
+        this->SetD(StrToHarpPedalLogD(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("e")) {
-        this->SetE(StrToHarpPedalLogE(element.attribute("e").value()));
-        element.remove_attribute("e");
+    if ((attr = element.attribute("e"))) {
+        this->SetE(StrToHarpPedalLogE(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("f")) {
-        this->SetF(StrToHarpPedalLogF(element.attribute("f").value()));
-        element.remove_attribute("f");
+    if ((attr = element.attribute("f"))) {
+        this->SetF(StrToHarpPedalLogF(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("g")) {
-        this->SetG(StrToHarpPedalLogG(element.attribute("g").value()));
-        element.remove_attribute("g");
+    if ((attr = element.attribute("g"))) {
+        this->SetG(StrToHarpPedalLogG(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("a")) {
-        this->SetA(StrToHarpPedalLogA(element.attribute("a").value()));
-        element.remove_attribute("a");
+    if ((attr = element.attribute("a"))) {
+        this->SetA(StrToHarpPedalLogA(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("b")) {
-        this->SetB(StrToHarpPedalLogB(element.attribute("b").value()));
-        element.remove_attribute("b");
+    if ((attr = element.attribute("b"))) {
+        this->SetB(StrToHarpPedalLogB(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1009,9 +1043,11 @@ void AttLvPresent::ResetLvPresent()
 bool AttLvPresent::ReadLvPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lv")) {
-        this->SetLv(StrToBoolean(element.attribute("lv").value()));
-        element.remove_attribute("lv");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lv"))) {
+        this->SetLv(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1056,14 +1092,16 @@ void AttMeasureLog::ResetMeasureLog()
 bool AttMeasureLog::ReadMeasureLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("left")) {
-        this->SetLeft(StrToBarrendition(element.attribute("left").value()));
-        element.remove_attribute("left");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("left"))) {
+        this->SetLeft(StrToBarrendition(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("right")) {
-        this->SetRight(StrToBarrendition(element.attribute("right").value()));
-        element.remove_attribute("right");
+    if ((attr = element.attribute("right"))) {
+        this->SetRight(StrToBarrendition(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1116,9 +1154,11 @@ void AttMeterSigGrpLog::ResetMeterSigGrpLog()
 bool AttMeterSigGrpLog::ReadMeterSigGrpLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToMeterSigGrpLogFunc(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToMeterSigGrpLogFunc(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1163,14 +1203,16 @@ void AttNumberPlacement::ResetNumberPlacement()
 bool AttNumberPlacement::ReadNumberPlacement(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("num.place")) {
-        this->SetNumPlace(StrToStaffrelBasic(element.attribute("num.place").value()));
-        element.remove_attribute("num.place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("num.place"))) {
+        this->SetNumPlace(StrToStaffrelBasic(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("num.visible")) {
-        this->SetNumVisible(StrToBoolean(element.attribute("num.visible").value()));
-        element.remove_attribute("num.visible");
+    if ((attr = element.attribute("num.visible"))) {
+        this->SetNumVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1223,9 +1265,11 @@ void AttNumbered::ResetNumbered()
 bool AttNumbered::ReadNumbered(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("num")) {
-        this->SetNum(StrToInt(element.attribute("num").value()));
-        element.remove_attribute("num");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("num"))) {
+        this->SetNum(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1269,9 +1313,11 @@ void AttOctaveLog::ResetOctaveLog()
 bool AttOctaveLog::ReadOctaveLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("coll")) {
-        this->SetColl(StrToOctaveLogColl(element.attribute("coll").value()));
-        element.remove_attribute("coll");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("coll"))) {
+        this->SetColl(StrToOctaveLogColl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1316,14 +1362,16 @@ void AttPedalLog::ResetPedalLog()
 bool AttPedalLog::ReadPedalLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dir")) {
-        this->SetDir(StrToPedalLogDir(element.attribute("dir").value()));
-        element.remove_attribute("dir");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dir"))) {
+        this->SetDir(StrToPedalLogDir(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("func")) {
-        this->SetFunc(StrToStr(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1376,9 +1424,11 @@ void AttPianoPedals::ResetPianoPedals()
 bool AttPianoPedals::ReadPianoPedals(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("pedal.style")) {
-        this->SetPedalStyle(StrToPianoPedalsPedalstyle(element.attribute("pedal.style").value()));
-        element.remove_attribute("pedal.style");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("pedal.style"))) {
+        this->SetPedalStyle(StrToPianoPedalsPedalstyle(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1422,9 +1472,11 @@ void AttRehearsal::ResetRehearsal()
 bool AttRehearsal::ReadRehearsal(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("reh.enclose")) {
-        this->SetRehEnclose(StrToRehearsalRehenclose(element.attribute("reh.enclose").value()));
-        element.remove_attribute("reh.enclose");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("reh.enclose"))) {
+        this->SetRehEnclose(StrToRehearsalRehenclose(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1468,9 +1520,11 @@ void AttScoreDefVisCmn::ResetScoreDefVisCmn()
 bool AttScoreDefVisCmn::ReadScoreDefVisCmn(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("grid.show")) {
-        this->SetGridShow(StrToBoolean(element.attribute("grid.show").value()));
-        element.remove_attribute("grid.show");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("grid.show"))) {
+        this->SetGridShow(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1515,14 +1569,16 @@ void AttSlurRend::ResetSlurRend()
 bool AttSlurRend::ReadSlurRend(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("slur.lform")) {
-        this->SetSlurLform(StrToLineform(element.attribute("slur.lform").value()));
-        element.remove_attribute("slur.lform");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("slur.lform"))) {
+        this->SetSlurLform(StrToLineform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("slur.lwidth")) {
-        this->SetSlurLwidth(StrToLinewidth(element.attribute("slur.lwidth").value()));
-        element.remove_attribute("slur.lwidth");
+    if ((attr = element.attribute("slur.lwidth"))) {
+        this->SetSlurLwidth(StrToLinewidth(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1575,9 +1631,11 @@ void AttStemsCmn::ResetStemsCmn()
 bool AttStemsCmn::ReadStemsCmn(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("stem.with")) {
-        this->SetStemWith(StrToOtherstaff(element.attribute("stem.with").value()));
-        element.remove_attribute("stem.with");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("stem.with"))) {
+        this->SetStemWith(StrToOtherstaff(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1622,14 +1680,16 @@ void AttTieRend::ResetTieRend()
 bool AttTieRend::ReadTieRend(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tie.lform")) {
-        this->SetTieLform(StrToLineform(element.attribute("tie.lform").value()));
-        element.remove_attribute("tie.lform");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tie.lform"))) {
+        this->SetTieLform(StrToLineform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tie.lwidth")) {
-        this->SetTieLwidth(StrToLinewidth(element.attribute("tie.lwidth").value()));
-        element.remove_attribute("tie.lwidth");
+    if ((attr = element.attribute("tie.lwidth"))) {
+        this->SetTieLwidth(StrToLinewidth(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1682,9 +1742,11 @@ void AttTremMeasured::ResetTremMeasured()
 bool AttTremMeasured::ReadTremMeasured(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("unitdur")) {
-        this->SetUnitdur(StrToDuration(element.attribute("unitdur").value()));
-        element.remove_attribute("unitdur");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("unitdur"))) {
+        this->SetUnitdur(StrToDuration(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
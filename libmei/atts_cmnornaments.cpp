@@ -48,14 +48,16 @@ void AttMordentLog::ResetMordentLog()
 bool AttMordentLog::ReadMordentLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToMordentLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToMordentLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("long")) {
-        this->SetLong(StrToBoolean(element.attribute("long").value()));
-        element.remove_attribute("long");
+    if ((attr = element.attribute("long"))) {
+        this->SetLong(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -108,9 +110,11 @@ void AttOrnamPresent::ResetOrnamPresent()
 bool AttOrnamPresent::ReadOrnamPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ornam")) {
-        this->SetOrnam(StrToStr(element.attribute("ornam").value()));
-        element.remove_attribute("ornam");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ornam"))) {
+        this->SetOrnam(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -155,14 +159,16 @@ void AttOrnamentAccid::ResetOrnamentAccid()
 bool AttOrnamentAccid::ReadOrnamentAccid(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("accidupper")) {
-        this->SetAccidupper(StrToAccidentalWritten(element.attribute("accidupper").value()));
-        element.remove_attribute("accidupper");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("accidupper"))) {
+        this->SetAccidupper(StrToAccidentalWritten(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("accidlower")) {
-        this->SetAccidlower(StrToAccidentalWritten(element.attribute("accidlower").value()));
-        element.remove_attribute("accidlower");
+    if ((attr = element.attribute("accidlower"))) {
+        this->SetAccidlower(StrToAccidentalWritten(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -216,14 +222,16 @@ void AttTurnLog::ResetTurnLog()
 bool AttTurnLog::ReadTurnLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("delayed")) {
-        this->SetDelayed(StrToBoolean(element.attribute("delayed").value()));
-        element.remove_attribute("delayed");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("delayed"))) {
+        this->SetDelayed(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("form")) {
-        this->SetForm(StrToTurnLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToTurnLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
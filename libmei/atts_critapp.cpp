@@ -47,9 +47,11 @@ void AttCrit::ResetCrit()
 bool AttCrit::ReadCrit(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("cause")) {
-        this->SetCause(StrToStr(element.attribute("cause").value()));
-        element.remove_attribute("cause");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("cause"))) {
+        this->SetCause(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttAgentIdent::ResetAgentIdent()
 bool AttAgentIdent::ReadAgentIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("agent")) {
-        this->SetAgent(StrToStr(element.attribute("agent").value()));
-        element.remove_attribute("agent");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("agent"))) {
+        this->SetAgent(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -93,9 +95,11 @@ void AttReasonIdent::ResetReasonIdent()
 bool AttReasonIdent::ReadReasonIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("reason")) {
-        this->SetReason(StrToStr(element.attribute("reason").value()));
-        element.remove_attribute("reason");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("reason"))) {
+        this->SetReason(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
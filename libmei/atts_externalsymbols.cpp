@@ -50,24 +50,26 @@ void AttExtSym::ResetExtSym()
 bool AttExtSym::ReadExtSym(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("glyph.auth")) {
-        this->SetGlyphAuth(StrToStr(element.attribute("glyph.auth").value()));
-        element.remove_attribute("glyph.auth");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("glyph.auth"))) {
+        this->SetGlyphAuth(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("glyph.name")) {
-        this->SetGlyphName(StrToStr(element.attribute("glyph.name").value()));
-        element.remove_attribute("glyph.name");
+    if ((attr = element.attribute("glyph.name"))) {
+        this->SetGlyphName(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("glyph.num")) {
-        this->SetGlyphNum(StrToHexnum(element.attribute("glyph.num").value()));
-        element.remove_attribute("glyph.num");
+    if ((attr = element.attribute("glyph.num"))) {
+        this->SetGlyphNum(StrToHexnum(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("glyph.uri")) {
-        this->SetGlyphUri(StrToStr(element.attribute("glyph.uri").value()));
-        element.remove_attribute("glyph.uri");
+    if ((attr = element.attribute("glyph.uri"))) {
+        this->SetGlyphUri(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
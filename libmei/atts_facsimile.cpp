@@ -47,9 +47,11 @@ void AttFacsimile::ResetFacsimile()
 bool AttFacsimile::ReadFacsimile(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("facs")) {
-        this->SetFacs(StrToStr(element.attribute("facs").value()));
-        element.remove_attribute("facs");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("facs"))) {
+        this->SetFacs(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
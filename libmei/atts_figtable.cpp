@@ -48,14 +48,16 @@ void AttTabular::ResetTabular()
 bool AttTabular::ReadTabular(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("colspan")) {
-        this->SetColspan(StrToInt(element.attribute("colspan").value()));
-        element.remove_attribute("colspan");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("colspan"))) {
+        this->SetColspan(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("rowspan")) {
-        this->SetRowspan(StrToInt(element.attribute("rowspan").value()));
-        element.remove_attribute("rowspan");
+    if ((attr = element.attribute("rowspan"))) {
+        this->SetRowspan(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttFingGrpLog::ResetFingGrpLog()
 bool AttFingGrpLog::ReadFingGrpLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToFingGrpLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToFingGrpLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttCourseLog::ResetCourseLog()
 bool AttCourseLog::ReadCourseLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tuning.standard")) {
-        this->SetTuningStandard(StrToCoursetuning(element.attribute("tuning.standard").value()));
-        element.remove_attribute("tuning.standard");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tuning.standard"))) {
+        this->SetTuningStandard(StrToCoursetuning(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -94,14 +96,16 @@ void AttNoteGesTab::ResetNoteGesTab()
 bool AttNoteGesTab::ReadNoteGesTab(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tab.course")) {
-        this->SetTabCourse(StrToInt(element.attribute("tab.course").value()));
-        element.remove_attribute("tab.course");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tab.course"))) {
+        this->SetTabCourse(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tab.fret")) {
-        this->SetTabFret(StrToInt(element.attribute("tab.fret").value()));
-        element.remove_attribute("tab.fret");
+    if ((attr = element.attribute("tab.fret"))) {
+        this->SetTabFret(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
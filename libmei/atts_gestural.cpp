@@ -47,9 +47,11 @@ void AttAccidentalGestural::ResetAccidentalGestural()
 bool AttAccidentalGestural::ReadAccidentalGestural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("accid.ges")) {
-        this->SetAccidGes(StrToAccidentalGestural(element.attribute("accid.ges").value()));
-        element.remove_attribute("accid.ges");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("accid.ges"))) {
+        this->SetAccidGes(StrToAccidentalGestural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -93,9 +95,11 @@ void AttArticulationGestural::ResetArticulationGestural()
 bool AttArticulationGestural::ReadArticulationGestural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("artic.ges")) {
-        this->SetArticGes(StrToArticulation(element.attribute("artic.ges").value()));
-        element.remove_attribute("artic.ges");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("artic.ges"))) {
+        this->SetArticGes(StrToArticulation(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -139,9 +143,11 @@ void AttBendGes::ResetBendGes()
 bool AttBendGes::ReadBendGes(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("amount")) {
-        this->SetAmount(StrToDbl(element.attribute("amount").value()));
-        element.remove_attribute("amount");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("amount"))) {
+        this->SetAmount(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -190,34 +196,36 @@ void AttDurationGestural::ResetDurationGestural()
 bool AttDurationGestural::ReadDurationGestural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dur.ges")) {
-        this->SetDurGes(StrToDuration(element.attribute("dur.ges").value()));
-        element.remove_attribute("dur.ges");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dur.ges"))) {
+        this->SetDurGes(StrToDuration(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dots.ges")) {
-        this->SetDotsGes(StrToInt(element.attribute("dots.ges").value()));
-        element.remove_attribute("dots.ges");
+    if ((attr = element.attribute("dots.ges"))) {
+        this->SetDotsGes(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dur.metrical")) {
-        this->SetDurMetrical(StrToDbl(element.attribute("dur.metrical").value()));
-        element.remove_attribute("dur.metrical");
+    if ((attr = element.attribute("dur.metrical"))) {
+        this->SetDurMetrical(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dur.ppq")) {
-        this->SetDurPpq(StrToInt(element.attribute("dur.ppq").value()));
-        element.remove_attribute("dur.ppq");
+    if ((attr = element.attribute("dur.ppq"))) {
+        this->SetDurPpq(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dur.real")) {
-        this->SetDurReal(StrToDbl(element.attribute("dur.real").value()));
-        element.remove_attribute("dur.real");
+    if ((attr = element.attribute("dur.real"))) {
+        this->SetDurReal(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dur.recip")) {
-        this->SetDurRecip(StrToStr(element.attribute("dur.recip").value()));
-        element.remove_attribute("dur.recip");
+    if ((attr = element.attribute("dur.recip"))) {
+        this->SetDurRecip(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -308,19 +316,21 @@ void AttNcGes::ResetNcGes()
 bool AttNcGes::ReadNcGes(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("oct.ges")) {
-        this->SetOctGes(StrToOctave(element.attribute("oct.ges").value()));
-        element.remove_attribute("oct.ges");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("oct.ges"))) {
+        this->SetOctGes(StrToOctave(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("pname.ges")) {
-        this->SetPnameGes(StrToPitchname(element.attribute("pname.ges").value()));
-        element.remove_attribute("pname.ges");
+    if ((attr = element.attribute("pname.ges"))) {
+        this->SetPnameGes(StrToPitchname(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("pnum")) {
-        this->SetPnum(StrToInt(element.attribute("pnum").value()));
-        element.remove_attribute("pnum");
+    if ((attr = element.attribute("pnum"))) {
+        this->SetPnum(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -385,24 +395,26 @@ void AttNoteGes::ResetNoteGes()
 bool AttNoteGes::ReadNoteGes(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("extremis")) {
-        this->SetExtremis(StrToNoteGesExtremis(element.attribute("extremis").value()));
-        element.remove_attribute("extremis");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("extremis"))) {
+        this->SetExtremis(StrToNoteGesExtremis(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("oct.ges")) {
-        this->SetOctGes(StrToOctave(element.attribute("oct.ges").value()));
-        element.remove_attribute("oct.ges");
+    if ((attr = element.attribute("oct.ges"))) {
+        this->SetOctGes(StrToOctave(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("pname.ges")) {
-        this->SetPnameGes(StrToPitchname(element.attribute("pname.ges").value()));
-        element.remove_attribute("pname.ges");
+    if ((attr = element.attribute("pname.ges"))) {
+        this->SetPnameGes(StrToPitchname(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("pnum")) {
-        this->SetPnum(StrToInt(element.attribute("pnum").value()));
-        element.remove_attribute("pnum");
+    if ((attr = element.attribute("pnum"))) {
+        this->SetPnum(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -475,19 +487,21 @@ void AttScoreDefGes::ResetScoreDefGes()
 bool AttScoreDefGes::ReadScoreDefGes(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tune.pname")) {
-        this->SetTunePname(StrToPitchname(element.attribute("tune.pname").value()));
-        element.remove_attribute("tune.pname");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tune.pname"))) {
+        this->SetTunePname(StrToPitchname(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tune.Hz")) {
-        this->SetTuneHz(StrToDbl(element.attribute("tune.Hz").value()));
-        element.remove_attribute("tune.Hz");
+    if ((attr = element.attribute("tune.Hz"))) {
+        this->SetTuneHz(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tune.temper")) {
-        this->SetTuneTemper(StrToTemperament(element.attribute("tune.temper").value()));
-        element.remove_attribute("tune.temper");
+    if ((attr = element.attribute("tune.temper"))) {
+        this->SetTuneTemper(StrToTemperament(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -549,9 +563,11 @@ void AttSectionGes::ResetSectionGes()
 bool AttSectionGes::ReadSectionGes(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("attacca")) {
-        this->SetAttacca(StrToBoolean(element.attribute("attacca").value()));
-        element.remove_attribute("attacca");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("attacca"))) {
+        this->SetAttacca(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -596,14 +612,16 @@ void AttSoundLocation::ResetSoundLocation()
 bool AttSoundLocation::ReadSoundLocation(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("azimuth")) {
-        this->SetAzimuth(StrToDbl(element.attribute("azimuth").value()));
-        element.remove_attribute("azimuth");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("azimuth"))) {
+        this->SetAzimuth(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("elevation")) {
-        this->SetElevation(StrToDbl(element.attribute("elevation").value()));
-        element.remove_attribute("elevation");
+    if ((attr = element.attribute("elevation"))) {
+        this->SetElevation(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -657,14 +675,16 @@ void AttTimestampGestural::ResetTimestampGestural()
 bool AttTimestampGestural::ReadTimestampGestural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tstamp.ges")) {
-        this->SetTstampGes(StrToDbl(element.attribute("tstamp.ges").value()));
-        element.remove_attribute("tstamp.ges");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tstamp.ges"))) {
+        this->SetTstampGes(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tstamp.real")) {
-        this->SetTstampReal(StrToStr(element.attribute("tstamp.real").value()));
-        element.remove_attribute("tstamp.real");
+    if ((attr = element.attribute("tstamp.real"))) {
+        this->SetTstampReal(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -718,14 +738,16 @@ void AttTimestamp2Gestural::ResetTimestamp2Gestural()
 bool AttTimestamp2Gestural::ReadTimestamp2Gestural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tstamp2.ges")) {
-        this->SetTstamp2Ges(StrToMeasurebeat(element.attribute("tstamp2.ges").value()));
-        element.remove_attribute("tstamp2.ges");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tstamp2.ges"))) {
+        this->SetTstamp2Ges(StrToMeasurebeat(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tstamp2.real")) {
-        this->SetTstamp2Real(StrToStr(element.attribute("tstamp2.real").value()));
-        element.remove_attribute("tstamp2.real");
+    if ((attr = element.attribute("tstamp2.real"))) {
+        this->SetTstamp2Real(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
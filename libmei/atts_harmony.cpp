@@ -47,9 +47,11 @@ void AttHarmLog::ResetHarmLog()
 bool AttHarmLog::ReadHarmLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("chordref")) {
-        this->SetChordref(StrToStr(element.attribute("chordref").value()));
-        element.remove_attribute("chordref");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("chordref"))) {
+        this->SetChordref(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
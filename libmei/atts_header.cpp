@@ -50,24 +50,26 @@ void AttBifoliumSurfaces::ResetBifoliumSurfaces()
 bool AttBifoliumSurfaces::ReadBifoliumSurfaces(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("outer.recto")) {
-        this->SetOuterRecto(StrToStr(element.attribute("outer.recto").value()));
-        element.remove_attribute("outer.recto");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("outer.recto"))) {
+        this->SetOuterRecto(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("inner.verso")) {
-        this->SetInnerVerso(StrToStr(element.attribute("inner.verso").value()));
-        element.remove_attribute("inner.verso");
+    if ((attr = element.attribute("inner.verso"))) {
+        this->SetInnerVerso(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("inner.recto")) {
-        this->SetInnerRecto(StrToStr(element.attribute("inner.recto").value()));
-        element.remove_attribute("inner.recto");
+    if ((attr = element.attribute("inner.recto"))) {
+        this->SetInnerRecto(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("outer.verso")) {
-        this->SetOuterVerso(StrToStr(element.attribute("outer.verso").value()));
-        element.remove_attribute("outer.verso");
+    if ((attr = element.attribute("outer.verso"))) {
+        this->SetOuterVerso(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -139,14 +141,16 @@ void AttFoliumSurfaces::ResetFoliumSurfaces()
 bool AttFoliumSurfaces::ReadFoliumSurfaces(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("recto")) {
-        this->SetRecto(StrToStr(element.attribute("recto").value()));
-        element.remove_attribute("recto");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("recto"))) {
+        this->SetRecto(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("verso")) {
-        this->SetVerso(StrToStr(element.attribute("verso").value()));
-        element.remove_attribute("verso");
+    if ((attr = element.attribute("verso"))) {
+        this->SetVerso(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -199,9 +203,11 @@ void AttRecordType::ResetRecordType()
 bool AttRecordType::ReadRecordType(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("recordtype")) {
-        this->SetRecordtype(StrToRecordTypeRecordtype(element.attribute("recordtype").value()));
-        element.remove_attribute("recordtype");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("recordtype"))) {
+        this->SetRecordtype(StrToRecordTypeRecordtype(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -245,9 +251,11 @@ void AttRegularMethod::ResetRegularMethod()
 bool AttRegularMethod::ReadRegularMethod(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("method")) {
-        this->SetMethod(StrToRegularMethodMethod(element.attribute("method").value()));
-        element.remove_attribute("method");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("method"))) {
+        this->SetMethod(StrToRegularMethodMethod(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
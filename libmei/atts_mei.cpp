@@ -48,14 +48,16 @@ void AttNotationType::ResetNotationType()
 bool AttNotationType::ReadNotationType(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("notationtype")) {
-        this->SetNotationtype(StrToNotationtype(element.attribute("notationtype").value()));
-        element.remove_attribute("notationtype");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("notationtype"))) {
+        this->SetNotationtype(StrToNotationtype(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("notationsubtype")) {
-        this->SetNotationsubtype(StrToStr(element.attribute("notationsubtype").value()));
-        element.remove_attribute("notationsubtype");
+    if ((attr = element.attribute("notationsubtype"))) {
+        this->SetNotationsubtype(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttDurationQuality::ResetDurationQuality()
 bool AttDurationQuality::ReadDurationQuality(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dur.quality")) {
-        this->SetDurQuality(StrToDurqualityMensural(element.attribute("dur.quality").value()));
-        element.remove_attribute("dur.quality");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dur.quality"))) {
+        this->SetDurQuality(StrToDurqualityMensural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -94,14 +96,16 @@ void AttMensuralLog::ResetMensuralLog()
 bool AttMensuralLog::ReadMensuralLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("proport.num")) {
-        this->SetProportNum(StrToInt(element.attribute("proport.num").value()));
-        element.remove_attribute("proport.num");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("proport.num"))) {
+        this->SetProportNum(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("proport.numbase")) {
-        this->SetProportNumbase(StrToInt(element.attribute("proport.numbase").value()));
-        element.remove_attribute("proport.numbase");
+    if ((attr = element.attribute("proport.numbase"))) {
+        this->SetProportNumbase(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -158,29 +162,31 @@ void AttMensuralShared::ResetMensuralShared()
 bool AttMensuralShared::ReadMensuralShared(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("modusmaior")) {
-        this->SetModusmaior(StrToModusmaior(element.attribute("modusmaior").value()));
-        element.remove_attribute("modusmaior");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("modusmaior"))) {
+        this->SetModusmaior(StrToModusmaior(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("modusminor")) {
-        this->SetModusminor(StrToModusminor(element.attribute("modusminor").value()));
-        element.remove_attribute("modusminor");
+    if ((attr = element.attribute("modusminor"))) {
+        this->SetModusminor(StrToModusminor(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("prolatio")) {
-        this->SetProlatio(StrToProlatio(element.attribute("prolatio").value()));
-        element.remove_attribute("prolatio");
+    if ((attr = element.attribute("prolatio"))) {
+        this->SetProlatio(StrToProlatio(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tempus")) {
-        this->SetTempus(StrToTempus(element.attribute("tempus").value()));
-        element.remove_attribute("tempus");
+    if ((attr = element.attribute("tempus"))) {
+        this->SetTempus(StrToTempus(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("divisio")) {
-        this->SetDivisio(StrToDivisio(element.attribute("divisio").value()));
-        element.remove_attribute("divisio");
+    if ((attr = element.attribute("divisio"))) {
+        this->SetDivisio(StrToDivisio(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -260,9 +266,11 @@ void AttNoteVisMensural::ResetNoteVisMensural()
 bool AttNoteVisMensural::ReadNoteVisMensural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lig")) {
-        this->SetLig(StrToLigatureform(element.attribute("lig").value()));
-        element.remove_attribute("lig");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lig"))) {
+        this->SetLig(StrToLigatureform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -307,14 +315,16 @@ void AttPlicaVis::ResetPlicaVis()
 bool AttPlicaVis::ReadPlicaVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dir")) {
-        this->SetDir(StrToStemdirectionBasic(element.attribute("dir").value()));
-        element.remove_attribute("dir");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dir"))) {
+        this->SetDir(StrToStemdirectionBasic(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("len")) {
-        this->SetLen(StrToDbl(element.attribute("len").value()));
-        element.remove_attribute("len");
+    if ((attr = element.attribute("len"))) {
+        this->SetLen(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -367,9 +377,11 @@ void AttRestVisMensural::ResetRestVisMensural()
 bool AttRestVisMensural::ReadRestVisMensural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("spaces")) {
-        this->SetSpaces(StrToInt(element.attribute("spaces").value()));
-        element.remove_attribute("spaces");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("spaces"))) {
+        this->SetSpaces(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -418,34 +430,36 @@ void AttStemVis::ResetStemVis()
 bool AttStemVis::ReadStemVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("pos")) {
-        this->SetPos(StrToStemposition(element.attribute("pos").value()));
-        element.remove_attribute("pos");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("pos"))) {
+        this->SetPos(StrToStemposition(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("len")) {
-        this->SetLen(StrToDbl(element.attribute("len").value()));
-        element.remove_attribute("len");
+    if ((attr = element.attribute("len"))) {
+        this->SetLen(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("form")) {
-        this->SetForm(StrToStemformMensural(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToStemformMensural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dir")) {
-        this->SetDir(StrToStemdirection(element.attribute("dir").value()));
-        element.remove_attribute("dir");
+    if ((attr = element.attribute("dir"))) {
+        this->SetDir(StrToStemdirection(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("flag.pos")) {
-        this->SetFlagPos(StrToFlagposMensural(element.attribute("flag.pos").value()));
-        element.remove_attribute("flag.pos");
+    if ((attr = element.attribute("flag.pos"))) {
+        this->SetFlagPos(StrToFlagposMensural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("flag.form")) {
-        this->SetFlagForm(StrToFlagformMensural(element.attribute("flag.form").value()));
-        element.remove_attribute("flag.form");
+    if ((attr = element.attribute("flag.form"))) {
+        this->SetFlagForm(StrToFlagformMensural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -534,9 +548,11 @@ void AttStemsMensural::ResetStemsMensural()
 bool AttStemsMensural::ReadStemsMensural(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("stem.form")) {
-        this->SetStemForm(StrToStemformMensural(element.attribute("stem.form").value()));
-        element.remove_attribute("stem.form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("stem.form"))) {
+        this->SetStemForm(StrToStemformMensural(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
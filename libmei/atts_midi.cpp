@@ -50,24 +50,26 @@ void AttChannelized::ResetChannelized()
 bool AttChannelized::ReadChannelized(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("midi.channel")) {
-        this->SetMidiChannel(StrToMidichannel(element.attribute("midi.channel").value()));
-        element.remove_attribute("midi.channel");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("midi.channel"))) {
+        this->SetMidiChannel(StrToMidichannel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.duty")) {
-        this->SetMidiDuty(StrToPercentLimited(element.attribute("midi.duty").value()));
-        element.remove_attribute("midi.duty");
+    if ((attr = element.attribute("midi.duty"))) {
+        this->SetMidiDuty(StrToPercentLimited(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.port")) {
-        this->SetMidiPort(StrToMidivalueName(element.attribute("midi.port").value()));
-        element.remove_attribute("midi.port");
+    if ((attr = element.attribute("midi.port"))) {
+        this->SetMidiPort(StrToMidivalueName(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.track")) {
-        this->SetMidiTrack(StrToInt(element.attribute("midi.track").value()));
-        element.remove_attribute("midi.track");
+    if ((attr = element.attribute("midi.track"))) {
+        this->SetMidiTrack(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -138,9 +140,11 @@ void AttInstrumentIdent::ResetInstrumentIdent()
 bool AttInstrumentIdent::ReadInstrumentIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("instr")) {
-        this->SetInstr(StrToStr(element.attribute("instr").value()));
-        element.remove_attribute("instr");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("instr"))) {
+        this->SetInstr(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -189,34 +193,36 @@ void AttMidiInstrument::ResetMidiInstrument()
 bool AttMidiInstrument::ReadMidiInstrument(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("midi.instrnum")) {
-        this->SetMidiInstrnum(StrToMidivalue(element.attribute("midi.instrnum").value()));
-        element.remove_attribute("midi.instrnum");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("midi.instrnum"))) {
+        this->SetMidiInstrnum(StrToMidivalue(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.instrname")) {
-        this->SetMidiInstrname(StrToMidinames(element.attribute("midi.instrname").value()));
-        element.remove_attribute("midi.instrname");
+    if ((attr = element.attribute("midi.instrname"))) {
+        this->SetMidiInstrname(StrToMidinames(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.pan")) {
-        this->SetMidiPan(StrToMidivaluePan(element.attribute("midi.pan").value()));
-        element.remove_attribute("midi.pan");
+    if ((attr = element.attribute("midi.pan"))) {
+        this->SetMidiPan(StrToMidivaluePan(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.patchname")) {
-        this->SetMidiPatchname(StrToStr(element.attribute("midi.patchname").value()));
-        element.remove_attribute("midi.patchname");
+    if ((attr = element.attribute("midi.patchname"))) {
+        this->SetMidiPatchname(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.patchnum")) {
-        this->SetMidiPatchnum(StrToMidivalue(element.attribute("midi.patchnum").value()));
-        element.remove_attribute("midi.patchnum");
+    if ((attr = element.attribute("midi.patchnum"))) {
+        this->SetMidiPatchnum(StrToMidivalue(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.volume")) {
-        this->SetMidiVolume(StrToPercent(element.attribute("midi.volume").value()));
-        element.remove_attribute("midi.volume");
+    if ((attr = element.attribute("midi.volume"))) {
+        this->SetMidiVolume(StrToPercent(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -305,9 +311,11 @@ void AttMidiNumber::ResetMidiNumber()
 bool AttMidiNumber::ReadMidiNumber(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("num")) {
-        this->SetNum(StrToInt(element.attribute("num").value()));
-        element.remove_attribute("num");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("num"))) {
+        this->SetNum(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -352,14 +360,16 @@ void AttMidiTempo::ResetMidiTempo()
 bool AttMidiTempo::ReadMidiTempo(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("midi.bpm")) {
-        this->SetMidiBpm(StrToMidibpm(element.attribute("midi.bpm").value()));
-        element.remove_attribute("midi.bpm");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("midi.bpm"))) {
+        this->SetMidiBpm(StrToMidibpm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("midi.mspb")) {
-        this->SetMidiMspb(StrToMidimspb(element.attribute("midi.mspb").value()));
-        element.remove_attribute("midi.mspb");
+    if ((attr = element.attribute("midi.mspb"))) {
+        this->SetMidiMspb(StrToMidimspb(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -412,9 +422,11 @@ void AttMidiValue::ResetMidiValue()
 bool AttMidiValue::ReadMidiValue(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("val")) {
-        this->SetVal(StrToMidivalue(element.attribute("val").value()));
-        element.remove_attribute("val");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("val"))) {
+        this->SetVal(StrToMidivalue(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -458,9 +470,11 @@ void AttMidiValue2::ResetMidiValue2()
 bool AttMidiValue2::ReadMidiValue2(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("val2")) {
-        this->SetVal2(StrToMidivalue(element.attribute("val2").value()));
-        element.remove_attribute("val2");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("val2"))) {
+        this->SetVal2(StrToMidivalue(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -504,9 +518,11 @@ void AttMidiVelocity::ResetMidiVelocity()
 bool AttMidiVelocity::ReadMidiVelocity(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("vel")) {
-        this->SetVel(StrToMidivalue(element.attribute("vel").value()));
-        element.remove_attribute("vel");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("vel"))) {
+        this->SetVel(StrToMidivalue(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -550,9 +566,11 @@ void AttTimeBase::ResetTimeBase()
 bool AttTimeBase::ReadTimeBase(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ppq")) {
-        this->SetPpq(StrToInt(element.attribute("ppq").value()));
-        element.remove_attribute("ppq");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ppq"))) {
+        this->SetPpq(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -48,14 +48,16 @@ void AttNcLog::ResetNcLog()
 bool AttNcLog::ReadNcLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("oct")) {
-        this->SetOct(StrToStr(element.attribute("oct").value()));
-        element.remove_attribute("oct");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("oct"))) {
+        this->SetOct(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("pname")) {
-        this->SetPname(StrToStr(element.attribute("pname").value()));
-        element.remove_attribute("pname");
+    if ((attr = element.attribute("pname"))) {
+        this->SetPname(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -115,44 +117,46 @@ void AttNcForm::ResetNcForm()
 bool AttNcForm::ReadNcForm(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("angled")) {
-        this->SetAngled(StrToBoolean(element.attribute("angled").value()));
-        element.remove_attribute("angled");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("angled"))) {
+        this->SetAngled(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("con")) {
-        this->SetCon(StrToNcFormCon(element.attribute("con").value()));
-        element.remove_attribute("con");
+    if ((attr = element.attribute("con"))) {
+        this->SetCon(StrToNcFormCon(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("curve")) {
-        this->SetCurve(StrToNcFormCurve(element.attribute("curve").value()));
-        element.remove_attribute("curve");
+    if ((attr = element.attribute("curve"))) {
+        this->SetCurve(StrToNcFormCurve(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("hooked")) {
-        this->SetHooked(StrToBoolean(element.attribute("hooked").value()));
-        element.remove_attribute("hooked");
+    if ((attr = element.attribute("hooked"))) {
+        this->SetHooked(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("ligated")) {
-        this->SetLigated(StrToBoolean(element.attribute("ligated").value()));
-        element.remove_attribute("ligated");
+    if ((attr = element.attribute("ligated"))) {
+        this->SetLigated(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("rellen")) {
-        this->SetRellen(StrToNcFormRellen(element.attribute("rellen").value()));
-        element.remove_attribute("rellen");
+    if ((attr = element.attribute("rellen"))) {
+        this->SetRellen(StrToNcFormRellen(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("sShape")) {
-        this->SetSShape(StrToStr(element.attribute("sShape").value()));
-        element.remove_attribute("sShape");
+    if ((attr = element.attribute("sShape"))) {
+        this->SetSShape(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tilt")) {
-        this->SetTilt(StrToCompassdirection(element.attribute("tilt").value()));
-        element.remove_attribute("tilt");
+    if ((attr = element.attribute("tilt"))) {
+        this->SetTilt(StrToCompassdirection(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttSurface::ResetSurface()
 bool AttSurface::ReadSurface(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("surface")) {
-        this->SetSurface(StrToStr(element.attribute("surface").value()));
-        element.remove_attribute("surface");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("surface"))) {
+        this->SetSurface(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttAlignment::ResetAlignment()
 bool AttAlignment::ReadAlignment(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("when")) {
-        this->SetWhen(StrToStr(element.attribute("when").value()));
-        element.remove_attribute("when");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("when"))) {
+        this->SetWhen(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttAccidLog::ResetAccidLog()
 bool AttAccidLog::ReadAccidLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToAccidLogFunc(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToAccidLogFunc(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -93,9 +95,11 @@ void AttAccidental::ResetAccidental()
 bool AttAccidental::ReadAccidental(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("accid")) {
-        this->SetAccid(StrToAccidentalWritten(element.attribute("accid").value()));
-        element.remove_attribute("accid");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("accid"))) {
+        this->SetAccid(StrToAccidentalWritten(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -139,9 +143,11 @@ void AttArticulation::ResetArticulation()
 bool AttArticulation::ReadArticulation(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("artic")) {
-        this->SetArtic(StrToArticulationList(element.attribute("artic").value()));
-        element.remove_attribute("artic");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("artic"))) {
+        this->SetArtic(StrToArticulationList(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -185,9 +191,11 @@ void AttAttaccaLog::ResetAttaccaLog()
 bool AttAttaccaLog::ReadAttaccaLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("target")) {
-        this->SetTarget(StrToStr(element.attribute("target").value()));
-        element.remove_attribute("target");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("target"))) {
+        this->SetTarget(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -231,9 +239,11 @@ void AttAudience::ResetAudience()
 bool AttAudience::ReadAudience(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("audience")) {
-        this->SetAudience(StrToAudienceAudience(element.attribute("audience").value()));
-        element.remove_attribute("audience");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("audience"))) {
+        this->SetAudience(StrToAudienceAudience(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -277,9 +287,11 @@ void AttAugmentDots::ResetAugmentDots()
 bool AttAugmentDots::ReadAugmentDots(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dots")) {
-        this->SetDots(StrToInt(element.attribute("dots").value()));
-        element.remove_attribute("dots");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dots"))) {
+        this->SetDots(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -324,14 +336,16 @@ void AttAuthorized::ResetAuthorized()
 bool AttAuthorized::ReadAuthorized(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("auth")) {
-        this->SetAuth(StrToStr(element.attribute("auth").value()));
-        element.remove_attribute("auth");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("auth"))) {
+        this->SetAuth(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("auth.uri")) {
-        this->SetAuthUri(StrToStr(element.attribute("auth.uri").value()));
-        element.remove_attribute("auth.uri");
+    if ((attr = element.attribute("auth.uri"))) {
+        this->SetAuthUri(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -384,9 +398,11 @@ void AttBarLineLog::ResetBarLineLog()
 bool AttBarLineLog::ReadBarLineLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToBarrendition(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToBarrendition(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -432,19 +448,21 @@ void AttBarring::ResetBarring()
 bool AttBarring::ReadBarring(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("bar.len")) {
-        this->SetBarLen(StrToDbl(element.attribute("bar.len").value()));
-        element.remove_attribute("bar.len");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("bar.len"))) {
+        this->SetBarLen(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("bar.method")) {
-        this->SetBarMethod(StrToBarmethod(element.attribute("bar.method").value()));
-        element.remove_attribute("bar.method");
+    if ((attr = element.attribute("bar.method"))) {
+        this->SetBarMethod(StrToBarmethod(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("bar.place")) {
-        this->SetBarPlace(StrToInt(element.attribute("bar.place").value()));
-        element.remove_attribute("bar.place");
+    if ((attr = element.attribute("bar.place"))) {
+        this->SetBarPlace(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -506,9 +524,11 @@ void AttBasic::ResetBasic()
 bool AttBasic::ReadBasic(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("xml:base")) {
-        this->SetBase(StrToStr(element.attribute("xml:base").value()));
-        element.remove_attribute("xml:base");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("xml:base"))) {
+        this->SetBase(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -552,9 +572,11 @@ void AttBibl::ResetBibl()
 bool AttBibl::ReadBibl(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("analog")) {
-        this->SetAnalog(StrToStr(element.attribute("analog").value()));
-        element.remove_attribute("analog");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("analog"))) {
+        this->SetAnalog(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -598,9 +620,11 @@ void AttCalendared::ResetCalendared()
 bool AttCalendared::ReadCalendared(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("calendar")) {
-        this->SetCalendar(StrToStr(element.attribute("calendar").value()));
-        element.remove_attribute("calendar");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("calendar"))) {
+        this->SetCalendar(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -644,9 +668,11 @@ void AttCanonical::ResetCanonical()
 bool AttCanonical::ReadCanonical(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("codedval")) {
-        this->SetCodedval(StrToStr(element.attribute("codedval").value()));
-        element.remove_attribute("codedval");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("codedval"))) {
+        this->SetCodedval(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -690,9 +716,11 @@ void AttClassed::ResetClassed()
 bool AttClassed::ReadClassed(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("class")) {
-        this->SetClass(StrToStr(element.attribute("class").value()));
-        element.remove_attribute("class");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("class"))) {
+        this->SetClass(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -736,9 +764,11 @@ void AttClefLog::ResetClefLog()
 bool AttClefLog::ReadClefLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("cautionary")) {
-        this->SetCautionary(StrToBoolean(element.attribute("cautionary").value()));
-        element.remove_attribute("cautionary");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("cautionary"))) {
+        this->SetCautionary(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -782,9 +812,11 @@ void AttClefShape::ResetClefShape()
 bool AttClefShape::ReadClefShape(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("shape")) {
-        this->SetShape(StrToClefshape(element.attribute("shape").value()));
-        element.remove_attribute("shape");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("shape"))) {
+        this->SetShape(StrToClefshape(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -831,24 +863,26 @@ void AttCleffingLog::ResetCleffingLog()
 bool AttCleffingLog::ReadCleffingLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("clef.shape")) {
-        this->SetClefShape(StrToClefshape(element.attribute("clef.shape").value()));
-        element.remove_attribute("clef.shape");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("clef.shape"))) {
+        this->SetClefShape(StrToClefshape(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("clef.line")) {
-        this->SetClefLine(StrToInt(element.attribute("clef.line").value()));
-        element.remove_attribute("clef.line");
+    if ((attr = element.attribute("clef.line"))) {
+        this->SetClefLine(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("clef.dis")) {
-        this->SetClefDis(StrToOctaveDis(element.attribute("clef.dis").value()));
-        element.remove_attribute("clef.dis");
+    if ((attr = element.attribute("clef.dis"))) {
+        this->SetClefDis(StrToOctaveDis(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("clef.dis.place")) {
-        this->SetClefDisPlace(StrToStaffrelBasic(element.attribute("clef.dis.place").value()));
-        element.remove_attribute("clef.dis.place");
+    if ((attr = element.attribute("clef.dis.place"))) {
+        this->SetClefDisPlace(StrToStaffrelBasic(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -919,9 +953,11 @@ void AttColor::ResetColor()
 bool AttColor::ReadColor(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("color")) {
-        this->SetColor(StrToStr(element.attribute("color").value()));
-        element.remove_attribute("color");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("color"))) {
+        this->SetColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -965,9 +1001,11 @@ void AttColoration::ResetColoration()
 bool AttColoration::ReadColoration(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("colored")) {
-        this->SetColored(StrToBoolean(element.attribute("colored").value()));
-        element.remove_attribute("colored");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("colored"))) {
+        this->SetColored(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1015,29 +1053,31 @@ void AttCoordinated::ResetCoordinated()
 bool AttCoordinated::ReadCoordinated(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ulx")) {
-        this->SetUlx(StrToInt(element.attribute("ulx").value()));
-        element.remove_attribute("ulx");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ulx"))) {
+        this->SetUlx(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("uly")) {
-        this->SetUly(StrToInt(element.attribute("uly").value()));
-        element.remove_attribute("uly");
+    if ((attr = element.attribute("uly"))) {
+        this->SetUly(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lrx")) {
-        this->SetLrx(StrToInt(element.attribute("lrx").value()));
-        element.remove_attribute("lrx");
+    if ((attr = element.attribute("lrx"))) {
+        this->SetLrx(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lry")) {
-        this->SetLry(StrToInt(element.attribute("lry").value()));
-        element.remove_attribute("lry");
+    if ((attr = element.attribute("lry"))) {
+        this->SetLry(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("rotate")) {
-        this->SetRotate(StrToDbl(element.attribute("rotate").value()));
-        element.remove_attribute("rotate");
+    if ((attr = element.attribute("rotate"))) {
+        this->SetRotate(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1117,9 +1157,11 @@ void AttCue::ResetCue()
 bool AttCue::ReadCue(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("cue")) {
-        this->SetCue(StrToBoolean(element.attribute("cue").value()));
-        element.remove_attribute("cue");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("cue"))) {
+        this->SetCue(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1165,19 +1207,21 @@ void AttCurvature::ResetCurvature()
 bool AttCurvature::ReadCurvature(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("bezier")) {
-        this->SetBezier(StrToStr(element.attribute("bezier").value()));
-        element.remove_attribute("bezier");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("bezier"))) {
+        this->SetBezier(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("bulge")) {
-        this->SetBulge(StrToStr(element.attribute("bulge").value()));
-        element.remove_attribute("bulge");
+    if ((attr = element.attribute("bulge"))) {
+        this->SetBulge(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("curvedir")) {
-        this->SetCurvedir(StrToCurvatureCurvedir(element.attribute("curvedir").value()));
-        element.remove_attribute("curvedir");
+    if ((attr = element.attribute("curvedir"))) {
+        this->SetCurvedir(StrToCurvatureCurvedir(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1240,14 +1284,16 @@ void AttCurveRend::ResetCurveRend()
 bool AttCurveRend::ReadCurveRend(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lform")) {
-        this->SetLform(StrToLineform(element.attribute("lform").value()));
-        element.remove_attribute("lform");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lform"))) {
+        this->SetLform(StrToLineform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lwidth")) {
-        this->SetLwidth(StrToLinewidth(element.attribute("lwidth").value()));
-        element.remove_attribute("lwidth");
+    if ((attr = element.attribute("lwidth"))) {
+        this->SetLwidth(StrToLinewidth(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1300,9 +1346,11 @@ void AttCustosLog::ResetCustosLog()
 bool AttCustosLog::ReadCustosLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("target")) {
-        this->SetTarget(StrToStr(element.attribute("target").value()));
-        element.remove_attribute("target");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("target"))) {
+        this->SetTarget(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1346,9 +1394,11 @@ void AttDataPointing::ResetDataPointing()
 bool AttDataPointing::ReadDataPointing(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("data")) {
-        this->SetData(StrToStr(element.attribute("data").value()));
-        element.remove_attribute("data");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("data"))) {
+        this->SetData(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1396,29 +1446,31 @@ void AttDatable::ResetDatable()
 bool AttDatable::ReadDatable(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("enddate")) {
-        this->SetEnddate(StrToStr(element.attribute("enddate").value()));
-        element.remove_attribute("enddate");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("enddate"))) {
+        this->SetEnddate(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("isodate")) {
-        this->SetIsodate(StrToStr(element.attribute("isodate").value()));
-        element.remove_attribute("isodate");
+    if ((attr = element.attribute("isodate"))) {
+        this->SetIsodate(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("notafter")) {
-        this->SetNotafter(StrToStr(element.attribute("notafter").value()));
-        element.remove_attribute("notafter");
+    if ((attr = element.attribute("notafter"))) {
+        this->SetNotafter(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("notbefore")) {
-        this->SetNotbefore(StrToStr(element.attribute("notbefore").value()));
-        element.remove_attribute("notbefore");
+    if ((attr = element.attribute("notbefore"))) {
+        this->SetNotbefore(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("startdate")) {
-        this->SetStartdate(StrToStr(element.attribute("startdate").value()));
-        element.remove_attribute("startdate");
+    if ((attr = element.attribute("startdate"))) {
+        this->SetStartdate(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1500,19 +1552,21 @@ void AttDistances::ResetDistances()
 bool AttDistances::ReadDistances(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dynam.dist")) {
-        this->SetDynamDist(StrToMeasurementrel(element.attribute("dynam.dist").value()));
-        element.remove_attribute("dynam.dist");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dynam.dist"))) {
+        this->SetDynamDist(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("harm.dist")) {
-        this->SetHarmDist(StrToMeasurementrel(element.attribute("harm.dist").value()));
-        element.remove_attribute("harm.dist");
+    if ((attr = element.attribute("harm.dist"))) {
+        this->SetHarmDist(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("text.dist")) {
-        this->SetTextDist(StrToMeasurementrel(element.attribute("text.dist").value()));
-        element.remove_attribute("text.dist");
+    if ((attr = element.attribute("text.dist"))) {
+        this->SetTextDist(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1574,9 +1628,11 @@ void AttDotLog::ResetDotLog()
 bool AttDotLog::ReadDotLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToDotLogForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToDotLogForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1620,9 +1676,11 @@ void AttDurationAdditive::ResetDurationAdditive()
 bool AttDurationAdditive::ReadDurationAdditive(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dur")) {
-        this->SetDur(StrToDuration(element.attribute("dur").value()));
-        element.remove_attribute("dur");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dur"))) {
+        this->SetDur(StrToDuration(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1668,19 +1726,21 @@ void AttDurationDefault::ResetDurationDefault()
 bool AttDurationDefault::ReadDurationDefault(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dur.default")) {
-        this->SetDurDefault(StrToDuration(element.attribute("dur.default").value()));
-        element.remove_attribute("dur.default");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dur.default"))) {
+        this->SetDurDefault(StrToDuration(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("num.default")) {
-        this->SetNumDefault(StrToInt(element.attribute("num.default").value()));
-        element.remove_attribute("num.default");
+    if ((attr = element.attribute("num.default"))) {
+        this->SetNumDefault(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("numbase.default")) {
-        this->SetNumbaseDefault(StrToInt(element.attribute("numbase.default").value()));
-        element.remove_attribute("numbase.default");
+    if ((attr = element.attribute("numbase.default"))) {
+        this->SetNumbaseDefault(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1742,9 +1802,11 @@ void AttDurationLogical::ResetDurationLogical()
 bool AttDurationLogical::ReadDurationLogical(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dur")) {
-        this->SetDur(StrToDuration(element.attribute("dur").value()));
-        element.remove_attribute("dur");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dur"))) {
+        this->SetDur(StrToDuration(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1789,14 +1851,16 @@ void AttDurationRatio::ResetDurationRatio()
 bool AttDurationRatio::ReadDurationRatio(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("num")) {
-        this->SetNum(StrToInt(element.attribute("num").value()));
-        element.remove_attribute("num");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("num"))) {
+        this->SetNum(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("numbase")) {
-        this->SetNumbase(StrToInt(element.attribute("numbase").value()));
-        element.remove_attribute("numbase");
+    if ((attr = element.attribute("numbase"))) {
+        this->SetNumbase(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1849,9 +1913,11 @@ void AttEnclosingChars::ResetEnclosingChars()
 bool AttEnclosingChars::ReadEnclosingChars(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("enclose")) {
-        this->SetEnclose(StrToEnclosure(element.attribute("enclose").value()));
-        element.remove_attribute("enclose");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("enclose"))) {
+        this->SetEnclose(StrToEnclosure(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1895,9 +1961,11 @@ void AttEndings::ResetEndings()
 bool AttEndings::ReadEndings(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ending.rend")) {
-        this->SetEndingRend(StrToEndingsEndingrend(element.attribute("ending.rend").value()));
-        element.remove_attribute("ending.rend");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ending.rend"))) {
+        this->SetEndingRend(StrToEndingsEndingrend(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1942,14 +2010,16 @@ void AttEvidence::ResetEvidence()
 bool AttEvidence::ReadEvidence(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("cert")) {
-        this->SetCert(StrToCertainty(element.attribute("cert").value()));
-        element.remove_attribute("cert");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("cert"))) {
+        this->SetCert(StrToCertainty(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("evidence")) {
-        this->SetEvidence(StrToStr(element.attribute("evidence").value()));
-        element.remove_attribute("evidence");
+    if ((attr = element.attribute("evidence"))) {
+        this->SetEvidence(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2002,9 +2072,11 @@ void AttExtender::ResetExtender()
 bool AttExtender::ReadExtender(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("extender")) {
-        this->SetExtender(StrToBoolean(element.attribute("extender").value()));
-        element.remove_attribute("extender");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("extender"))) {
+        this->SetExtender(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2048,9 +2120,11 @@ void AttExtent::ResetExtent()
 bool AttExtent::ReadExtent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("extent")) {
-        this->SetExtent(StrToStr(element.attribute("extent").value()));
-        element.remove_attribute("extent");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("extent"))) {
+        this->SetExtent(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2094,9 +2168,11 @@ void AttFermataPresent::ResetFermataPresent()
 bool AttFermataPresent::ReadFermataPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("fermata")) {
-        this->SetFermata(StrToStaffrelBasic(element.attribute("fermata").value()));
-        element.remove_attribute("fermata");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("fermata"))) {
+        this->SetFermata(StrToStaffrelBasic(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2140,9 +2216,11 @@ void AttFiling::ResetFiling()
 bool AttFiling::ReadFiling(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("nonfiling")) {
-        this->SetNonfiling(StrToInt(element.attribute("nonfiling").value()));
-        element.remove_attribute("nonfiling");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("nonfiling"))) {
+        this->SetNonfiling(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2186,9 +2264,11 @@ void AttGrpSymLog::ResetGrpSymLog()
 bool AttGrpSymLog::ReadGrpSymLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("level")) {
-        this->SetLevel(StrToInt(element.attribute("level").value()));
-        element.remove_attribute("level");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("level"))) {
+        this->SetLevel(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2232,9 +2312,11 @@ void AttHandIdent::ResetHandIdent()
 bool AttHandIdent::ReadHandIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("hand")) {
-        this->SetHand(StrToStr(element.attribute("hand").value()));
-        element.remove_attribute("hand");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("hand"))) {
+        this->SetHand(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2278,9 +2360,11 @@ void AttHeight::ResetHeight()
 bool AttHeight::ReadHeight(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("height")) {
-        this->SetHeight(StrToMeasurementabs(element.attribute("height").value()));
-        element.remove_attribute("height");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("height"))) {
+        this->SetHeight(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2324,9 +2408,11 @@ void AttHorizontalAlign::ResetHorizontalAlign()
 bool AttHorizontalAlign::ReadHorizontalAlign(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("halign")) {
-        this->SetHalign(StrToHorizontalalignment(element.attribute("halign").value()));
-        element.remove_attribute("halign");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("halign"))) {
+        this->SetHalign(StrToHorizontalalignment(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2370,9 +2456,11 @@ void AttInternetMedia::ResetInternetMedia()
 bool AttInternetMedia::ReadInternetMedia(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("mimetype")) {
-        this->SetMimetype(StrToStr(element.attribute("mimetype").value()));
-        element.remove_attribute("mimetype");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("mimetype"))) {
+        this->SetMimetype(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2416,9 +2504,11 @@ void AttJoined::ResetJoined()
 bool AttJoined::ReadJoined(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("join")) {
-        this->SetJoin(StrToStr(element.attribute("join").value()));
-        element.remove_attribute("join");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("join"))) {
+        this->SetJoin(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2462,9 +2552,11 @@ void AttKeySigLog::ResetKeySigLog()
 bool AttKeySigLog::ReadKeySigLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("sig")) {
-        this->SetSig(StrToKeysignature(element.attribute("sig").value()));
-        element.remove_attribute("sig");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("sig"))) {
+        this->SetSig(StrToKeysignature(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2508,9 +2600,11 @@ void AttKeySigDefaultLog::ResetKeySigDefaultLog()
 bool AttKeySigDefaultLog::ReadKeySigDefaultLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("key.sig")) {
-        this->SetKeySig(StrToKeysignature(element.attribute("key.sig").value()));
-        element.remove_attribute("key.sig");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("key.sig"))) {
+        this->SetKeySig(StrToKeysignature(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2554,9 +2648,11 @@ void AttLabelled::ResetLabelled()
 bool AttLabelled::ReadLabelled(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("label")) {
-        this->SetLabel(StrToStr(element.attribute("label").value()));
-        element.remove_attribute("label");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("label"))) {
+        this->SetLabel(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2601,14 +2697,16 @@ void AttLang::ResetLang()
 bool AttLang::ReadLang(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("xml:lang")) {
-        this->SetLang(StrToStr(element.attribute("xml:lang").value()));
-        element.remove_attribute("xml:lang");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("xml:lang"))) {
+        this->SetLang(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("xml:translit")) {
-        this->SetTranslit(StrToStr(element.attribute("xml:translit").value()));
-        element.remove_attribute("xml:translit");
+    if ((attr = element.attribute("xml:translit"))) {
+        this->SetTranslit(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2661,9 +2759,11 @@ void AttLayerLog::ResetLayerLog()
 bool AttLayerLog::ReadLayerLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("def")) {
-        this->SetDef(StrToStr(element.attribute("def").value()));
-        element.remove_attribute("def");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("def"))) {
+        this->SetDef(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2707,9 +2807,11 @@ void AttLayerIdent::ResetLayerIdent()
 bool AttLayerIdent::ReadLayerIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("layer")) {
-        this->SetLayer(StrToInt(element.attribute("layer").value()));
-        element.remove_attribute("layer");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("layer"))) {
+        this->SetLayer(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2753,9 +2855,11 @@ void AttLineLoc::ResetLineLoc()
 bool AttLineLoc::ReadLineLoc(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("line")) {
-        this->SetLine(StrToInt(element.attribute("line").value()));
-        element.remove_attribute("line");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("line"))) {
+        this->SetLine(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2802,24 +2906,26 @@ void AttLineRend::ResetLineRend()
 bool AttLineRend::ReadLineRend(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lendsym")) {
-        this->SetLendsym(StrToLinestartendsymbol(element.attribute("lendsym").value()));
-        element.remove_attribute("lendsym");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lendsym"))) {
+        this->SetLendsym(StrToLinestartendsymbol(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lendsym.size")) {
-        this->SetLendsymSize(StrToInt(element.attribute("lendsym.size").value()));
-        element.remove_attribute("lendsym.size");
+    if ((attr = element.attribute("lendsym.size"))) {
+        this->SetLendsymSize(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lstartsym")) {
-        this->SetLstartsym(StrToLinestartendsymbol(element.attribute("lstartsym").value()));
-        element.remove_attribute("lstartsym");
+    if ((attr = element.attribute("lstartsym"))) {
+        this->SetLstartsym(StrToLinestartendsymbol(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lstartsym.size")) {
-        this->SetLstartsymSize(StrToInt(element.attribute("lstartsym.size").value()));
-        element.remove_attribute("lstartsym.size");
+    if ((attr = element.attribute("lstartsym.size"))) {
+        this->SetLstartsymSize(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2892,19 +2998,21 @@ void AttLineRendBase::ResetLineRendBase()
 bool AttLineRendBase::ReadLineRendBase(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lform")) {
-        this->SetLform(StrToLineform(element.attribute("lform").value()));
-        element.remove_attribute("lform");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lform"))) {
+        this->SetLform(StrToLineform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lsegs")) {
-        this->SetLsegs(StrToInt(element.attribute("lsegs").value()));
-        element.remove_attribute("lsegs");
+    if ((attr = element.attribute("lsegs"))) {
+        this->SetLsegs(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lwidth")) {
-        this->SetLwidth(StrToLinewidth(element.attribute("lwidth").value()));
-        element.remove_attribute("lwidth");
+    if ((attr = element.attribute("lwidth"))) {
+        this->SetLwidth(StrToLinewidth(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2973,44 +3081,46 @@ void AttLinking::ResetLinking()
 bool AttLinking::ReadLinking(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("copyof")) {
-        this->SetCopyof(StrToStr(element.attribute("copyof").value()));
-        element.remove_attribute("copyof");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("copyof"))) {
+        this->SetCopyof(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("corresp")) {
-        this->SetCorresp(StrToStr(element.attribute("corresp").value()));
-        element.remove_attribute("corresp");
+    if ((attr = element.attribute("corresp"))) {
+        this->SetCorresp(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("follows")) {
-        this->SetFollows(StrToStr(element.attribute("follows").value()));
-        element.remove_attribute("follows");
+    if ((attr = element.attribute("follows"))) {
+        this->SetFollows(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("next")) {
-        this->SetNext(StrToStr(element.attribute("next").value()));
-        element.remove_attribute("next");
+    if ((attr = element.attribute("next"))) {
+        this->SetNext(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("precedes")) {
-        this->SetPrecedes(StrToStr(element.attribute("precedes").value()));
-        element.remove_attribute("precedes");
+    if ((attr = element.attribute("precedes"))) {
+        this->SetPrecedes(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("prev")) {
-        this->SetPrev(StrToStr(element.attribute("prev").value()));
-        element.remove_attribute("prev");
+    if ((attr = element.attribute("prev"))) {
+        this->SetPrev(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("sameas")) {
-        this->SetSameas(StrToStr(element.attribute("sameas").value()));
-        element.remove_attribute("sameas");
+    if ((attr = element.attribute("sameas"))) {
+        this->SetSameas(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("synch")) {
-        this->SetSynch(StrToStr(element.attribute("synch").value()));
-        element.remove_attribute("synch");
+    if ((attr = element.attribute("synch"))) {
+        this->SetSynch(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3122,34 +3232,36 @@ void AttLyricStyle::ResetLyricStyle()
 bool AttLyricStyle::ReadLyricStyle(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lyric.align")) {
-        this->SetLyricAlign(StrToMeasurementrel(element.attribute("lyric.align").value()));
-        element.remove_attribute("lyric.align");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lyric.align"))) {
+        this->SetLyricAlign(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lyric.fam")) {
-        this->SetLyricFam(StrToStr(element.attribute("lyric.fam").value()));
-        element.remove_attribute("lyric.fam");
+    if ((attr = element.attribute("lyric.fam"))) {
+        this->SetLyricFam(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lyric.name")) {
-        this->SetLyricName(StrToStr(element.attribute("lyric.name").value()));
-        element.remove_attribute("lyric.name");
+    if ((attr = element.attribute("lyric.name"))) {
+        this->SetLyricName(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lyric.size")) {
-        this->SetLyricSize(StrToFontsize(element.attribute("lyric.size").value()));
-        element.remove_attribute("lyric.size");
+    if ((attr = element.attribute("lyric.size"))) {
+        this->SetLyricSize(StrToFontsize(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lyric.style")) {
-        this->SetLyricStyle(StrToFontstyle(element.attribute("lyric.style").value()));
-        element.remove_attribute("lyric.style");
+    if ((attr = element.attribute("lyric.style"))) {
+        this->SetLyricStyle(StrToFontstyle(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lyric.weight")) {
-        this->SetLyricWeight(StrToFontweight(element.attribute("lyric.weight").value()));
-        element.remove_attribute("lyric.weight");
+    if ((attr = element.attribute("lyric.weight"))) {
+        this->SetLyricWeight(StrToFontweight(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3238,9 +3350,11 @@ void AttMeasureNumbers::ResetMeasureNumbers()
 bool AttMeasureNumbers::ReadMeasureNumbers(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("mnum.visible")) {
-        this->SetMnumVisible(StrToBoolean(element.attribute("mnum.visible").value()));
-        element.remove_attribute("mnum.visible");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("mnum.visible"))) {
+        this->SetMnumVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3284,9 +3398,11 @@ void AttMeasurement::ResetMeasurement()
 bool AttMeasurement::ReadMeasurement(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("unit")) {
-        this->SetUnit(StrToStr(element.attribute("unit").value()));
-        element.remove_attribute("unit");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("unit"))) {
+        this->SetUnit(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3332,19 +3448,21 @@ void AttMediaBounds::ResetMediaBounds()
 bool AttMediaBounds::ReadMediaBounds(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("begin")) {
-        this->SetBegin(StrToStr(element.attribute("begin").value()));
-        element.remove_attribute("begin");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("begin"))) {
+        this->SetBegin(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("end")) {
-        this->SetEnd(StrToStr(element.attribute("end").value()));
-        element.remove_attribute("end");
+    if ((attr = element.attribute("end"))) {
+        this->SetEnd(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("betype")) {
-        this->SetBetype(StrToBetype(element.attribute("betype").value()));
-        element.remove_attribute("betype");
+    if ((attr = element.attribute("betype"))) {
+        this->SetBetype(StrToBetype(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3406,9 +3524,11 @@ void AttMedium::ResetMedium()
 bool AttMedium::ReadMedium(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("medium")) {
-        this->SetMedium(StrToStr(element.attribute("medium").value()));
-        element.remove_attribute("medium");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("medium"))) {
+        this->SetMedium(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3452,9 +3572,11 @@ void AttMeiVersion::ResetMeiVersion()
 bool AttMeiVersion::ReadMeiVersion(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("meiversion")) {
-        this->SetMeiversion(StrToMeiVersionMeiversion(element.attribute("meiversion").value()));
-        element.remove_attribute("meiversion");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("meiversion"))) {
+        this->SetMeiversion(StrToMeiVersionMeiversion(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3498,9 +3620,11 @@ void AttMetadataPointing::ResetMetadataPointing()
 bool AttMetadataPointing::ReadMetadataPointing(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("decls")) {
-        this->SetDecls(StrToStr(element.attribute("decls").value()));
-        element.remove_attribute("decls");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("decls"))) {
+        this->SetDecls(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3544,9 +3668,11 @@ void AttMeterConformance::ResetMeterConformance()
 bool AttMeterConformance::ReadMeterConformance(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("metcon")) {
-        this->SetMetcon(StrToMeterConformanceMetcon(element.attribute("metcon").value()));
-        element.remove_attribute("metcon");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("metcon"))) {
+        this->SetMetcon(StrToMeterConformanceMetcon(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3591,14 +3717,16 @@ void AttMeterConformanceBar::ResetMeterConformanceBar()
 bool AttMeterConformanceBar::ReadMeterConformanceBar(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("metcon")) {
-        this->SetMetcon(StrToBoolean(element.attribute("metcon").value()));
-        element.remove_attribute("metcon");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("metcon"))) {
+        this->SetMetcon(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("control")) {
-        this->SetControl(StrToBoolean(element.attribute("control").value()));
-        element.remove_attribute("control");
+    if ((attr = element.attribute("control"))) {
+        this->SetControl(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3653,19 +3781,21 @@ void AttMeterSigLog::ResetMeterSigLog()
 bool AttMeterSigLog::ReadMeterSigLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("count")) {
-        this->SetCount(StrToSummandList(element.attribute("count").value()));
-        element.remove_attribute("count");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("count"))) {
+        this->SetCount(StrToSummandList(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("sym")) {
-        this->SetSym(StrToMetersign(element.attribute("sym").value()));
-        element.remove_attribute("sym");
+    if ((attr = element.attribute("sym"))) {
+        this->SetSym(StrToMetersign(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("unit")) {
-        this->SetUnit(StrToInt(element.attribute("unit").value()));
-        element.remove_attribute("unit");
+    if ((attr = element.attribute("unit"))) {
+        this->SetUnit(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3729,19 +3859,21 @@ void AttMeterSigDefaultLog::ResetMeterSigDefaultLog()
 bool AttMeterSigDefaultLog::ReadMeterSigDefaultLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("meter.count")) {
-        this->SetMeterCount(StrToSummandList(element.attribute("meter.count").value()));
-        element.remove_attribute("meter.count");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("meter.count"))) {
+        this->SetMeterCount(StrToSummandList(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("meter.unit")) {
-        this->SetMeterUnit(StrToInt(element.attribute("meter.unit").value()));
-        element.remove_attribute("meter.unit");
+    if ((attr = element.attribute("meter.unit"))) {
+        this->SetMeterUnit(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("meter.sym")) {
-        this->SetMeterSym(StrToMetersign(element.attribute("meter.sym").value()));
-        element.remove_attribute("meter.sym");
+    if ((attr = element.attribute("meter.sym"))) {
+        this->SetMeterSym(StrToMetersign(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3805,19 +3937,21 @@ void AttMmTempo::ResetMmTempo()
 bool AttMmTempo::ReadMmTempo(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("mm")) {
-        this->SetMm(StrToDbl(element.attribute("mm").value()));
-        element.remove_attribute("mm");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("mm"))) {
+        this->SetMm(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mm.unit")) {
-        this->SetMmUnit(StrToDuration(element.attribute("mm.unit").value()));
-        element.remove_attribute("mm.unit");
+    if ((attr = element.attribute("mm.unit"))) {
+        this->SetMmUnit(StrToDuration(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mm.dots")) {
-        this->SetMmDots(StrToInt(element.attribute("mm.dots").value()));
-        element.remove_attribute("mm.dots");
+    if ((attr = element.attribute("mm.dots"))) {
+        this->SetMmDots(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3879,9 +4013,11 @@ void AttMultinumMeasures::ResetMultinumMeasures()
 bool AttMultinumMeasures::ReadMultinumMeasures(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("multi.number")) {
-        this->SetMultiNumber(StrToBoolean(element.attribute("multi.number").value()));
-        element.remove_attribute("multi.number");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("multi.number"))) {
+        this->SetMultiNumber(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3925,9 +4061,11 @@ void AttNInteger::ResetNInteger()
 bool AttNInteger::ReadNInteger(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("n")) {
-        this->SetN(StrToInt(element.attribute("n").value()));
-        element.remove_attribute("n");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("n"))) {
+        this->SetN(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -3971,9 +4109,11 @@ void AttNNumberLike::ResetNNumberLike()
 bool AttNNumberLike::ReadNNumberLike(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("n")) {
-        this->SetN(StrToStr(element.attribute("n").value()));
-        element.remove_attribute("n");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("n"))) {
+        this->SetN(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4018,14 +4158,16 @@ void AttName::ResetName()
 bool AttName::ReadName(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("nymref")) {
-        this->SetNymref(StrToStr(element.attribute("nymref").value()));
-        element.remove_attribute("nymref");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("nymref"))) {
+        this->SetNymref(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("role")) {
-        this->SetRole(StrToStr(element.attribute("role").value()));
-        element.remove_attribute("role");
+    if ((attr = element.attribute("role"))) {
+        this->SetRole(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4079,14 +4221,16 @@ void AttNotationStyle::ResetNotationStyle()
 bool AttNotationStyle::ReadNotationStyle(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("music.name")) {
-        this->SetMusicName(StrToStr(element.attribute("music.name").value()));
-        element.remove_attribute("music.name");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("music.name"))) {
+        this->SetMusicName(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("music.size")) {
-        this->SetMusicSize(StrToFontsize(element.attribute("music.size").value()));
-        element.remove_attribute("music.size");
+    if ((attr = element.attribute("music.size"))) {
+        this->SetMusicSize(StrToFontsize(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4147,49 +4291,51 @@ void AttNoteHeads::ResetNoteHeads()
 bool AttNoteHeads::ReadNoteHeads(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("head.altsym")) {
-        this->SetHeadAltsym(StrToStr(element.attribute("head.altsym").value()));
-        element.remove_attribute("head.altsym");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("head.altsym"))) {
+        this->SetHeadAltsym(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.auth")) {
-        this->SetHeadAuth(StrToStr(element.attribute("head.auth").value()));
-        element.remove_attribute("head.auth");
+    if ((attr = element.attribute("head.auth"))) {
+        this->SetHeadAuth(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.color")) {
-        this->SetHeadColor(StrToStr(element.attribute("head.color").value()));
-        element.remove_attribute("head.color");
+    if ((attr = element.attribute("head.color"))) {
+        this->SetHeadColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.fill")) {
-        this->SetHeadFill(StrToFill(element.attribute("head.fill").value()));
-        element.remove_attribute("head.fill");
+    if ((attr = element.attribute("head.fill"))) {
+        this->SetHeadFill(StrToFill(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.fillcolor")) {
-        this->SetHeadFillcolor(StrToStr(element.attribute("head.fillcolor").value()));
-        element.remove_attribute("head.fillcolor");
+    if ((attr = element.attribute("head.fillcolor"))) {
+        this->SetHeadFillcolor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.mod")) {
-        this->SetHeadMod(StrToNoteheadmodifier(element.attribute("head.mod").value()));
-        element.remove_attribute("head.mod");
+    if ((attr = element.attribute("head.mod"))) {
+        this->SetHeadMod(StrToNoteheadmodifier(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.rotation")) {
-        this->SetHeadRotation(StrToRotation(element.attribute("head.rotation").value()));
-        element.remove_attribute("head.rotation");
+    if ((attr = element.attribute("head.rotation"))) {
+        this->SetHeadRotation(StrToRotation(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.shape")) {
-        this->SetHeadShape(StrToHeadshape(element.attribute("head.shape").value()));
-        element.remove_attribute("head.shape");
+    if ((attr = element.attribute("head.shape"))) {
+        this->SetHeadShape(StrToHeadshape(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("head.visible")) {
-        this->SetHeadVisible(StrToBoolean(element.attribute("head.visible").value()));
-        element.remove_attribute("head.visible");
+    if ((attr = element.attribute("head.visible"))) {
+        this->SetHeadVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4305,9 +4451,11 @@ void AttOctave::ResetOctave()
 bool AttOctave::ReadOctave(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("oct")) {
-        this->SetOct(StrToOctave(element.attribute("oct").value()));
-        element.remove_attribute("oct");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("oct"))) {
+        this->SetOct(StrToOctave(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4351,9 +4499,11 @@ void AttOctaveDefault::ResetOctaveDefault()
 bool AttOctaveDefault::ReadOctaveDefault(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("oct.default")) {
-        this->SetOctDefault(StrToOctave(element.attribute("oct.default").value()));
-        element.remove_attribute("oct.default");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("oct.default"))) {
+        this->SetOctDefault(StrToOctave(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4398,14 +4548,16 @@ void AttOctaveDisplacement::ResetOctaveDisplacement()
 bool AttOctaveDisplacement::ReadOctaveDisplacement(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dis")) {
-        this->SetDis(StrToOctaveDis(element.attribute("dis").value()));
-        element.remove_attribute("dis");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dis"))) {
+        this->SetDis(StrToOctaveDis(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dis.place")) {
-        this->SetDisPlace(StrToStaffrelBasic(element.attribute("dis.place").value()));
-        element.remove_attribute("dis.place");
+    if ((attr = element.attribute("dis.place"))) {
+        this->SetDisPlace(StrToStaffrelBasic(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4458,9 +4610,11 @@ void AttOneLineStaff::ResetOneLineStaff()
 bool AttOneLineStaff::ReadOneLineStaff(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ontheline")) {
-        this->SetOntheline(StrToBoolean(element.attribute("ontheline").value()));
-        element.remove_attribute("ontheline");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ontheline"))) {
+        this->SetOntheline(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4504,9 +4658,11 @@ void AttOptimization::ResetOptimization()
 bool AttOptimization::ReadOptimization(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("optimize")) {
-        this->SetOptimize(StrToBoolean(element.attribute("optimize").value()));
-        element.remove_attribute("optimize");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("optimize"))) {
+        this->SetOptimize(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4550,9 +4706,11 @@ void AttOriginLayerIdent::ResetOriginLayerIdent()
 bool AttOriginLayerIdent::ReadOriginLayerIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("origin.layer")) {
-        this->SetOriginLayer(StrToStr(element.attribute("origin.layer").value()));
-        element.remove_attribute("origin.layer");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("origin.layer"))) {
+        this->SetOriginLayer(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4596,9 +4754,11 @@ void AttOriginStaffIdent::ResetOriginStaffIdent()
 bool AttOriginStaffIdent::ReadOriginStaffIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("origin.staff")) {
-        this->SetOriginStaff(StrToStr(element.attribute("origin.staff").value()));
-        element.remove_attribute("origin.staff");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("origin.staff"))) {
+        this->SetOriginStaff(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4643,14 +4803,16 @@ void AttOriginStartEndId::ResetOriginStartEndId()
 bool AttOriginStartEndId::ReadOriginStartEndId(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("origin.startid")) {
-        this->SetOriginStartid(StrToStr(element.attribute("origin.startid").value()));
-        element.remove_attribute("origin.startid");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("origin.startid"))) {
+        this->SetOriginStartid(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("origin.endid")) {
-        this->SetOriginEndid(StrToStr(element.attribute("origin.endid").value()));
-        element.remove_attribute("origin.endid");
+    if ((attr = element.attribute("origin.endid"))) {
+        this->SetOriginEndid(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4704,14 +4866,16 @@ void AttOriginTimestampLogical::ResetOriginTimestampLogical()
 bool AttOriginTimestampLogical::ReadOriginTimestampLogical(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("origin.tstamp")) {
-        this->SetOriginTstamp(StrToMeasurebeat(element.attribute("origin.tstamp").value()));
-        element.remove_attribute("origin.tstamp");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("origin.tstamp"))) {
+        this->SetOriginTstamp(StrToMeasurebeat(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("origin.tstamp2")) {
-        this->SetOriginTstamp2(StrToMeasurebeat(element.attribute("origin.tstamp2").value()));
-        element.remove_attribute("origin.tstamp2");
+    if ((attr = element.attribute("origin.tstamp2"))) {
+        this->SetOriginTstamp2(StrToMeasurebeat(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4771,44 +4935,46 @@ void AttPages::ResetPages()
 bool AttPages::ReadPages(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("page.height")) {
-        this->SetPageHeight(StrToMeasurementabs(element.attribute("page.height").value()));
-        element.remove_attribute("page.height");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("page.height"))) {
+        this->SetPageHeight(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.width")) {
-        this->SetPageWidth(StrToMeasurementabs(element.attribute("page.width").value()));
-        element.remove_attribute("page.width");
+    if ((attr = element.attribute("page.width"))) {
+        this->SetPageWidth(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.topmar")) {
-        this->SetPageTopmar(StrToMeasurementabs(element.attribute("page.topmar").value()));
-        element.remove_attribute("page.topmar");
+    if ((attr = element.attribute("page.topmar"))) {
+        this->SetPageTopmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.botmar")) {
-        this->SetPageBotmar(StrToMeasurementabs(element.attribute("page.botmar").value()));
-        element.remove_attribute("page.botmar");
+    if ((attr = element.attribute("page.botmar"))) {
+        this->SetPageBotmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.leftmar")) {
-        this->SetPageLeftmar(StrToMeasurementabs(element.attribute("page.leftmar").value()));
-        element.remove_attribute("page.leftmar");
+    if ((attr = element.attribute("page.leftmar"))) {
+        this->SetPageLeftmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.rightmar")) {
-        this->SetPageRightmar(StrToMeasurementabs(element.attribute("page.rightmar").value()));
-        element.remove_attribute("page.rightmar");
+    if ((attr = element.attribute("page.rightmar"))) {
+        this->SetPageRightmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.panels")) {
-        this->SetPagePanels(StrToStr(element.attribute("page.panels").value()));
-        element.remove_attribute("page.panels");
+    if ((attr = element.attribute("page.panels"))) {
+        this->SetPagePanels(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("page.scale")) {
-        this->SetPageScale(StrToStr(element.attribute("page.scale").value()));
-        element.remove_attribute("page.scale");
+    if ((attr = element.attribute("page.scale"))) {
+        this->SetPageScale(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4916,14 +5082,16 @@ void AttPartIdent::ResetPartIdent()
 bool AttPartIdent::ReadPartIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("part")) {
-        this->SetPart(StrToStr(element.attribute("part").value()));
-        element.remove_attribute("part");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("part"))) {
+        this->SetPart(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("partstaff")) {
-        this->SetPartstaff(StrToStr(element.attribute("partstaff").value()));
-        element.remove_attribute("partstaff");
+    if ((attr = element.attribute("partstaff"))) {
+        this->SetPartstaff(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -4976,9 +5144,11 @@ void AttPitch::ResetPitch()
 bool AttPitch::ReadPitch(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("pname")) {
-        this->SetPname(StrToPitchname(element.attribute("pname").value()));
-        element.remove_attribute("pname");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("pname"))) {
+        this->SetPname(StrToPitchname(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5022,9 +5192,11 @@ void AttPlacementOnStaff::ResetPlacementOnStaff()
 bool AttPlacementOnStaff::ReadPlacementOnStaff(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("onstaff")) {
-        this->SetOnstaff(StrToBoolean(element.attribute("onstaff").value()));
-        element.remove_attribute("onstaff");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("onstaff"))) {
+        this->SetOnstaff(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5068,9 +5240,11 @@ void AttPlacementRelEvent::ResetPlacementRelEvent()
 bool AttPlacementRelEvent::ReadPlacementRelEvent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("place")) {
-        this->SetPlace(StrToStaffrel(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToStaffrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5114,9 +5288,11 @@ void AttPlacementRelStaff::ResetPlacementRelStaff()
 bool AttPlacementRelStaff::ReadPlacementRelStaff(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("place")) {
-        this->SetPlace(StrToStaffrel(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToStaffrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5160,9 +5336,11 @@ void AttPlist::ResetPlist()
 bool AttPlist::ReadPlist(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("plist")) {
-        this->SetPlist(StrToXsdAnyURIList(element.attribute("plist").value()));
-        element.remove_attribute("plist");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("plist"))) {
+        this->SetPlist(StrToXsdAnyURIList(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5210,29 +5388,31 @@ void AttPointing::ResetPointing()
 bool AttPointing::ReadPointing(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("xlink:actuate")) {
-        this->SetActuate(StrToStr(element.attribute("xlink:actuate").value()));
-        element.remove_attribute("xlink:actuate");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("xlink:actuate"))) {
+        this->SetActuate(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("xlink:role")) {
-        this->SetRole(StrToStr(element.attribute("xlink:role").value()));
-        element.remove_attribute("xlink:role");
+    if ((attr = element.attribute("xlink:role"))) {
+        this->SetRole(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("xlink:show")) {
-        this->SetShow(StrToStr(element.attribute("xlink:show").value()));
-        element.remove_attribute("xlink:show");
+    if ((attr = element.attribute("xlink:show"))) {
+        this->SetShow(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("xlink:target")) {
-        this->SetTarget(StrToStr(element.attribute("xlink:target").value()));
-        element.remove_attribute("xlink:target");
+    if ((attr = element.attribute("xlink:target"))) {
+        this->SetTarget(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("xlink:targettype")) {
-        this->SetTargettype(StrToStr(element.attribute("xlink:targettype").value()));
-        element.remove_attribute("xlink:targettype");
+    if ((attr = element.attribute("xlink:targettype"))) {
+        this->SetTargettype(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5312,9 +5492,11 @@ void AttQuantity::ResetQuantity()
 bool AttQuantity::ReadQuantity(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("quantity")) {
-        this->SetQuantity(StrToDbl(element.attribute("quantity").value()));
-        element.remove_attribute("quantity");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("quantity"))) {
+        this->SetQuantity(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5362,29 +5544,31 @@ void AttRanging::ResetRanging()
 bool AttRanging::ReadRanging(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("atleast")) {
-        this->SetAtleast(StrToDbl(element.attribute("atleast").value()));
-        element.remove_attribute("atleast");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("atleast"))) {
+        this->SetAtleast(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("atmost")) {
-        this->SetAtmost(StrToDbl(element.attribute("atmost").value()));
-        element.remove_attribute("atmost");
+    if ((attr = element.attribute("atmost"))) {
+        this->SetAtmost(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("min")) {
-        this->SetMin(StrToDbl(element.attribute("min").value()));
-        element.remove_attribute("min");
+    if ((attr = element.attribute("min"))) {
+        this->SetMin(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("max")) {
-        this->SetMax(StrToDbl(element.attribute("max").value()));
-        element.remove_attribute("max");
+    if ((attr = element.attribute("max"))) {
+        this->SetMax(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("confidence")) {
-        this->SetConfidence(StrToDbl(element.attribute("confidence").value()));
-        element.remove_attribute("confidence");
+    if ((attr = element.attribute("confidence"))) {
+        this->SetConfidence(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5464,9 +5648,11 @@ void AttResponsibility::ResetResponsibility()
 bool AttResponsibility::ReadResponsibility(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("resp")) {
-        this->SetResp(StrToStr(element.attribute("resp").value()));
-        element.remove_attribute("resp");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("resp"))) {
+        this->SetResp(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5510,9 +5696,11 @@ void AttRestdurationLogical::ResetRestdurationLogical()
 bool AttRestdurationLogical::ReadRestdurationLogical(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dur")) {
-        this->SetDur(StrToDurationrests(element.attribute("dur").value()));
-        element.remove_attribute("dur");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dur"))) {
+        this->SetDur(StrToDurationrests(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5556,9 +5744,11 @@ void AttScalable::ResetScalable()
 bool AttScalable::ReadScalable(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("scale")) {
-        this->SetScale(StrToPercent(element.attribute("scale").value()));
-        element.remove_attribute("scale");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("scale"))) {
+        this->SetScale(StrToPercent(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5602,9 +5792,11 @@ void AttSequence::ResetSequence()
 bool AttSequence::ReadSequence(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("seq")) {
-        this->SetSeq(StrToInt(element.attribute("seq").value()));
-        element.remove_attribute("seq");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("seq"))) {
+        this->SetSeq(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5648,9 +5840,11 @@ void AttSlashCount::ResetSlashCount()
 bool AttSlashCount::ReadSlashCount(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("slash")) {
-        this->SetSlash(StrToInt(element.attribute("slash").value()));
-        element.remove_attribute("slash");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("slash"))) {
+        this->SetSlash(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5694,9 +5888,11 @@ void AttSlurPresent::ResetSlurPresent()
 bool AttSlurPresent::ReadSlurPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("slur")) {
-        this->SetSlur(StrToStr(element.attribute("slur").value()));
-        element.remove_attribute("slur");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("slur"))) {
+        this->SetSlur(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5740,9 +5936,11 @@ void AttSource::ResetSource()
 bool AttSource::ReadSource(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("source")) {
-        this->SetSource(StrToStr(element.attribute("source").value()));
-        element.remove_attribute("source");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("source"))) {
+        this->SetSource(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5789,24 +5987,26 @@ void AttSpacing::ResetSpacing()
 bool AttSpacing::ReadSpacing(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("spacing.packexp")) {
-        this->SetSpacingPackexp(StrToDbl(element.attribute("spacing.packexp").value()));
-        element.remove_attribute("spacing.packexp");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("spacing.packexp"))) {
+        this->SetSpacingPackexp(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("spacing.packfact")) {
-        this->SetSpacingPackfact(StrToDbl(element.attribute("spacing.packfact").value()));
-        element.remove_attribute("spacing.packfact");
+    if ((attr = element.attribute("spacing.packfact"))) {
+        this->SetSpacingPackfact(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("spacing.staff")) {
-        this->SetSpacingStaff(StrToMeasurementrel(element.attribute("spacing.staff").value()));
-        element.remove_attribute("spacing.staff");
+    if ((attr = element.attribute("spacing.staff"))) {
+        this->SetSpacingStaff(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("spacing.system")) {
-        this->SetSpacingSystem(StrToMeasurementrel(element.attribute("spacing.system").value()));
-        element.remove_attribute("spacing.system");
+    if ((attr = element.attribute("spacing.system"))) {
+        this->SetSpacingSystem(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5877,9 +6077,11 @@ void AttStaffLog::ResetStaffLog()
 bool AttStaffLog::ReadStaffLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("def")) {
-        this->SetDef(StrToStr(element.attribute("def").value()));
-        element.remove_attribute("def");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("def"))) {
+        this->SetDef(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5923,9 +6125,11 @@ void AttStaffDefLog::ResetStaffDefLog()
 bool AttStaffDefLog::ReadStaffDefLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("lines")) {
-        this->SetLines(StrToInt(element.attribute("lines").value()));
-        element.remove_attribute("lines");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("lines"))) {
+        this->SetLines(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -5969,9 +6173,11 @@ void AttStaffGroupingSym::ResetStaffGroupingSym()
 bool AttStaffGroupingSym::ReadStaffGroupingSym(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("symbol")) {
-        this->SetSymbol(StrToStaffGroupingSymSymbol(element.attribute("symbol").value()));
-        element.remove_attribute("symbol");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("symbol"))) {
+        this->SetSymbol(StrToStaffGroupingSymSymbol(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6015,9 +6221,11 @@ void AttStaffIdent::ResetStaffIdent()
 bool AttStaffIdent::ReadStaffIdent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("staff")) {
-        this->SetStaff(StrToXsdPositiveIntegerList(element.attribute("staff").value()));
-        element.remove_attribute("staff");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("staff"))) {
+        this->SetStaff(StrToXsdPositiveIntegerList(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6063,19 +6271,21 @@ void AttStaffItems::ResetStaffItems()
 bool AttStaffItems::ReadStaffItems(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("aboveorder")) {
-        this->SetAboveorder(StrToStaffitem(element.attribute("aboveorder").value()));
-        element.remove_attribute("aboveorder");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("aboveorder"))) {
+        this->SetAboveorder(StrToStaffitem(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("beloworder")) {
-        this->SetBeloworder(StrToStaffitem(element.attribute("beloworder").value()));
-        element.remove_attribute("beloworder");
+    if ((attr = element.attribute("beloworder"))) {
+        this->SetBeloworder(StrToStaffitem(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("betweenorder")) {
-        this->SetBetweenorder(StrToStaffitem(element.attribute("betweenorder").value()));
-        element.remove_attribute("betweenorder");
+    if ((attr = element.attribute("betweenorder"))) {
+        this->SetBetweenorder(StrToStaffitem(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6137,9 +6347,11 @@ void AttStaffLoc::ResetStaffLoc()
 bool AttStaffLoc::ReadStaffLoc(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("loc")) {
-        this->SetLoc(StrToInt(element.attribute("loc").value()));
-        element.remove_attribute("loc");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("loc"))) {
+        this->SetLoc(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6184,14 +6396,16 @@ void AttStaffLocPitched::ResetStaffLocPitched()
 bool AttStaffLocPitched::ReadStaffLocPitched(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ploc")) {
-        this->SetPloc(StrToPitchname(element.attribute("ploc").value()));
-        element.remove_attribute("ploc");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ploc"))) {
+        this->SetPloc(StrToPitchname(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("oloc")) {
-        this->SetOloc(StrToOctave(element.attribute("oloc").value()));
-        element.remove_attribute("oloc");
+    if ((attr = element.attribute("oloc"))) {
+        this->SetOloc(StrToOctave(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6244,9 +6458,11 @@ void AttStartEndId::ResetStartEndId()
 bool AttStartEndId::ReadStartEndId(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("endid")) {
-        this->SetEndid(StrToStr(element.attribute("endid").value()));
-        element.remove_attribute("endid");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("endid"))) {
+        this->SetEndid(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6290,9 +6506,11 @@ void AttStartId::ResetStartId()
 bool AttStartId::ReadStartId(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("startid")) {
-        this->SetStartid(StrToStr(element.attribute("startid").value()));
-        element.remove_attribute("startid");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("startid"))) {
+        this->SetStartid(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6343,44 +6561,46 @@ void AttStems::ResetStems()
 bool AttStems::ReadStems(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("stem.dir")) {
-        this->SetStemDir(StrToStemdirection(element.attribute("stem.dir").value()));
-        element.remove_attribute("stem.dir");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("stem.dir"))) {
+        this->SetStemDir(StrToStemdirection(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.len")) {
-        this->SetStemLen(StrToDbl(element.attribute("stem.len").value()));
-        element.remove_attribute("stem.len");
+    if ((attr = element.attribute("stem.len"))) {
+        this->SetStemLen(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.mod")) {
-        this->SetStemMod(StrToStemmodifier(element.attribute("stem.mod").value()));
-        element.remove_attribute("stem.mod");
+    if ((attr = element.attribute("stem.mod"))) {
+        this->SetStemMod(StrToStemmodifier(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.pos")) {
-        this->SetStemPos(StrToStemposition(element.attribute("stem.pos").value()));
-        element.remove_attribute("stem.pos");
+    if ((attr = element.attribute("stem.pos"))) {
+        this->SetStemPos(StrToStemposition(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.sameas")) {
-        this->SetStemSameas(StrToStr(element.attribute("stem.sameas").value()));
-        element.remove_attribute("stem.sameas");
+    if ((attr = element.attribute("stem.sameas"))) {
+        this->SetStemSameas(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.visible")) {
-        this->SetStemVisible(StrToBoolean(element.attribute("stem.visible").value()));
-        element.remove_attribute("stem.visible");
+    if ((attr = element.attribute("stem.visible"))) {
+        this->SetStemVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.x")) {
-        this->SetStemX(StrToDbl(element.attribute("stem.x").value()));
-        element.remove_attribute("stem.x");
+    if ((attr = element.attribute("stem.x"))) {
+        this->SetStemX(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("stem.y")) {
-        this->SetStemY(StrToDbl(element.attribute("stem.y").value()));
-        element.remove_attribute("stem.y");
+    if ((attr = element.attribute("stem.y"))) {
+        this->SetStemY(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6488,14 +6708,16 @@ void AttSylLog::ResetSylLog()
 bool AttSylLog::ReadSylLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("con")) {
-        this->SetCon(StrToSylLogCon(element.attribute("con").value()));
-        element.remove_attribute("con");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("con"))) {
+        this->SetCon(StrToSylLogCon(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("wordpos")) {
-        this->SetWordpos(StrToSylLogWordpos(element.attribute("wordpos").value()));
-        element.remove_attribute("wordpos");
+    if ((attr = element.attribute("wordpos"))) {
+        this->SetWordpos(StrToSylLogWordpos(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6548,9 +6770,11 @@ void AttSylText::ResetSylText()
 bool AttSylText::ReadSylText(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("syl")) {
-        this->SetSyl(StrToStr(element.attribute("syl").value()));
-        element.remove_attribute("syl");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("syl"))) {
+        this->SetSyl(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6597,24 +6821,26 @@ void AttSystems::ResetSystems()
 bool AttSystems::ReadSystems(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("system.leftline")) {
-        this->SetSystemLeftline(StrToBoolean(element.attribute("system.leftline").value()));
-        element.remove_attribute("system.leftline");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("system.leftline"))) {
+        this->SetSystemLeftline(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("system.leftmar")) {
-        this->SetSystemLeftmar(StrToMeasurementabs(element.attribute("system.leftmar").value()));
-        element.remove_attribute("system.leftmar");
+    if ((attr = element.attribute("system.leftmar"))) {
+        this->SetSystemLeftmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("system.rightmar")) {
-        this->SetSystemRightmar(StrToMeasurementabs(element.attribute("system.rightmar").value()));
-        element.remove_attribute("system.rightmar");
+    if ((attr = element.attribute("system.rightmar"))) {
+        this->SetSystemRightmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("system.topmar")) {
-        this->SetSystemTopmar(StrToMeasurementabs(element.attribute("system.topmar").value()));
-        element.remove_attribute("system.topmar");
+    if ((attr = element.attribute("system.topmar"))) {
+        this->SetSystemTopmar(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6685,9 +6911,11 @@ void AttTargetEval::ResetTargetEval()
 bool AttTargetEval::ReadTargetEval(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("evaluate")) {
-        this->SetEvaluate(StrToTargetEvalEvaluate(element.attribute("evaluate").value()));
-        element.remove_attribute("evaluate");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("evaluate"))) {
+        this->SetEvaluate(StrToTargetEvalEvaluate(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6731,9 +6959,11 @@ void AttTempoLog::ResetTempoLog()
 bool AttTempoLog::ReadTempoLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToTempoLogFunc(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToTempoLogFunc(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6778,14 +7008,16 @@ void AttTextRendition::ResetTextRendition()
 bool AttTextRendition::ReadTextRendition(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("altrend")) {
-        this->SetAltrend(StrToStr(element.attribute("altrend").value()));
-        element.remove_attribute("altrend");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("altrend"))) {
+        this->SetAltrend(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("rend")) {
-        this->SetRend(StrToTextrendition(element.attribute("rend").value()));
-        element.remove_attribute("rend");
+    if ((attr = element.attribute("rend"))) {
+        this->SetRend(StrToTextrendition(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6842,29 +7074,31 @@ void AttTextStyle::ResetTextStyle()
 bool AttTextStyle::ReadTextStyle(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("text.fam")) {
-        this->SetTextFam(StrToStr(element.attribute("text.fam").value()));
-        element.remove_attribute("text.fam");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("text.fam"))) {
+        this->SetTextFam(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("text.name")) {
-        this->SetTextName(StrToStr(element.attribute("text.name").value()));
-        element.remove_attribute("text.name");
+    if ((attr = element.attribute("text.name"))) {
+        this->SetTextName(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("text.size")) {
-        this->SetTextSize(StrToFontsize(element.attribute("text.size").value()));
-        element.remove_attribute("text.size");
+    if ((attr = element.attribute("text.size"))) {
+        this->SetTextSize(StrToFontsize(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("text.style")) {
-        this->SetTextStyle(StrToFontstyle(element.attribute("text.style").value()));
-        element.remove_attribute("text.style");
+    if ((attr = element.attribute("text.style"))) {
+        this->SetTextStyle(StrToFontstyle(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("text.weight")) {
-        this->SetTextWeight(StrToFontweight(element.attribute("text.weight").value()));
-        element.remove_attribute("text.weight");
+    if ((attr = element.attribute("text.weight"))) {
+        this->SetTextWeight(StrToFontweight(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6944,9 +7178,11 @@ void AttTiePresent::ResetTiePresent()
 bool AttTiePresent::ReadTiePresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tie")) {
-        this->SetTie(StrToTie(element.attribute("tie").value()));
-        element.remove_attribute("tie");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tie"))) {
+        this->SetTie(StrToTie(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -6990,9 +7226,11 @@ void AttTimestampLogical::ResetTimestampLogical()
 bool AttTimestampLogical::ReadTimestampLogical(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tstamp")) {
-        this->SetTstamp(StrToDbl(element.attribute("tstamp").value()));
-        element.remove_attribute("tstamp");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tstamp"))) {
+        this->SetTstamp(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7036,9 +7274,11 @@ void AttTimestamp2Logical::ResetTimestamp2Logical()
 bool AttTimestamp2Logical::ReadTimestamp2Logical(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tstamp2")) {
-        this->SetTstamp2(StrToMeasurebeat(element.attribute("tstamp2").value()));
-        element.remove_attribute("tstamp2");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tstamp2"))) {
+        this->SetTstamp2(StrToMeasurebeat(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7083,14 +7323,16 @@ void AttTransposition::ResetTransposition()
 bool AttTransposition::ReadTransposition(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("trans.diat")) {
-        this->SetTransDiat(StrToDbl(element.attribute("trans.diat").value()));
-        element.remove_attribute("trans.diat");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("trans.diat"))) {
+        this->SetTransDiat(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("trans.semi")) {
-        this->SetTransSemi(StrToDbl(element.attribute("trans.semi").value()));
-        element.remove_attribute("trans.semi");
+    if ((attr = element.attribute("trans.semi"))) {
+        this->SetTransSemi(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7143,9 +7385,11 @@ void AttTupletPresent::ResetTupletPresent()
 bool AttTupletPresent::ReadTupletPresent(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("tuplet")) {
-        this->SetTuplet(StrToStr(element.attribute("tuplet").value()));
-        element.remove_attribute("tuplet");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("tuplet"))) {
+        this->SetTuplet(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7189,9 +7433,11 @@ void AttTyped::ResetTyped()
 bool AttTyped::ReadTyped(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("type")) {
-        this->SetType(StrToStr(element.attribute("type").value()));
-        element.remove_attribute("type");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("type"))) {
+        this->SetType(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7239,29 +7485,31 @@ void AttTypography::ResetTypography()
 bool AttTypography::ReadTypography(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("fontfam")) {
-        this->SetFontfam(StrToStr(element.attribute("fontfam").value()));
-        element.remove_attribute("fontfam");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("fontfam"))) {
+        this->SetFontfam(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("fontname")) {
-        this->SetFontname(StrToStr(element.attribute("fontname").value()));
-        element.remove_attribute("fontname");
+    if ((attr = element.attribute("fontname"))) {
+        this->SetFontname(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("fontsize")) {
-        this->SetFontsize(StrToFontsize(element.attribute("fontsize").value()));
-        element.remove_attribute("fontsize");
+    if ((attr = element.attribute("fontsize"))) {
+        this->SetFontsize(StrToFontsize(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("fontstyle")) {
-        this->SetFontstyle(StrToFontstyle(element.attribute("fontstyle").value()));
-        element.remove_attribute("fontstyle");
+    if ((attr = element.attribute("fontstyle"))) {
+        this->SetFontstyle(StrToFontstyle(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("fontweight")) {
-        this->SetFontweight(StrToFontweight(element.attribute("fontweight").value()));
-        element.remove_attribute("fontweight");
+    if ((attr = element.attribute("fontweight"))) {
+        this->SetFontweight(StrToFontweight(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7341,9 +7589,11 @@ void AttVerticalAlign::ResetVerticalAlign()
 bool AttVerticalAlign::ReadVerticalAlign(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("valign")) {
-        this->SetValign(StrToVerticalalignment(element.attribute("valign").value()));
-        element.remove_attribute("valign");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("valign"))) {
+        this->SetValign(StrToVerticalalignment(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7387,9 +7637,11 @@ void AttVerticalGroup::ResetVerticalGroup()
 bool AttVerticalGroup::ReadVerticalGroup(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("vgrp")) {
-        this->SetVgrp(StrToInt(element.attribute("vgrp").value()));
-        element.remove_attribute("vgrp");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("vgrp"))) {
+        this->SetVgrp(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7433,9 +7685,11 @@ void AttVisibility::ResetVisibility()
 bool AttVisibility::ReadVisibility(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("visible")) {
-        this->SetVisible(StrToBoolean(element.attribute("visible").value()));
-        element.remove_attribute("visible");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("visible"))) {
+        this->SetVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7479,9 +7733,11 @@ void AttVisualOffsetHo::ResetVisualOffsetHo()
 bool AttVisualOffsetHo::ReadVisualOffsetHo(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("ho")) {
-        this->SetHo(StrToMeasurementrel(element.attribute("ho").value()));
-        element.remove_attribute("ho");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("ho"))) {
+        this->SetHo(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7525,9 +7781,11 @@ void AttVisualOffsetTo::ResetVisualOffsetTo()
 bool AttVisualOffsetTo::ReadVisualOffsetTo(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("to")) {
-        this->SetTo(StrToDbl(element.attribute("to").value()));
-        element.remove_attribute("to");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("to"))) {
+        this->SetTo(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7571,9 +7829,11 @@ void AttVisualOffsetVo::ResetVisualOffsetVo()
 bool AttVisualOffsetVo::ReadVisualOffsetVo(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("vo")) {
-        this->SetVo(StrToMeasurementrel(element.attribute("vo").value()));
-        element.remove_attribute("vo");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("vo"))) {
+        this->SetVo(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7618,14 +7878,16 @@ void AttVisualOffset2Ho::ResetVisualOffset2Ho()
 bool AttVisualOffset2Ho::ReadVisualOffset2Ho(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("startho")) {
-        this->SetStartho(StrToMeasurementrel(element.attribute("startho").value()));
-        element.remove_attribute("startho");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("startho"))) {
+        this->SetStartho(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("endho")) {
-        this->SetEndho(StrToMeasurementrel(element.attribute("endho").value()));
-        element.remove_attribute("endho");
+    if ((attr = element.attribute("endho"))) {
+        this->SetEndho(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7679,14 +7941,16 @@ void AttVisualOffset2To::ResetVisualOffset2To()
 bool AttVisualOffset2To::ReadVisualOffset2To(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("startto")) {
-        this->SetStartto(StrToDbl(element.attribute("startto").value()));
-        element.remove_attribute("startto");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("startto"))) {
+        this->SetStartto(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("endto")) {
-        this->SetEndto(StrToDbl(element.attribute("endto").value()));
-        element.remove_attribute("endto");
+    if ((attr = element.attribute("endto"))) {
+        this->SetEndto(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7740,14 +8004,16 @@ void AttVisualOffset2Vo::ResetVisualOffset2Vo()
 bool AttVisualOffset2Vo::ReadVisualOffset2Vo(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("startvo")) {
-        this->SetStartvo(StrToMeasurementrel(element.attribute("startvo").value()));
-        element.remove_attribute("startvo");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("startvo"))) {
+        this->SetStartvo(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("endvo")) {
-        this->SetEndvo(StrToMeasurementrel(element.attribute("endvo").value()));
-        element.remove_attribute("endvo");
+    if ((attr = element.attribute("endvo"))) {
+        this->SetEndvo(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7800,9 +8066,11 @@ void AttVoltaGroupingSym::ResetVoltaGroupingSym()
 bool AttVoltaGroupingSym::ReadVoltaGroupingSym(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("voltasym")) {
-        this->SetVoltasym(StrToVoltaGroupingSymVoltasym(element.attribute("voltasym").value()));
-        element.remove_attribute("voltasym");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("voltasym"))) {
+        this->SetVoltasym(StrToVoltaGroupingSymVoltasym(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7846,9 +8114,11 @@ void AttWhitespace::ResetWhitespace()
 bool AttWhitespace::ReadWhitespace(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("xml:space")) {
-        this->SetSpace(StrToStr(element.attribute("xml:space").value()));
-        element.remove_attribute("xml:space");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("xml:space"))) {
+        this->SetSpace(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7892,9 +8162,11 @@ void AttWidth::ResetWidth()
 bool AttWidth::ReadWidth(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("width")) {
-        this->SetWidth(StrToMeasurementabs(element.attribute("width").value()));
-        element.remove_attribute("width");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("width"))) {
+        this->SetWidth(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -7939,14 +8211,16 @@ void AttXy::ResetXy()
 bool AttXy::ReadXy(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("x")) {
-        this->SetX(StrToDbl(element.attribute("x").value()));
-        element.remove_attribute("x");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("x"))) {
+        this->SetX(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("y")) {
-        this->SetY(StrToDbl(element.attribute("y").value()));
-        element.remove_attribute("y");
+    if ((attr = element.attribute("y"))) {
+        this->SetY(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -8000,14 +8274,16 @@ void AttXy2::ResetXy2()
 bool AttXy2::ReadXy2(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("x2")) {
-        this->SetX2(StrToDbl(element.attribute("x2").value()));
-        element.remove_attribute("x2");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("x2"))) {
+        this->SetX2(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("y2")) {
-        this->SetY2(StrToDbl(element.attribute("y2").value()));
-        element.remove_attribute("y2");
+    if ((attr = element.attribute("y2"))) {
+        this->SetY2(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
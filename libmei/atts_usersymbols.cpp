@@ -47,9 +47,11 @@ void AttAltSym::ResetAltSym()
 bool AttAltSym::ReadAltSym(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("altsym")) {
-        this->SetAltsym(StrToStr(element.attribute("altsym").value()));
-        element.remove_attribute("altsym");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("altsym"))) {
+        this->SetAltsym(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -93,9 +95,11 @@ void AttAnchoredTextLog::ResetAnchoredTextLog()
 bool AttAnchoredTextLog::ReadAnchoredTextLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToStr(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -139,9 +143,11 @@ void AttCurveLog::ResetCurveLog()
 bool AttCurveLog::ReadCurveLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToStr(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -185,9 +191,11 @@ void AttLineLog::ResetLineLog()
 bool AttLineLog::ReadLineLog(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("func")) {
-        this->SetFunc(StrToStr(element.attribute("func").value()));
-        element.remove_attribute("func");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("func"))) {
+        this->SetFunc(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -47,9 +47,11 @@ void AttAnnotVis::ResetAnnotVis()
 bool AttAnnotVis::ReadAnnotVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("place")) {
-        this->SetPlace(StrToPlacement(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToPlacement(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -99,39 +101,41 @@ void AttArpegVis::ResetArpegVis()
 bool AttArpegVis::ReadArpegVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("arrow")) {
-        this->SetArrow(StrToBoolean(element.attribute("arrow").value()));
-        element.remove_attribute("arrow");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("arrow"))) {
+        this->SetArrow(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("arrow.shape")) {
-        this->SetArrowShape(StrToLinestartendsymbol(element.attribute("arrow.shape").value()));
-        element.remove_attribute("arrow.shape");
+    if ((attr = element.attribute("arrow.shape"))) {
+        this->SetArrowShape(StrToLinestartendsymbol(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("arrow.size")) {
-        this->SetArrowSize(StrToInt(element.attribute("arrow.size").value()));
-        element.remove_attribute("arrow.size");
+    if ((attr = element.attribute("arrow.size"))) {
+        this->SetArrowSize(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("arrow.color")) {
-        this->SetArrowColor(StrToStr(element.attribute("arrow.color").value()));
-        element.remove_attribute("arrow.color");
+    if ((attr = element.attribute("arrow.color"))) {
+        this->SetArrowColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("arrow.fillcolor")) {
-        this->SetArrowFillcolor(StrToStr(element.attribute("arrow.fillcolor").value()));
-        element.remove_attribute("arrow.fillcolor");
+    if ((attr = element.attribute("arrow.fillcolor"))) {
+        this->SetArrowFillcolor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("line.form")) {
-        this->SetLineForm(StrToLineform(element.attribute("line.form").value()));
-        element.remove_attribute("line.form");
+    if ((attr = element.attribute("line.form"))) {
+        this->SetLineForm(StrToLineform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("line.width")) {
-        this->SetLineWidth(StrToLinewidth(element.attribute("line.width").value()));
-        element.remove_attribute("line.width");
+    if ((attr = element.attribute("line.width"))) {
+        this->SetLineWidth(StrToLinewidth(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -231,19 +235,21 @@ void AttBarLineVis::ResetBarLineVis()
 bool AttBarLineVis::ReadBarLineVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("len")) {
-        this->SetLen(StrToDbl(element.attribute("len").value()));
-        element.remove_attribute("len");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("len"))) {
+        this->SetLen(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("method")) {
-        this->SetMethod(StrToBarmethod(element.attribute("method").value()));
-        element.remove_attribute("method");
+    if ((attr = element.attribute("method"))) {
+        this->SetMethod(StrToBarmethod(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("place")) {
-        this->SetPlace(StrToInt(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -307,19 +313,21 @@ void AttBeamingVis::ResetBeamingVis()
 bool AttBeamingVis::ReadBeamingVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("beam.color")) {
-        this->SetBeamColor(StrToStr(element.attribute("beam.color").value()));
-        element.remove_attribute("beam.color");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("beam.color"))) {
+        this->SetBeamColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("beam.rend")) {
-        this->SetBeamRend(StrToBeamingVisBeamrend(element.attribute("beam.rend").value()));
-        element.remove_attribute("beam.rend");
+    if ((attr = element.attribute("beam.rend"))) {
+        this->SetBeamRend(StrToBeamingVisBeamrend(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("beam.slope")) {
-        this->SetBeamSlope(StrToDbl(element.attribute("beam.slope").value()));
-        element.remove_attribute("beam.slope");
+    if ((attr = element.attribute("beam.slope"))) {
+        this->SetBeamSlope(StrToDbl(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -381,9 +389,11 @@ void AttBeatRptVis::ResetBeatRptVis()
 bool AttBeatRptVis::ReadBeatRptVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("slash")) {
-        this->SetSlash(StrToBeatrptRend(element.attribute("slash").value()));
-        element.remove_attribute("slash");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("slash"))) {
+        this->SetSlash(StrToBeatrptRend(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -427,9 +437,11 @@ void AttChordVis::ResetChordVis()
 bool AttChordVis::ReadChordVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("cluster")) {
-        this->SetCluster(StrToCluster(element.attribute("cluster").value()));
-        element.remove_attribute("cluster");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("cluster"))) {
+        this->SetCluster(StrToCluster(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -474,14 +486,16 @@ void AttCleffingVis::ResetCleffingVis()
 bool AttCleffingVis::ReadCleffingVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("clef.color")) {
-        this->SetClefColor(StrToStr(element.attribute("clef.color").value()));
-        element.remove_attribute("clef.color");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("clef.color"))) {
+        this->SetClefColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("clef.visible")) {
-        this->SetClefVisible(StrToBoolean(element.attribute("clef.visible").value()));
-        element.remove_attribute("clef.visible");
+    if ((attr = element.attribute("clef.visible"))) {
+        this->SetClefVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -535,14 +549,16 @@ void AttEpisemaVis::ResetEpisemaVis()
 bool AttEpisemaVis::ReadEpisemaVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToEpisemaVisForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToEpisemaVisForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("place")) {
-        this->SetPlace(StrToEventrel(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToEventrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -597,19 +613,21 @@ void AttFTremVis::ResetFTremVis()
 bool AttFTremVis::ReadFTremVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("beams")) {
-        this->SetBeams(StrToInt(element.attribute("beams").value()));
-        element.remove_attribute("beams");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("beams"))) {
+        this->SetBeams(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("beams.float")) {
-        this->SetBeamsFloat(StrToInt(element.attribute("beams.float").value()));
-        element.remove_attribute("beams.float");
+    if ((attr = element.attribute("beams.float"))) {
+        this->SetBeamsFloat(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("float.gap")) {
-        this->SetFloatGap(StrToMeasurementabs(element.attribute("float.gap").value()));
-        element.remove_attribute("float.gap");
+    if ((attr = element.attribute("float.gap"))) {
+        this->SetFloatGap(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -672,14 +690,16 @@ void AttFermataVis::ResetFermataVis()
 bool AttFermataVis::ReadFermataVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToFermataVisForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToFermataVisForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("shape")) {
-        this->SetShape(StrToFermataVisShape(element.attribute("shape").value()));
-        element.remove_attribute("shape");
+    if ((attr = element.attribute("shape"))) {
+        this->SetShape(StrToFermataVisShape(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -732,9 +752,11 @@ void AttFingGrpVis::ResetFingGrpVis()
 bool AttFingGrpVis::ReadFingGrpVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("orient")) {
-        this->SetOrient(StrToFingGrpVisOrient(element.attribute("orient").value()));
-        element.remove_attribute("orient");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("orient"))) {
+        this->SetOrient(StrToFingGrpVisOrient(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -778,9 +800,11 @@ void AttHairpinVis::ResetHairpinVis()
 bool AttHairpinVis::ReadHairpinVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("opening")) {
-        this->SetOpening(StrToMeasurementabs(element.attribute("opening").value()));
-        element.remove_attribute("opening");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("opening"))) {
+        this->SetOpening(StrToMeasurementabs(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -824,9 +848,11 @@ void AttHarmVis::ResetHarmVis()
 bool AttHarmVis::ReadHarmVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("rendgrid")) {
-        this->SetRendgrid(StrToHarmVisRendgrid(element.attribute("rendgrid").value()));
-        element.remove_attribute("rendgrid");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("rendgrid"))) {
+        this->SetRendgrid(StrToHarmVisRendgrid(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -871,14 +897,16 @@ void AttHispanTickVis::ResetHispanTickVis()
 bool AttHispanTickVis::ReadHispanTickVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("place")) {
-        this->SetPlace(StrToEventrel(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToEventrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("tilt")) {
-        this->SetTilt(StrToCompassdirection(element.attribute("tilt").value()));
-        element.remove_attribute("tilt");
+    if ((attr = element.attribute("tilt"))) {
+        this->SetTilt(StrToCompassdirection(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -931,9 +959,11 @@ void AttKeySigVis::ResetKeySigVis()
 bool AttKeySigVis::ReadKeySigVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("sig.showchange")) {
-        this->SetSigShowchange(StrToBoolean(element.attribute("sig.showchange").value()));
-        element.remove_attribute("sig.showchange");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("sig.showchange"))) {
+        this->SetSigShowchange(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -978,14 +1008,16 @@ void AttKeySigDefaultVis::ResetKeySigDefaultVis()
 bool AttKeySigDefaultVis::ReadKeySigDefaultVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("keysig.show")) {
-        this->SetKeysigShow(StrToBoolean(element.attribute("keysig.show").value()));
-        element.remove_attribute("keysig.show");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("keysig.show"))) {
+        this->SetKeysigShow(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("keysig.showchange")) {
-        this->SetKeysigShowchange(StrToBoolean(element.attribute("keysig.showchange").value()));
-        element.remove_attribute("keysig.showchange");
+    if ((attr = element.attribute("keysig.showchange"))) {
+        this->SetKeysigShowchange(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1038,9 +1070,11 @@ void AttLigatureVis::ResetLigatureVis()
 bool AttLigatureVis::ReadLigatureVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToLigatureform(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToLigatureform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1089,34 +1123,36 @@ void AttLineVis::ResetLineVis()
 bool AttLineVis::ReadLineVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToLineform(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToLineform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("width")) {
-        this->SetWidth(StrToLinewidth(element.attribute("width").value()));
-        element.remove_attribute("width");
+    if ((attr = element.attribute("width"))) {
+        this->SetWidth(StrToLinewidth(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("endsym")) {
-        this->SetEndsym(StrToLinestartendsymbol(element.attribute("endsym").value()));
-        element.remove_attribute("endsym");
+    if ((attr = element.attribute("endsym"))) {
+        this->SetEndsym(StrToLinestartendsymbol(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("endsym.size")) {
-        this->SetEndsymSize(StrToInt(element.attribute("endsym.size").value()));
-        element.remove_attribute("endsym.size");
+    if ((attr = element.attribute("endsym.size"))) {
+        this->SetEndsymSize(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("startsym")) {
-        this->SetStartsym(StrToLinestartendsymbol(element.attribute("startsym").value()));
-        element.remove_attribute("startsym");
+    if ((attr = element.attribute("startsym"))) {
+        this->SetStartsym(StrToLinestartendsymbol(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("startsym.size")) {
-        this->SetStartsymSize(StrToInt(element.attribute("startsym.size").value()));
-        element.remove_attribute("startsym.size");
+    if ((attr = element.attribute("startsym.size"))) {
+        this->SetStartsymSize(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1206,14 +1242,16 @@ void AttLiquescentVis::ResetLiquescentVis()
 bool AttLiquescentVis::ReadLiquescentVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("curve")) {
-        this->SetCurve(StrToLiquescentVisCurve(element.attribute("curve").value()));
-        element.remove_attribute("curve");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("curve"))) {
+        this->SetCurve(StrToLiquescentVisCurve(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("looped")) {
-        this->SetLooped(StrToBoolean(element.attribute("looped").value()));
-        element.remove_attribute("looped");
+    if ((attr = element.attribute("looped"))) {
+        this->SetLooped(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1269,24 +1307,26 @@ void AttMensurVis::ResetMensurVis()
 bool AttMensurVis::ReadMensurVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("dot")) {
-        this->SetDot(StrToBoolean(element.attribute("dot").value()));
-        element.remove_attribute("dot");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("dot"))) {
+        this->SetDot(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("form")) {
-        this->SetForm(StrToMensurVisForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToMensurVisForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("orient")) {
-        this->SetOrient(StrToOrientation(element.attribute("orient").value()));
-        element.remove_attribute("orient");
+    if ((attr = element.attribute("orient"))) {
+        this->SetOrient(StrToOrientation(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("sign")) {
-        this->SetSign(StrToMensurationsign(element.attribute("sign").value()));
-        element.remove_attribute("sign");
+    if ((attr = element.attribute("sign"))) {
+        this->SetSign(StrToMensurationsign(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1364,44 +1404,46 @@ void AttMensuralVis::ResetMensuralVis()
 bool AttMensuralVis::ReadMensuralVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("mensur.color")) {
-        this->SetMensurColor(StrToStr(element.attribute("mensur.color").value()));
-        element.remove_attribute("mensur.color");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("mensur.color"))) {
+        this->SetMensurColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.dot")) {
-        this->SetMensurDot(StrToBoolean(element.attribute("mensur.dot").value()));
-        element.remove_attribute("mensur.dot");
+    if ((attr = element.attribute("mensur.dot"))) {
+        this->SetMensurDot(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.form")) {
-        this->SetMensurForm(StrToMensuralVisMensurform(element.attribute("mensur.form").value()));
-        element.remove_attribute("mensur.form");
+    if ((attr = element.attribute("mensur.form"))) {
+        this->SetMensurForm(StrToMensuralVisMensurform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.loc")) {
-        this->SetMensurLoc(StrToInt(element.attribute("mensur.loc").value()));
-        element.remove_attribute("mensur.loc");
+    if ((attr = element.attribute("mensur.loc"))) {
+        this->SetMensurLoc(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.orient")) {
-        this->SetMensurOrient(StrToOrientation(element.attribute("mensur.orient").value()));
-        element.remove_attribute("mensur.orient");
+    if ((attr = element.attribute("mensur.orient"))) {
+        this->SetMensurOrient(StrToOrientation(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.sign")) {
-        this->SetMensurSign(StrToMensurationsign(element.attribute("mensur.sign").value()));
-        element.remove_attribute("mensur.sign");
+    if ((attr = element.attribute("mensur.sign"))) {
+        this->SetMensurSign(StrToMensurationsign(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.size")) {
-        this->SetMensurSize(StrToFontsize(element.attribute("mensur.size").value()));
-        element.remove_attribute("mensur.size");
+    if ((attr = element.attribute("mensur.size"))) {
+        this->SetMensurSize(StrToFontsize(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("mensur.slash")) {
-        this->SetMensurSlash(StrToInt(element.attribute("mensur.slash").value()));
-        element.remove_attribute("mensur.slash");
+    if ((attr = element.attribute("mensur.slash"))) {
+        this->SetMensurSlash(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1508,9 +1550,11 @@ void AttMeterSigVis::ResetMeterSigVis()
 bool AttMeterSigVis::ReadMeterSigVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToMeterform(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToMeterform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1555,14 +1599,16 @@ void AttMeterSigDefaultVis::ResetMeterSigDefaultVis()
 bool AttMeterSigDefaultVis::ReadMeterSigDefaultVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("meter.form")) {
-        this->SetMeterForm(StrToMeterform(element.attribute("meter.form").value()));
-        element.remove_attribute("meter.form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("meter.form"))) {
+        this->SetMeterForm(StrToMeterform(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("meter.showchange")) {
-        this->SetMeterShowchange(StrToBoolean(element.attribute("meter.showchange").value()));
-        element.remove_attribute("meter.showchange");
+    if ((attr = element.attribute("meter.showchange"))) {
+        this->SetMeterShowchange(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1615,9 +1661,11 @@ void AttMultiRestVis::ResetMultiRestVis()
 bool AttMultiRestVis::ReadMultiRestVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("block")) {
-        this->SetBlock(StrToBoolean(element.attribute("block").value()));
-        element.remove_attribute("block");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("block"))) {
+        this->SetBlock(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1661,9 +1709,11 @@ void AttPbVis::ResetPbVis()
 bool AttPbVis::ReadPbVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("folium")) {
-        this->SetFolium(StrToPbVisFolium(element.attribute("folium").value()));
-        element.remove_attribute("folium");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("folium"))) {
+        this->SetFolium(StrToPbVisFolium(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1707,9 +1757,11 @@ void AttPedalVis::ResetPedalVis()
 bool AttPedalVis::ReadPedalVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToPedalVisForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToPedalVisForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1753,9 +1805,11 @@ void AttQuilismaVis::ResetQuilismaVis()
 bool AttQuilismaVis::ReadQuilismaVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("waves")) {
-        this->SetWaves(StrToInt(element.attribute("waves").value()));
-        element.remove_attribute("waves");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("waves"))) {
+        this->SetWaves(StrToInt(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1799,9 +1853,11 @@ void AttSbVis::ResetSbVis()
 bool AttSbVis::ReadSbVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("form")) {
-        this->SetForm(StrToSbVisForm(element.attribute("form").value()));
-        element.remove_attribute("form");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("form"))) {
+        this->SetForm(StrToSbVisForm(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1845,9 +1901,11 @@ void AttScoreDefVis::ResetScoreDefVis()
 bool AttScoreDefVis::ReadScoreDefVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("vu.height")) {
-        this->SetVuHeight(StrToStr(element.attribute("vu.height").value()));
-        element.remove_attribute("vu.height");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("vu.height"))) {
+        this->SetVuHeight(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1891,9 +1949,11 @@ void AttSectionVis::ResetSectionVis()
 bool AttSectionVis::ReadSectionVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("restart")) {
-        this->SetRestart(StrToBoolean(element.attribute("restart").value()));
-        element.remove_attribute("restart");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("restart"))) {
+        this->SetRestart(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1937,9 +1997,11 @@ void AttSignifLetVis::ResetSignifLetVis()
 bool AttSignifLetVis::ReadSignifLetVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("place")) {
-        this->SetPlace(StrToEventrel(element.attribute("place").value()));
-        element.remove_attribute("place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("place"))) {
+        this->SetPlace(StrToEventrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -1983,9 +2045,11 @@ void AttSpaceVis::ResetSpaceVis()
 bool AttSpaceVis::ReadSpaceVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("compressable")) {
-        this->SetCompressable(StrToBoolean(element.attribute("compressable").value()));
-        element.remove_attribute("compressable");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("compressable"))) {
+        this->SetCompressable(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2033,29 +2097,31 @@ void AttStaffDefVis::ResetStaffDefVis()
 bool AttStaffDefVis::ReadStaffDefVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("grid.show")) {
-        this->SetGridShow(StrToBoolean(element.attribute("grid.show").value()));
-        element.remove_attribute("grid.show");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("grid.show"))) {
+        this->SetGridShow(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("layerscheme")) {
-        this->SetLayerscheme(StrToLayerscheme(element.attribute("layerscheme").value()));
-        element.remove_attribute("layerscheme");
+    if ((attr = element.attribute("layerscheme"))) {
+        this->SetLayerscheme(StrToLayerscheme(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lines.color")) {
-        this->SetLinesColor(StrToStr(element.attribute("lines.color").value()));
-        element.remove_attribute("lines.color");
+    if ((attr = element.attribute("lines.color"))) {
+        this->SetLinesColor(StrToStr(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("lines.visible")) {
-        this->SetLinesVisible(StrToBoolean(element.attribute("lines.visible").value()));
-        element.remove_attribute("lines.visible");
+    if ((attr = element.attribute("lines.visible"))) {
+        this->SetLinesVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("spacing")) {
-        this->SetSpacing(StrToMeasurementrel(element.attribute("spacing").value()));
-        element.remove_attribute("spacing");
+    if ((attr = element.attribute("spacing"))) {
+        this->SetSpacing(StrToMeasurementrel(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2135,9 +2201,11 @@ void AttStaffGrpVis::ResetStaffGrpVis()
 bool AttStaffGrpVis::ReadStaffGrpVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("bar.thru")) {
-        this->SetBarThru(StrToBoolean(element.attribute("bar.thru").value()));
-        element.remove_attribute("bar.thru");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("bar.thru"))) {
+        this->SetBarThru(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
@@ -2184,24 +2252,26 @@ void AttTupletVis::ResetTupletVis()
 bool AttTupletVis::ReadTupletVis(pugi::xml_node element)
 {
     bool hasAttribute = false;
-    if (element.attribute("bracket.place")) {
-        this->SetBracketPlace(StrToStaffrelBasic(element.attribute("bracket.place").value()));
-        element.remove_attribute("bracket.place");
+    if (!element.first_attribute()) return hasAttribute;
+    pugi::xml_attribute attr;
+    if ((attr = element.attribute("bracket.place"))) {
+        this->SetBracketPlace(StrToStaffrelBasic(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("bracket.visible")) {
-        this->SetBracketVisible(StrToBoolean(element.attribute("bracket.visible").value()));
-        element.remove_attribute("bracket.visible");
+    if ((attr = element.attribute("bracket.visible"))) {
+        this->SetBracketVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("dur.visible")) {
-        this->SetDurVisible(StrToBoolean(element.attribute("dur.visible").value()));
-        element.remove_attribute("dur.visible");
+    if ((attr = element.attribute("dur.visible"))) {
+        this->SetDurVisible(StrToBoolean(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
-    if (element.attribute("num.format")) {
-        this->SetNumFormat(StrToTupletVisNumformat(element.attribute("num.format").value()));
-        element.remove_attribute("num.format");
+    if ((attr = element.attribute("num.format"))) {
+        this->SetNumFormat(StrToTupletVisNumformat(attr.value()));
+        element.remove_attribute(attr);
         hasAttribute = true;
     }
     return hasAttribute;
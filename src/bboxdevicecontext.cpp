@@ -363,7 +363,7 @@ void BBoxDeviceContext::DrawMusicText(const std::wstring &text, int x, int y, bo
 
     for (unsigned int i = 0; i < text.length(); i++) {
         wchar_t c = text.at(i);
-        Glyph *glyph = Resources::GetGlyph(c);
+        const Glyph *glyph = Resources::GetGlyph(c);
         if (!glyph) {
             continue;
         }
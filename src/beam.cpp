@@ -1036,6 +1036,14 @@ Beam::Beam() : LayerElement("beam-"), BeamDrawingInterface(), AttColor(), AttBea
 
 Beam::~Beam() {}
 
+void Beam::CloneReset()
+{
+    // The coordinates belong to the beam copied
+    m_beamElementCoords.clear();
+
+    LayerElement::CloneReset();
+}
+
 void Beam::Reset()
 {
     LayerElement::Reset();
@@ -315,7 +315,7 @@ int BoundingBox::VerticalBottomOverlap(const BoundingBox *other, Doc *doc, int m
 int BoundingBox::GetRectangles(
     const SMuFLGlyphAnchor &anchor1, const SMuFLGlyphAnchor &anchor2, Point rect[3][2], Doc *doc) const
 {
-    Glyph *glyph = NULL;
+    const Glyph *glyph = NULL;
 
     bool glyphRect = true;
 
@@ -347,7 +347,7 @@ int BoundingBox::GetRectangles(
 }
 
 bool BoundingBox::GetGlyph2PointRectangles(
-    const SMuFLGlyphAnchor &anchor1, const SMuFLGlyphAnchor &anchor2, Glyph *glyph, Point rect[3][2], Doc *doc) const
+    const SMuFLGlyphAnchor &anchor1, const SMuFLGlyphAnchor &anchor2, const Glyph *glyph, Point rect[3][2], Doc *doc) const
 {
     assert(glyph);
 
@@ -435,7 +435,7 @@ bool BoundingBox::GetGlyph2PointRectangles(
 }
 
 bool BoundingBox::GetGlyph1PointRectangles(
-    const SMuFLGlyphAnchor &anchor, Glyph *glyph, Point rect[2][2], Doc *doc) const
+    const SMuFLGlyphAnchor &anchor, const Glyph *glyph, Point rect[2][2], Doc *doc) const
 {
     assert(glyph);
 
@@ -90,6 +90,14 @@ Chord::~Chord()
     ClearClusters();
 }
 
+void Chord::CloneReset()
+{
+    // The clusters belong to the chord copied
+    m_clusters.clear();
+
+    LayerElement::CloneReset();
+}
+
 void Chord::Reset()
 {
     LayerElement::Reset();
@@ -37,6 +37,38 @@ void BezierCurve::CalculateControlPointOffset(Doc *doc, int staffSize)
     m_leftControlPointOffset = m_rightControlPointOffset;
 }
 
+//----------------------------------------------------------------------------
+// TextExtentCache
+//----------------------------------------------------------------------------
+
+bool TextExtentCache::Get(const std::wstring &string, const Resources::StyleAttributes &style, int pointSize,
+    bool typeSize, TextExtend &extend) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto font = m_extends.find(std::make_tuple(style, pointSize, typeSize));
+    if (font == m_extends.end()) return false;
+    auto it = font->second.find(string);
+    if (it == font->second.end()) return false;
+    extend = it->second;
+    return true;
+}
+
+void TextExtentCache::Set(const std::wstring &string, const Resources::StyleAttributes &style, int pointSize,
+    bool typeSize, const TextExtend &extend)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_extends[std::make_tuple(style, pointSize, typeSize)][string] = extend;
+}
+
+void TextExtentCache::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_extends.clear();
+}
+
 //----------------------------------------------------------------------------
 // DeviceContext
 //----------------------------------------------------------------------------
@@ -156,6 +188,13 @@ void DeviceContext::GetTextExtent(const std::wstring &string, TextExtend *extend
 
     extend->m_width = 0;
     extend->m_height = 0;
+    extend->m_ascent = 0;
+    extend->m_descent = 0;
+
+    // The same strings are measured again in every layout pass
+    const Resources::StyleAttributes style = Resources::GetCurrentTextStyle();
+    const int pointSize = m_fontStack.top()->GetPointSize();
+    if (m_textExtentCache && m_textExtentCache->Get(string, style, pointSize, typeSize, *extend)) return;
 
     if (typeSize) {
         AddGlyphToTextExtend(Resources::GetTextGlyph(L'p'), extend);
@@ -163,11 +202,11 @@ void DeviceContext::GetTextExtent(const std::wstring &string, TextExtend *extend
         extend->m_width = 0;
     }
 
-    Glyph *unkown = Resources::GetTextGlyph(L'o');
+    const Glyph *unkown = Resources::GetTextGlyph(L'o');
 
     for (unsigned int i = 0; i < string.length(); ++i) {
         wchar_t c = string[i];
-        Glyph *glyph = Resources::GetTextGlyph(c);
+        const Glyph *glyph = Resources::GetTextGlyph(c);
         if (!glyph) {
             glyph = Resources::GetGlyph(c);
         }
@@ -184,6 +223,8 @@ void DeviceContext::GetTextExtent(const std::wstring &string, TextExtend *extend
         }
         AddGlyphToTextExtend(glyph, extend);
     }
+
+    if (m_textExtentCache) m_textExtentCache->Set(string, style, pointSize, typeSize, *extend);
 }
 
 void DeviceContext::GetSmuflTextExtent(const std::wstring &string, TextExtend *extend)
@@ -196,7 +237,7 @@ void DeviceContext::GetSmuflTextExtent(const std::wstring &string, TextExtend *e
 
     for (unsigned int i = 0; i < string.length(); ++i) {
         wchar_t c = string[i];
-        Glyph *glyph = Resources::GetGlyph(c);
+        const Glyph *glyph = Resources::GetGlyph(c);
         if (!glyph) {
             continue;
         }
@@ -204,7 +245,7 @@ void DeviceContext::GetSmuflTextExtent(const std::wstring &string, TextExtend *e
     }
 }
 
-void DeviceContext::AddGlyphToTextExtend(Glyph *glyph, TextExtend *extend)
+void DeviceContext::AddGlyphToTextExtend(const Glyph *glyph, TextExtend *extend)
 {
     assert(glyph);
     assert(extend);
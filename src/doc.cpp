@@ -9,8 +9,11 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
 #include <math.h>
+#include <string.h>
+#include <unordered_map>
 
 //----------------------------------------------------------------------------
 
@@ -18,6 +21,7 @@
 #include "beatrpt.h"
 #include "chord.h"
 #include "comparison.h"
+#include "ending.h"
 #include "expansion.h"
 #include "functorparams.h"
 #include "glyph.h"
@@ -26,6 +30,7 @@
 #include "keysig.h"
 #include "label.h"
 #include "layer.h"
+#include "linkinginterface.h"
 #include "mdiv.h"
 #include "measure.h"
 #include "mensur.h"
@@ -37,6 +42,7 @@
 #include "multirest.h"
 #include "multirpt.h"
 #include "note.h"
+#include "num.h"
 #include "page.h"
 #include "pages.h"
 #include "pgfoot.h"
@@ -54,6 +60,7 @@
 #include "syllable.h"
 #include "system.h"
 #include "text.h"
+#include "timeinterface.h"
 #include "timestamp.h"
 #include "transposition.h"
 #include "verse.h"
@@ -64,12 +71,61 @@
 
 #include "MidiFile.h"
 
+//----------------------------------------------------------------------------
+
+/** The number of measures first cast off with progressive breaks (doubled until the first page is filled) */
+#define DOC_PROGRESSIVE_MEASURES 32
+
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// MidiTimemapData
+//----------------------------------------------------------------------------
+
+void MidiTimemapData::Reset()
+{
+    m_key.clear();
+    m_tempoAdjustment = 0.0;
+    m_objectCount = 0;
+    m_values.clear();
+}
+
+//----------------------------------------------------------------------------
+// DrawingPageValues
+//----------------------------------------------------------------------------
+
+DrawingPageValues::~DrawingPageValues()
+{
+    this->Reset();
+}
+
+void DrawingPageValues::Reset()
+{
+    m_page = NULL;
+    m_pageHeight = -1;
+    m_pageWidth = -1;
+    m_pageContentHeight = -1;
+    m_pageContentWidth = -1;
+    m_pageMarginBottom = 0;
+    m_pageMarginRight = 0;
+    m_pageMarginLeft = 0;
+    m_pageMarginTop = 0;
+    m_smuflFontSize = 0;
+    m_lyricFontSize = 0;
+
+    for (auto &runningElement : m_runningElements) {
+        delete runningElement.second;
+    }
+    m_runningElements.clear();
+}
+
 //----------------------------------------------------------------------------
 // Doc
 //----------------------------------------------------------------------------
 
+thread_local const Doc *Doc::s_threadDrawingDoc = NULL;
+thread_local DrawingPageValues *Doc::s_threadDrawingValues = NULL;
+
 Doc::Doc() : Object("doc-")
 {
     m_options = new Options();
@@ -95,26 +151,28 @@ void Doc::Reset()
     m_pageMarginLeft = 0;
     m_pageMarginTop = 0;
 
-    m_drawingPageHeight = -1;
-    m_drawingPageWidth = -1;
-    m_drawingPageContentHeight = -1;
-    m_drawingPageContentWidth = -1;
-    m_drawingPageMarginBottom = 0;
-    m_drawingPageMarginRight = 0;
-    m_drawingPageMarginLeft = 0;
-    m_drawingPageMarginTop = 0;
-
-    m_drawingPage = NULL;
+    m_drawingValues.Reset();
     m_currentScoreDefDone = false;
     m_drawingPreparationDone = false;
     m_MIDITimemapTempo = 0.0;
+    m_midiTimemapData = NULL;
+    m_textExtentCache.Reset();
     m_markup = MARKUP_DEFAULT;
     m_isMensuralMusicOnly = false;
 
-    m_mdivScoreDef.Reset();
+    m_uuidIndex.clear();
+    m_uuidIndexRevision = Object::GetUuidRevision();
+    m_uuidIndexBuilt = false;
+
+    m_measureTimeIndex.clear();
+    m_noteTimeIndex.clear();
+    m_timeIndexRevision = 0;
 
-    m_drawingSmuflFontSize = 0;
-    m_drawingLyricFontSize = 0;
+    m_isCastOffInvalid = false;
+    m_isCastOffPending = false;
+    m_castOffPendingSmart = false;
+
+    m_mdivScoreDef.Reset();
 
     m_header.reset();
     m_front.reset();
@@ -251,8 +309,11 @@ void Doc::CalculateMidiTimemap()
 {
     m_MIDITimemapTempo = 0.0;
 
+    // The measures left by a progressive cast-off are not aligned yet
+    this->CastOffPendingDoc();
+
     // This happens if the document was never cast off (breaks none option in the toolkit)
-    if (!m_drawingPage && GetPageCount() == 1) {
+    if (!this->GetDrawingPage() && GetPageCount() == 1) {
         Page *page = this->SetDrawingPage(0);
         if (!page) {
             return;
@@ -261,6 +322,12 @@ void Doc::CalculateMidiTimemap()
         page->LayOutHorizontally();
     }
 
+    // Restore the values if they were calculated for the same content before
+    if (m_midiTimemapData) {
+        if (this->RestoreMidiTimemap(*m_midiTimemapData)) return;
+        m_midiTimemapData = NULL;
+    }
+
     int tempo = MIDI_TEMPO;
 
     // Set tempo
@@ -286,6 +353,167 @@ void Doc::CalculateMidiTimemap()
     this->Process(&resolveMIDITies, NULL, NULL, NULL, UNLIMITED_DEPTH, BACKWARD);
 
     m_MIDITimemapTempo = m_options->m_midiTempoAdjustment.GetValue();
+
+    this->PrepareTimeIndex();
+}
+
+void Doc::InvalidateMidiTimemap()
+{
+    m_MIDITimemapTempo = 0.0;
+    // The content does not match the data to restore from anymore
+    m_midiTimemapData = NULL;
+}
+
+void Doc::GetMidiTimemapData(MidiTimemapData &data)
+{
+    data.m_values.clear();
+    data.m_objectCount = 0;
+    if (!this->HasMidiTimemap()) return;
+
+    ListOfObjects objects;
+    ClassIdsComparison comparison({ MEASURE, NOTE, BEATRPT });
+    this->FindAllDescendantByComparison(&objects, &comparison);
+
+    for (Object *object : objects) {
+        if (object->Is(MEASURE)) {
+            vrv_cast<Measure *>(object)->StoreTimemapValues(data.m_values);
+        }
+        else if (object->Is(NOTE)) {
+            vrv_cast<Note *>(object)->StoreTimemapValues(data.m_values);
+        }
+        else {
+            data.m_values.push_back(vrv_cast<BeatRpt *>(object)->GetScoreTimeOnset());
+        }
+    }
+    data.m_objectCount = (int)objects.size();
+    data.m_tempoAdjustment = m_MIDITimemapTempo;
+}
+
+bool Doc::RestoreMidiTimemap(const MidiTimemapData &data)
+{
+    if (data.IsEmpty() || (data.m_tempoAdjustment != m_options->m_midiTempoAdjustment.GetValue())) return false;
+
+    ListOfObjects objects;
+    ClassIdsComparison comparison({ MEASURE, NOTE, BEATRPT });
+    this->FindAllDescendantByComparison(&objects, &comparison);
+    if ((int)objects.size() != data.m_objectCount) return false;
+
+    int position = 0;
+    for (Object *object : objects) {
+        bool restored = true;
+        if (object->Is(MEASURE)) {
+            restored = vrv_cast<Measure *>(object)->RestoreTimemapValues(data.m_values, position);
+        }
+        else if (object->Is(NOTE)) {
+            restored = vrv_cast<Note *>(object)->RestoreTimemapValues(data.m_values, position);
+        }
+        else if (position < (int)data.m_values.size()) {
+            vrv_cast<BeatRpt *>(object)->SetScoreTimeOnset(data.m_values.at(position++));
+        }
+        else {
+            restored = false;
+        }
+        // Values partially restored will be calculated again
+        if (!restored) return false;
+    }
+    if (position != (int)data.m_values.size()) return false;
+
+    m_MIDITimemapTempo = data.m_tempoAdjustment;
+
+    this->PrepareTimeIndex();
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// Time index helpers
+//----------------------------------------------------------------------------
+
+static void SortTimeIndex(std::vector<TimeIndexEntry> &entries)
+{
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const TimeIndexEntry &a, const TimeIndexEntry &b) { return (a.m_onset < b.m_onset); });
+    double maxOffset = VRV_UNSET;
+    for (TimeIndexEntry &entry : entries) {
+        maxOffset = std::max(maxOffset, entry.m_offset);
+        entry.m_maxOffset = maxOffset;
+    }
+}
+
+static std::vector<const TimeIndexEntry *> FindTimeIndexEntries(const std::vector<TimeIndexEntry> &entries, int time)
+{
+    // Collect the entries with onset <= time <= offset - the scan stops when no previous entry can end after time
+    std::vector<const TimeIndexEntry *> found;
+    auto it = std::upper_bound(entries.begin(), entries.end(), time,
+        [](int value, const TimeIndexEntry &entry) { return (value < entry.m_onset); });
+    while (it != entries.begin()) {
+        --it;
+        if (time > it->m_maxOffset) break;
+        if (time <= it->m_offset) found.push_back(&(*it));
+    }
+    // Back to the document order
+    std::sort(found.begin(), found.end(), [](const TimeIndexEntry *a, const TimeIndexEntry *b) {
+        return (a->m_order != b->m_order) ? (a->m_order < b->m_order) : (a->m_repeat < b->m_repeat);
+    });
+    return found;
+}
+
+void Doc::PrepareTimeIndex()
+{
+    m_measureTimeIndex.clear();
+    m_noteTimeIndex.clear();
+    m_timeIndexRevision = Object::GetUuidRevision();
+
+    ListOfObjects measures;
+    ClassIdComparison isMeasure(MEASURE);
+    this->FindAllDescendantByComparison(&measures, &isMeasure);
+
+    ClassIdComparison isNote(NOTE);
+    int measureOrder = 0;
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        const int duration = measure->GetRealTimeDurationMilliseconds();
+        for (int repeat = 1; repeat <= measure->GetRealTimeOffsetCount(); ++repeat) {
+            const double onset = measure->GetRealTimeOffsetMilliseconds(repeat);
+            m_measureTimeIndex.push_back({ onset, onset + duration, 0.0, measureOrder, repeat, measure });
+        }
+
+        ListOfObjects notes;
+        measure->FindAllDescendantByComparison(&notes, &isNote);
+        m_noteTimeIndex.push_back({});
+        std::vector<TimeIndexEntry> &noteEntries = m_noteTimeIndex.back();
+        for (Object *child : notes) {
+            Note *note = vrv_cast<Note *>(child);
+            assert(note);
+            noteEntries.push_back({ note->GetRealTimeOnsetMilliseconds(), note->GetRealTimeOffsetMilliseconds(), 0.0,
+                (int)noteEntries.size(), 0, note });
+        }
+        SortTimeIndex(noteEntries);
+        ++measureOrder;
+    }
+    SortTimeIndex(m_measureTimeIndex);
+}
+
+Measure *Doc::FindNotesAtTime(int millisec, ListOfObjects *notes)
+{
+    assert(notes);
+
+    // Objects were added or deleted since the index was built
+    if (m_timeIndexRevision != Object::GetUuidRevision()) this->PrepareTimeIndex();
+
+    std::vector<const TimeIndexEntry *> measureEntries = FindTimeIndexEntries(m_measureTimeIndex, millisec);
+    if (measureEntries.empty()) return NULL;
+
+    // The first measure enclosing the time and its first repeat enclosing it
+    const TimeIndexEntry *measureEntry = measureEntries.front();
+    const int measureTimeOffset = measureEntry->m_onset;
+
+    for (const TimeIndexEntry *entry :
+        FindTimeIndexEntries(m_noteTimeIndex.at(measureEntry->m_order), millisec - measureTimeOffset)) {
+        notes->push_back(entry->m_object);
+    }
+
+    return vrv_cast<Measure *>(measureEntry->m_object);
 }
 
 void Doc::ExportMIDI(smf::MidiFile *midiFile)
@@ -484,8 +712,131 @@ void Doc::PrepareJsonTimemap(std::string &output, std::map<double, double> &real
     output += "]\n";
 }
 
+bool Doc::ExportTimemapBinary(std::vector<unsigned char> &output)
+{
+    if (!Doc::HasMidiTimemap()) {
+        // generate MIDI timemap before progressing
+        CalculateMidiTimemap();
+    }
+    if (!Doc::HasMidiTimemap()) {
+        LogWarning("Calculation of MIDI timemap failed, not exporting MidiFile.");
+        output.clear();
+        return false;
+    }
+    Functor generateTimemap(&Object::GenerateTimemap);
+    GenerateTimemapParams generateTimemapParams(&generateTimemap);
+    this->Process(&generateTimemap, &generateTimemapParams);
+
+    PrepareBinaryTimemap(output, generateTimemapParams.realTimeToScoreTime, generateTimemapParams.realTimeToOnElements,
+        generateTimemapParams.realTimeToOffElements, generateTimemapParams.realTimeToTempo);
+
+    return true;
+}
+
+/**
+ * Write a value in little-endian order at a given position of the buffer.
+ */
+static void WriteTimemapValue(unsigned char *buffer, uint64_t value, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        buffer[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static void WriteTimemapDouble(unsigned char *buffer, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteTimemapValue(buffer, bits, 8);
+}
+
+void Doc::PrepareBinaryTimemap(std::vector<unsigned char> &output, std::map<double, double> &realTimeToScoreTime,
+    std::map<double, std::vector<std::string>> &realTimeToOnElements,
+    std::map<double, std::vector<std::string>> &realTimeToOffElements, std::map<double, int> &realTimeToTempo)
+{
+    const int headerSize = 24;
+    const int entrySize = 32;
+
+    // Give each id a position in the id table
+    std::unordered_map<std::string, uint32_t> idPositions;
+    std::vector<const std::string *> ids;
+    uint32_t idTableSize = 0;
+    uint32_t indexCount = 0;
+    for (auto *elements : { &realTimeToOnElements, &realTimeToOffElements }) {
+        for (auto &entry : *elements) {
+            indexCount += (uint32_t)entry.second.size();
+            for (const std::string &id : entry.second) {
+                if (idPositions.emplace(id, (uint32_t)ids.size()).second) {
+                    ids.push_back(&id);
+                    idTableSize += (uint32_t)id.size() + 1;
+                }
+            }
+        }
+    }
+
+    const uint32_t entryCount = (uint32_t)realTimeToScoreTime.size();
+    const size_t indicesOffset = headerSize + (size_t)entryCount * entrySize;
+    const size_t idTableOffset = indicesOffset + (size_t)indexCount * 4;
+    output.assign(idTableOffset + idTableSize, 0);
+    unsigned char *buffer = output.data();
+
+    memcpy(buffer, "VRVT", 4);
+    WriteTimemapValue(buffer + 4, 1, 4);
+    WriteTimemapValue(buffer + 8, entryCount, 4);
+    WriteTimemapValue(buffer + 12, indexCount, 4);
+    WriteTimemapValue(buffer + 16, ids.size(), 4);
+    WriteTimemapValue(buffer + 20, idTableSize, 4);
+
+    const std::vector<std::string> noElements;
+    int currentTempo = 0;
+    uint32_t index = 0;
+    unsigned char *entry = buffer + headerSize;
+    for (auto &time : realTimeToScoreTime) {
+        auto ittempo = realTimeToTempo.find(time.first);
+        if (ittempo != realTimeToTempo.end()) currentTempo = ittempo->second;
+        auto iton = realTimeToOnElements.find(time.first);
+        const std::vector<std::string> &on = (iton != realTimeToOnElements.end()) ? iton->second : noElements;
+        auto itoff = realTimeToOffElements.find(time.first);
+        const std::vector<std::string> &off = (itoff != realTimeToOffElements.end()) ? itoff->second : noElements;
+
+        WriteTimemapDouble(entry, time.first);
+        WriteTimemapDouble(entry + 8, time.second);
+        WriteTimemapValue(entry + 16, (uint32_t)currentTempo, 4);
+        WriteTimemapValue(entry + 20, index, 4);
+        WriteTimemapValue(entry + 24, on.size(), 4);
+        WriteTimemapValue(entry + 28, off.size(), 4);
+        entry += entrySize;
+
+        for (auto *elements : { &on, &off }) {
+            for (const std::string &id : *elements) {
+                WriteTimemapValue(buffer + indicesOffset + (size_t)index * 4, idPositions.at(id), 4);
+                ++index;
+            }
+        }
+    }
+
+    assert(index == indexCount);
+
+    unsigned char *idTable = buffer + idTableOffset;
+    for (const std::string *id : ids) {
+        // The table is zero-filled and the null terminator is already there
+        memcpy(idTable, id->c_str(), id->size());
+        idTable += id->size() + 1;
+    }
+}
+
 void Doc::PrepareDrawing()
 {
+    // Resetting the drawing marks the measures as modified (e.g., in Chord::ResetDrawing) but their content does not
+    // change - keep the modification flags for the incremental layout
+    ListOfObjects measures;
+    ClassIdComparison isMeasure(MEASURE);
+    this->FindAllDescendantByComparison(&measures, &isMeasure);
+    std::vector<bool> layoutModified;
+    for (Object *object : measures) {
+        layoutModified.push_back(vrv_cast<Measure *>(object)->IsLayoutModified());
+    }
+
     if (m_drawingPreparationDone) {
         Functor resetDrawing(&Object::ResetDrawing);
         this->Process(&resetDrawing, NULL);
@@ -765,6 +1116,11 @@ void Doc::PrepareDrawing()
     Functor scoreDefSetGrpSym(&Object::ScoreDefSetGrpSym);
     m_mdivScoreDef.Process(&scoreDefSetGrpSym, NULL);
 
+    int i = 0;
+    for (Object *object : measures) {
+        if (!layoutModified.at(i++)) vrv_cast<Measure *>(object)->ResetLayoutModified();
+    }
+
     // LogElapsedTimeEnd ("Preparing drawing");
 
     m_drawingPreparationDone = true;
@@ -857,7 +1213,72 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
 
     this->ScoreDefSetCurrentDoc();
 
-    Page *contentPage = this->SetDrawingPage(0);
+    // With progressive breaks, only the first measures are cast off here and the other ones are left on a pending
+    // page. Casting off encoded breaks is fast enough, and the longest duration detection needs the entire content.
+    const bool progressive = m_options->m_breaksProgressive.GetValue() && !(useSb && !usePb && !smart)
+        && !m_options->m_spacingDurDetection.GetValue();
+
+    Page *pendingPage = NULL;
+    for (int measureCount = DOC_PROGRESSIVE_MEASURES;; measureCount *= 2) {
+        if (progressive) pendingPage = this->DetachPendingPage(measureCount);
+        this->CastOffContentPage(useSb, usePb, smart);
+        if (!pendingPage) break;
+        // The last page might continue on the pending measures
+        this->MoveLastPageToPendingPage(pendingPage);
+        if (pages->GetChildCount() > 0) break;
+        // The first page was not filled, try again with more measures
+        pages->AddChild(pendingPage);
+        pendingPage = NULL;
+        this->ScoreDefSetCurrentDoc(true);
+    }
+
+    if (pendingPage) {
+        pages->AddChild(pendingPage);
+        m_isCastOffPending = true;
+        m_castOffPendingSmart = smart;
+    }
+
+    this->ScoreDefSetCurrentDoc(true);
+    if (this->ScoreDefNeedsOptimization()) {
+        this->ScoreDefOptimizeDoc();
+    }
+    this->ScoreDefSetGrpSymDoc();
+}
+
+void Doc::CastOffPendingDoc()
+{
+    if (!m_isCastOffPending) return;
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+    const int previousCount = pages->GetChildCount() - 1;
+
+    // Reset the optimization of the pending page, its content is laid out as a single system
+    if (this->ScoreDefNeedsOptimization()) this->ScoreDefSetCurrentDoc(true);
+    m_isCastOffPending = false;
+    this->CastOffContentPage(false, false, m_castOffPendingSmart);
+
+    this->ScoreDefSetCurrentDoc(true);
+    if (this->ScoreDefNeedsOptimization()) {
+        this->ScoreDefOptimizeDoc();
+    }
+    this->ScoreDefSetGrpSymDoc();
+
+    // The drawing scoreDefs of the pages already laid out have been reset
+    for (int idx = 0; idx < previousCount; ++idx) {
+        Page *page = vrv_cast<Page *>(pages->GetChild(idx));
+        assert(page);
+        page->ResetLayoutDone();
+    }
+}
+
+void Doc::CastOffContentPage(bool useSb, bool usePb, bool smart)
+{
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    const int contentIdx = pages->GetChildCount() - 1;
+    Page *contentPage = this->SetDrawingPage(contentIdx);
     assert(contentPage);
     contentPage->LayOutHorizontally();
 
@@ -877,7 +1298,7 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     else {
         CastOffSystemsParams castOffSystemsParams(contentSystem, contentPage, currentSystem, this, smart);
         castOffSystemsParams.m_systemWidth
-            = m_drawingPageContentWidth - currentSystem->m_systemLeftMar - currentSystem->m_systemRightMar;
+            = this->GetDrawingValues()->m_pageContentWidth - currentSystem->m_systemLeftMar - currentSystem->m_systemRightMar;
         castOffSystemsParams.m_shift = -contentSystem->GetDrawingLabelsWidth();
         castOffSystemsParams.m_currentScoreDefWidth
             = contentPage->m_drawingScoreDef.GetDrawingWidth() + contentSystem->GetDrawingAbbrLabelsWidth();
@@ -904,25 +1325,86 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     contentPage->LayOutVertically();
 
     // Detach the contentPage
-    pages->DetachChild(0);
+    pages->DetachChild(contentIdx);
     assert(contentPage && !contentPage->GetParent());
     this->ResetDrawingPage();
 
+    // The pages already cast off by a progressive cast-off are put back after the running elements are cast off
+    ArrayOfObjects previousPages;
+    while (pages->GetChildCount() > 0) {
+        previousPages.push_back(pages->DetachChild(0));
+    }
+
     Page *currentPage = new Page();
     CastOffPagesParams castOffPagesParams(contentPage, this, currentPage);
     CastOffRunningElements(&castOffPagesParams);
-    castOffPagesParams.m_pageHeight = this->m_drawingPageContentHeight;
+    castOffPagesParams.m_pageHeight = this->GetDrawingValues()->m_pageContentHeight;
     castOffPagesParams.m_leftoverSystem = leftoverSystem;
+    // The first page of the content is then not the first page of the document and starts as a new page would
+    if (!previousPages.empty()) {
+        castOffPagesParams.m_pgHeadHeight = VRV_UNSET;
+        System *firstSystem = vrv_cast<System *>(contentPage->FindDescendantByType(SYSTEM, 1));
+        if (firstSystem) castOffPagesParams.m_shift = firstSystem->GetDrawingYRel() - castOffPagesParams.m_pageHeight;
+    }
+    for (Object *page : previousPages) {
+        pages->AddChild(page);
+    }
     Functor castOffPages(&Object::CastOffPages);
     pages->AddChild(currentPage);
     contentPage->Process(&castOffPages, &castOffPagesParams);
     delete contentPage;
+}
 
-    this->ScoreDefSetCurrentDoc(true);
-    if (optimize) {
-        this->ScoreDefOptimizeDoc();
+Page *Doc::DetachPendingPage(int measureCount)
+{
+    Pages *pages = this->GetPages();
+    assert(pages);
+    assert(pages->GetChildCount() == 1);
+
+    Page *contentPage = vrv_cast<Page *>(pages->GetChild(0));
+    assert(contentPage);
+    System *contentSystem = vrv_cast<System *>(contentPage->GetChild(0));
+    assert(contentSystem);
+
+    // Look for the measure following the first ones
+    int idx = 0;
+    for (int count = 0; idx < contentSystem->GetChildCount(); ++idx) {
+        if (!contentSystem->GetChild(idx)->Is(MEASURE)) continue;
+        if (count == measureCount) break;
+        ++count;
     }
-    this->ScoreDefSetGrpSymDoc();
+    if (idx == contentSystem->GetChildCount()) return NULL;
+
+    Page *pendingPage = new Page();
+    System *pendingSystem = new System();
+    pendingPage->AddChild(pendingSystem);
+    for (int i = idx; i < contentSystem->GetChildCount(); ++i) {
+        pendingSystem->AddChild(contentSystem->Relinquish(i));
+    }
+    contentSystem->ClearRelinquishedChildren();
+
+    return pendingPage;
+}
+
+void Doc::MoveLastPageToPendingPage(Page *pendingPage)
+{
+    assert(pendingPage);
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    System *pendingSystem = vrv_cast<System *>(pendingPage->GetChild(0));
+    assert(pendingSystem);
+
+    Page *lastPage = vrv_cast<Page *>(pages->GetLast());
+    assert(lastPage);
+    int idx = 0;
+    for (Object *system : *lastPage->GetChildren()) {
+        const int childCount = system->GetChildCount();
+        pendingSystem->MoveChildrenFrom(system, idx, true);
+        idx += childCount;
+    }
+    pages->DeleteChild(lastPage);
 }
 
 void Doc::CastOffRunningElements(CastOffPagesParams *params)
@@ -976,6 +1458,7 @@ void Doc::UnCastOffDoc()
     this->Process(&unCastOff, &unCastOffParams);
 
     pages->ClearChildren();
+    m_isCastOffPending = false;
 
     pages->AddChild(contentPage);
 
@@ -987,6 +1470,97 @@ void Doc::UnCastOffDoc()
     this->ScoreDefSetCurrentDoc(true);
 }
 
+bool Doc::LayOutModifiedMeasures()
+{
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    ListOfObjects measures;
+    ClassIdComparison isMeasure(MEASURE);
+    this->FindAllDescendantByComparison(&measures, &isMeasure);
+
+    std::set<Object *> modifiedMeasures;
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        if (measure->IsLayoutModified()) modifiedMeasures.insert(measure);
+    }
+    if (m_isCastOffInvalid) return false;
+
+    // The staves shown in each system can change
+    if (this->ScoreDefNeedsOptimization()) return false;
+
+    // Changes to the score definition affect the following systems
+    ClassIdsComparison isScoreDefChange({ CLEF, KEYSIG, MENSUR, METERSIG, SCOREDEF, STAFFDEF });
+    std::set<int> pageIdxs;
+    for (Object *measure : modifiedMeasures) {
+        if (measure->FindDescendantByComparison(&isScoreDefChange)) return false;
+        Object *page = measure->GetFirstAncestor(PAGE);
+        if (!page) return false;
+        pageIdxs.insert(page->GetIdx());
+    }
+
+    // Spanning elements from or to a modified measure have to be laid out on all the pages they span
+    ListOfObjects spanningElements;
+    InterfaceComparison isSpanning(INTERFACE_TIME_SPANNING);
+    this->FindAllDescendantByComparison(&spanningElements, &isSpanning);
+    for (Object *object : spanningElements) {
+        TimeSpanningInterface *interface = object->GetTimeSpanningInterface();
+        assert(interface);
+        if (!interface->GetStart() || !interface->GetEnd()) continue;
+        std::vector<Object *> ends = { object, interface->GetStart(), interface->GetEnd() };
+        bool isModified = false;
+        int firstIdx = VRV_UNSET;
+        int lastIdx = VRV_UNSET;
+        for (Object *end : ends) {
+            Object *measure = end->GetFirstAncestor(MEASURE);
+            Object *page = end->GetFirstAncestor(PAGE);
+            if (!measure || !page) continue;
+            if (modifiedMeasures.count(measure)) isModified = true;
+            firstIdx = (firstIdx == VRV_UNSET) ? page->GetIdx() : std::min(firstIdx, page->GetIdx());
+            lastIdx = std::max(lastIdx, page->GetIdx());
+        }
+        if (!isModified) continue;
+        for (int idx = firstIdx; idx <= lastIdx; ++idx) pageIdxs.insert(idx);
+    }
+
+    for (int idx = 0; idx < pages->GetChildCount(); ++idx) {
+        Page *page = vrv_cast<Page *>(pages->GetChild(idx));
+        assert(page);
+        // The drawing values of the other pages might have been reset by PrepareDrawing, so their layout is
+        // redone when they are drawn
+        if (!pageIdxs.count(idx)) {
+            page->ResetLayoutDone();
+            continue;
+        }
+        // We need the sizes of a previous layout for checking the cast-off
+        const std::vector<int> layoutSizes = page->GetLayoutSizes();
+        if (layoutSizes.empty()) return false;
+        this->SetDrawingPage(idx);
+        this->ScoreDefSetCurrentDoc();
+        page->LayOut(true);
+        if (page->GetLayoutSizes() != layoutSizes) return false;
+    }
+
+    this->ResetLayoutModified();
+    this->ResetDrawingPage();
+
+    return true;
+}
+
+void Doc::ResetLayoutModified()
+{
+    ListOfObjects measures;
+    ClassIdComparison isMeasure(MEASURE);
+    this->FindAllDescendantByComparison(&measures, &isMeasure);
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        measure->ResetLayoutModified();
+    }
+    m_isCastOffInvalid = false;
+}
+
 void Doc::CastOffEncodingDoc()
 {
     this->ScoreDefSetCurrentDoc();
@@ -1369,13 +1943,67 @@ int Doc::GetPageCount()
     return ((pages) ? pages->GetChildCount() : 0);
 }
 
+Object *Doc::GetIndexedObject(const std::string &uuid)
+{
+    if (m_uuidIndexRevision != Object::GetUuidRevision()) {
+        // Objects were deleted or uuids changed since the last lookup - the caller will walk the tree this time
+        m_uuidIndex.clear();
+        m_uuidIndexRevision = Object::GetUuidRevision();
+        m_uuidIndexBuilt = false;
+        return NULL;
+    }
+
+    if (!m_uuidIndexBuilt) {
+        Functor fillUuidIndex(&Object::FillUuidIndex);
+        FillUuidIndexParams fillUuidIndexParams(&m_uuidIndex);
+        this->Process(&fillUuidIndex, &fillUuidIndexParams, NULL, NULL, UNLIMITED_DEPTH, FORWARD, true);
+        m_uuidIndexBuilt = true;
+    }
+
+    auto it = m_uuidIndex.find(uuid);
+    // The uuid of an object that was moved but not deleted can be changed without the revision being increased
+    if ((it == m_uuidIndex.end()) || (it->second->GetUuid() != uuid)) return NULL;
+    return it->second;
+}
+
+void Doc::AddToUuidIndex(Object *object)
+{
+    assert(object);
+
+    if (!m_uuidIndexBuilt || (m_uuidIndexRevision != Object::GetUuidRevision())) return;
+    m_uuidIndex[object->GetUuid()] = object;
+}
+
+bool Doc::CheckUuidIndex()
+{
+    if (!m_uuidIndexBuilt || (m_uuidIndexRevision != Object::GetUuidRevision())) return true;
+
+    MapOfStrObjects uuidIndex;
+    Functor fillUuidIndex(&Object::FillUuidIndex);
+    FillUuidIndexParams fillUuidIndexParams(&uuidIndex);
+    this->Process(&fillUuidIndex, &fillUuidIndexParams, NULL, NULL, UNLIMITED_DEPTH, FORWARD, true);
+
+    // Objects not indexed yet are fine, but indexed ones have to be the ones found in the tree
+    bool consistent = true;
+    for (auto &pair : m_uuidIndex) {
+        // Skip objects with a changed uuid or no longer in the document since these are never returned
+        if ((pair.second->GetUuid() != pair.first) || (pair.second->GetFirstAncestor(DOC) != this)) continue;
+        auto it = uuidIndex.find(pair.first);
+        if ((it == uuidIndex.end()) || (it->second != pair.second)) {
+            LogDebug("Uuid index mismatch for '%s'", pair.first.c_str());
+            consistent = false;
+        }
+    }
+    return consistent;
+}
+
 int Doc::GetGlyphHeight(wchar_t code, int staffSize, bool graceSize) const
 {
     int x, y, w, h;
-    Glyph *glyph = Resources::GetGlyph(code);
+    const Glyph *glyph = Resources::GetGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
-    h = h * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
+    h = h * this->GetDrawingValues()->m_smuflFontSize / glyph->GetUnitsPerEm();
     if (graceSize) h = h * m_options->m_graceFactor.GetValue();
     h = h * staffSize / 100;
     return h;
@@ -1384,10 +2012,10 @@ int Doc::GetGlyphHeight(wchar_t code, int staffSize, bool graceSize) const
 int Doc::GetGlyphWidth(wchar_t code, int staffSize, bool graceSize) const
 {
     int x, y, w, h;
-    Glyph *glyph = Resources::GetGlyph(code);
+    const Glyph *glyph = Resources::GetGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
-    w = w * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
+    w = w * this->GetDrawingValues()->m_smuflFontSize / glyph->GetUnitsPerEm();
     if (graceSize) w = w * m_options->m_graceFactor.GetValue();
     w = w * staffSize / 100;
     return w;
@@ -1395,10 +2023,10 @@ int Doc::GetGlyphWidth(wchar_t code, int staffSize, bool graceSize) const
 
 int Doc::GetGlyphAdvX(wchar_t code, int staffSize, bool graceSize) const
 {
-    Glyph *glyph = Resources::GetGlyph(code);
+    const Glyph *glyph = Resources::GetGlyph(code);
     assert(glyph);
     int advX = glyph->GetHorizAdvX();
-    advX = advX * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
+    advX = advX * this->GetDrawingValues()->m_smuflFontSize / glyph->GetUnitsPerEm();
     if (graceSize) advX = advX * m_options->m_graceFactor.GetValue();
     advX = advX * staffSize / 100;
     return advX;
@@ -1409,8 +2037,8 @@ Point Doc::ConvertFontPoint(const Glyph *glyph, const Point &fontPoint, int staf
     assert(glyph);
 
     Point point;
-    point.x = fontPoint.x * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
-    point.y = fontPoint.y * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
+    point.x = fontPoint.x * this->GetDrawingValues()->m_smuflFontSize / glyph->GetUnitsPerEm();
+    point.y = fontPoint.y * this->GetDrawingValues()->m_smuflFontSize / glyph->GetUnitsPerEm();
     if (graceSize) {
         point.x = point.x * m_options->m_graceFactor.GetValue();
         point.y = point.y * m_options->m_graceFactor.GetValue();
@@ -1425,10 +2053,10 @@ Point Doc::ConvertFontPoint(const Glyph *glyph, const Point &fontPoint, int staf
 int Doc::GetGlyphDescender(wchar_t code, int staffSize, bool graceSize) const
 {
     int x, y, w, h;
-    Glyph *glyph = Resources::GetGlyph(code);
+    const Glyph *glyph = Resources::GetGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
-    y = y * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
+    y = y * this->GetDrawingValues()->m_smuflFontSize / glyph->GetUnitsPerEm();
     if (graceSize) y = y * m_options->m_graceFactor.GetValue();
     y = y * staffSize / 100;
     return y;
@@ -1439,7 +2067,7 @@ int Doc::GetTextGlyphHeight(wchar_t code, FontInfo *font, bool graceSize) const
     assert(font);
 
     int x, y, w, h;
-    Glyph *glyph = Resources::GetTextGlyph(code);
+    const Glyph *glyph = Resources::GetTextGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
     h = h * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1452,7 +2080,7 @@ int Doc::GetTextGlyphWidth(wchar_t code, FontInfo *font, bool graceSize) const
     assert(font);
 
     int x, y, w, h;
-    Glyph *glyph = Resources::GetTextGlyph(code);
+    const Glyph *glyph = Resources::GetTextGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
     w = w * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1464,7 +2092,7 @@ int Doc::GetTextGlyphAdvX(wchar_t code, FontInfo *font, bool graceSize) const
 {
     assert(font);
 
-    Glyph *glyph = Resources::GetTextGlyph(code);
+    const Glyph *glyph = Resources::GetTextGlyph(code);
     assert(glyph);
     int advX = glyph->GetHorizAdvX();
     advX = advX * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1477,7 +2105,7 @@ int Doc::GetTextGlyphDescender(wchar_t code, FontInfo *font, bool graceSize) con
     assert(font);
 
     int x, y, w, h;
-    Glyph *glyph = Resources::GetTextGlyph(code);
+    const Glyph *glyph = Resources::GetTextGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
     y = y * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1523,7 +2151,7 @@ int Doc::GetDrawingOctaveSize(int staffSize) const
 
 int Doc::GetDrawingBrevisWidth(int staffSize) const
 {
-    return m_drawingBrevisWidth * staffSize / 100;
+    return this->GetDrawingValues()->m_brevisWidth * staffSize / 100;
 }
 
 int Doc::GetDrawingBarLineWidth(int staffSize) const
@@ -1559,21 +2187,21 @@ int Doc::GetDrawingHairpinSize(int staffSize, bool withMargin) const
 
 int Doc::GetDrawingBeamWidth(int staffSize, bool graceSize) const
 {
-    int value = m_drawingBeamWidth * staffSize / 100;
+    int value = this->GetDrawingValues()->m_beamWidth * staffSize / 100;
     if (graceSize) value = value * m_options->m_graceFactor.GetValue();
     return value;
 }
 
 int Doc::GetDrawingBeamWhiteWidth(int staffSize, bool graceSize) const
 {
-    int value = m_drawingBeamWhiteWidth * staffSize / 100;
+    int value = this->GetDrawingValues()->m_beamWhiteWidth * staffSize / 100;
     if (graceSize) value = value * m_options->m_graceFactor.GetValue();
     return value;
 }
 
 int Doc::GetDrawingLedgerLineLength(int staffSize, bool graceSize) const
 {
-    int value = m_drawingLedgerLine * staffSize / 100;
+    int value = this->GetDrawingValues()->m_ledgerLine * staffSize / 100;
     if (graceSize) value = value * m_options->m_graceFactor.GetValue();
     return value;
 }
@@ -1590,17 +2218,19 @@ double Doc::GetCueScaling() const
 
 FontInfo *Doc::GetDrawingSmuflFont(int staffSize, bool graceSize)
 {
-    m_drawingSmuflFont.SetFaceName(m_options->m_font.GetValue().c_str());
-    int value = m_drawingSmuflFontSize * staffSize / 100;
+    DrawingPageValues *values = this->GetDrawingValues();
+    values->m_smuflFont.SetFaceName(m_options->m_font.GetValue().c_str());
+    int value = values->m_smuflFontSize * staffSize / 100;
     if (graceSize) value = value * m_options->m_graceFactor.GetValue();
-    m_drawingSmuflFont.SetPointSize(value);
-    return &m_drawingSmuflFont;
+    values->m_smuflFont.SetPointSize(value);
+    return &values->m_smuflFont;
 }
 
 FontInfo *Doc::GetDrawingLyricFont(int staffSize)
 {
-    m_drawingLyricFont.SetPointSize(m_drawingLyricFontSize * staffSize / 100);
-    return &m_drawingLyricFont;
+    DrawingPageValues *values = this->GetDrawingValues();
+    values->m_lyricFont.SetPointSize(values->m_lyricFontSize * staffSize / 100);
+    return &values->m_lyricFont;
 }
 
 double Doc::GetLeftMargin(const ClassId classId) const
@@ -1715,80 +2345,193 @@ Page *Doc::SetDrawingPage(int pageIdx)
     if (!HasPage(pageIdx)) {
         return NULL;
     }
+    DrawingPageValues *values = this->GetDrawingValues();
     // nothing to do
-    if (m_drawingPage && m_drawingPage->GetIdx() == pageIdx) {
-        return m_drawingPage;
+    if (values->m_page && values->m_page->GetIdx() == pageIdx) {
+        return values->m_page;
     }
     Pages *pages = this->GetPages();
     assert(pages);
-    m_drawingPage = vrv_cast<Page *>(pages->GetChild(pageIdx));
-    assert(m_drawingPage);
+    values->m_page = vrv_cast<Page *>(pages->GetChild(pageIdx));
+    assert(values->m_page);
 
     int glyph_size;
 
     // we use the page members only if set (!= -1)
-    if (m_drawingPage->m_pageHeight != -1) {
-        m_drawingPageHeight = m_drawingPage->m_pageHeight;
-        m_drawingPageWidth = m_drawingPage->m_pageWidth;
-        m_drawingPageMarginBottom = m_drawingPage->m_pageMarginBottom;
-        m_drawingPageMarginLeft = m_drawingPage->m_pageMarginLeft;
-        m_drawingPageMarginRight = m_drawingPage->m_pageMarginRight;
-        m_drawingPageMarginTop = m_drawingPage->m_pageMarginTop;
+    if (values->m_page->m_pageHeight != -1) {
+        values->m_pageHeight = values->m_page->m_pageHeight;
+        values->m_pageWidth = values->m_page->m_pageWidth;
+        values->m_pageMarginBottom = values->m_page->m_pageMarginBottom;
+        values->m_pageMarginLeft = values->m_page->m_pageMarginLeft;
+        values->m_pageMarginRight = values->m_page->m_pageMarginRight;
+        values->m_pageMarginTop = values->m_page->m_pageMarginTop;
     }
     else if (m_pageHeight != -1) {
-        m_drawingPageHeight = m_pageHeight;
-        m_drawingPageWidth = m_pageWidth;
-        m_drawingPageMarginBottom = m_pageMarginBottom;
-        m_drawingPageMarginLeft = m_pageMarginLeft;
-        m_drawingPageMarginRight = m_pageMarginRight;
-        m_drawingPageMarginTop = m_pageMarginTop;
+        values->m_pageHeight = m_pageHeight;
+        values->m_pageWidth = m_pageWidth;
+        values->m_pageMarginBottom = m_pageMarginBottom;
+        values->m_pageMarginLeft = m_pageMarginLeft;
+        values->m_pageMarginRight = m_pageMarginRight;
+        values->m_pageMarginTop = m_pageMarginTop;
     }
     else {
-        m_drawingPageHeight = m_options->m_pageHeight.GetValue();
-        m_drawingPageWidth = m_options->m_pageWidth.GetValue();
-        m_drawingPageMarginBottom = m_options->m_pageMarginBottom.GetValue();
-        m_drawingPageMarginLeft = m_options->m_pageMarginLeft.GetValue();
-        m_drawingPageMarginRight = m_options->m_pageMarginRight.GetValue();
-        m_drawingPageMarginTop = m_options->m_pageMarginTop.GetValue();
+        values->m_pageHeight = m_options->m_pageHeight.GetValue();
+        values->m_pageWidth = m_options->m_pageWidth.GetValue();
+        values->m_pageMarginBottom = m_options->m_pageMarginBottom.GetValue();
+        values->m_pageMarginLeft = m_options->m_pageMarginLeft.GetValue();
+        values->m_pageMarginRight = m_options->m_pageMarginRight.GetValue();
+        values->m_pageMarginTop = m_options->m_pageMarginTop.GetValue();
     }
 
     if (m_options->m_landscape.GetValue()) {
-        int pageHeight = m_drawingPageWidth;
-        m_drawingPageWidth = m_drawingPageHeight;
-        m_drawingPageHeight = pageHeight;
-        int pageMarginRight = m_drawingPageMarginLeft;
-        m_drawingPageMarginLeft = m_drawingPageMarginRight;
-        m_drawingPageMarginRight = pageMarginRight;
+        int pageHeight = values->m_pageWidth;
+        values->m_pageWidth = values->m_pageHeight;
+        values->m_pageHeight = pageHeight;
+        int pageMarginRight = values->m_pageMarginLeft;
+        values->m_pageMarginLeft = values->m_pageMarginRight;
+        values->m_pageMarginRight = pageMarginRight;
     }
 
-    m_drawingPageContentHeight = m_drawingPageHeight - m_drawingPageMarginTop - m_drawingPageMarginBottom;
-    m_drawingPageContentWidth = m_drawingPageWidth - m_drawingPageMarginLeft - m_drawingPageMarginRight;
+    values->m_pageContentHeight = values->m_pageHeight - values->m_pageMarginTop - values->m_pageMarginBottom;
+    values->m_pageContentWidth = values->m_pageWidth - values->m_pageMarginLeft - values->m_pageMarginRight;
 
     // From here we could check if values have changed
     // Since m_options->m_interlDefin stays the same, it's useless to do it
     // every time for now.
 
-    m_drawingBeamMaxSlope = m_options->m_beamMaxSlope.GetValue();
-    m_drawingBeamMinSlope = m_options->m_beamMinSlope.GetValue();
-    m_drawingBeamMaxSlope /= 100;
-    m_drawingBeamMinSlope /= 100;
+    values->m_beamMaxSlope = m_options->m_beamMaxSlope.GetValue();
+    values->m_beamMinSlope = m_options->m_beamMinSlope.GetValue();
+    values->m_beamMaxSlope /= 100;
+    values->m_beamMinSlope /= 100;
 
     // values for beams
-    m_drawingBeamWidth = m_options->m_unit.GetValue();
-    m_drawingBeamWhiteWidth = m_options->m_unit.GetValue() / 2;
+    values->m_beamWidth = m_options->m_unit.GetValue();
+    values->m_beamWhiteWidth = m_options->m_unit.GetValue() / 2;
 
     // values for fonts
-    m_drawingSmuflFontSize = CalcMusicFontSize();
-    m_drawingLyricFontSize = m_options->m_unit.GetValue() * m_options->m_lyricSize.GetValue();
+    values->m_smuflFontSize = CalcMusicFontSize();
+    values->m_lyricFontSize = m_options->m_unit.GetValue() * m_options->m_lyricSize.GetValue();
 
     glyph_size = GetGlyphWidth(SMUFL_E0A3_noteheadHalf, 100, 0);
-    m_drawingLedgerLine = glyph_size * 72 / 100;
+    values->m_ledgerLine = glyph_size * 72 / 100;
 
     glyph_size = GetGlyphWidth(SMUFL_E0A2_noteheadWhole, 100, 0);
 
-    m_drawingBrevisWidth = (int)((glyph_size * 0.8) / 2);
+    values->m_brevisWidth = (int)((glyph_size * 0.8) / 2);
+
+    return values->m_page;
+}
+
+void Doc::SetThreadDrawingValues(DrawingPageValues *drawingValues)
+{
+    s_threadDrawingDoc = (drawingValues) ? this : NULL;
+    s_threadDrawingValues = drawingValues;
+}
+
+void Doc::CopyRunningElements(DrawingPageValues *drawingValues)
+{
+    assert(drawingValues);
+
+    // Keep the uuids of the original since they appear in the output
+    std::function<void(Object *, Object *)> copyUuids = [&copyUuids](Object *original, Object *copy) {
+        copy->SetUuid(original->GetUuid());
+        if (original->Is(NUM)) {
+            Num *originalNum = vrv_cast<Num *>(original);
+            assert(originalNum);
+            Num *copyNum = vrv_cast<Num *>(copy);
+            assert(copyNum);
+            copyNum->GetCurrentText()->SetParent(copyNum);
+            copyNum->GetCurrentText()->SetUuid(originalNum->GetCurrentText()->GetUuid());
+        }
+        const ArrayOfObjects *originalChildren = original->GetChildren();
+        const ArrayOfObjects *copyChildren = copy->GetChildren();
+        assert(originalChildren->size() == copyChildren->size());
+        for (int i = 0; i < (int)originalChildren->size(); ++i) {
+            copyUuids(originalChildren->at(i), copyChildren->at(i));
+        }
+    };
+
+    if (PgHead *pgHead = m_mdivScoreDef.GetPgHead()) {
+        drawingValues->m_runningElements[pgHead] = new PgHead(*pgHead);
+    }
+    if (PgHead2 *pgHead2 = m_mdivScoreDef.GetPgHead2()) {
+        drawingValues->m_runningElements[pgHead2] = new PgHead2(*pgHead2);
+    }
+    if (PgFoot *pgFoot = m_mdivScoreDef.GetPgFoot()) {
+        drawingValues->m_runningElements[pgFoot] = new PgFoot(*pgFoot);
+    }
+    if (PgFoot2 *pgFoot2 = m_mdivScoreDef.GetPgFoot2()) {
+        drawingValues->m_runningElements[pgFoot2] = new PgFoot2(*pgFoot2);
+    }
+    for (auto &runningElement : drawingValues->m_runningElements) {
+        copyUuids(runningElement.first, runningElement.second);
+    }
+}
+
+RunningElement *Doc::GetDrawingRunningElement(RunningElement *runningElement)
+{
+    if (!runningElement) return NULL;
+
+    const DrawingPageValues *drawingValues = this->GetDrawingValues();
+    auto copy = drawingValues->m_runningElements.find(runningElement);
+    return (copy != drawingValues->m_runningElements.end()) ? copy->second : runningElement;
+}
+
+std::vector<std::pair<int, int>> Doc::GetIndependentPageRanges()
+{
+    std::vector<std::pair<int, int>> ranges;
+    const int pageCount = this->GetPageCount();
+    if (pageCount == 0) return ranges;
+
+    // For each page, true if it shares elements with the next page
+    std::vector<bool> linkedToNext(pageCount, false);
+    auto linkPages = [&linkedToNext](const std::vector<Object *> &objects) {
+        int firstIdx = VRV_UNSET;
+        int lastIdx = VRV_UNSET;
+        for (Object *object : objects) {
+            Object *page = (object) ? object->GetFirstAncestor(PAGE) : NULL;
+            if (!page) continue;
+            firstIdx = (firstIdx == VRV_UNSET) ? page->GetIdx() : std::min(firstIdx, page->GetIdx());
+            lastIdx = std::max(lastIdx, page->GetIdx());
+        }
+        for (int idx = firstIdx; idx < lastIdx; ++idx) linkedToNext.at(idx) = true;
+    };
+
+    ListOfObjects spanningElements;
+    InterfaceComparison isSpanning(INTERFACE_TIME_SPANNING);
+    this->FindAllDescendantByComparison(&spanningElements, &isSpanning);
+    for (Object *object : spanningElements) {
+        TimeSpanningInterface *interface = object->GetTimeSpanningInterface();
+        assert(interface);
+        linkPages({ object, interface->GetStart(), interface->GetEnd() });
+    }
+
+    ListOfObjects linkedElements;
+    InterfaceComparison isLinking(INTERFACE_LINKING);
+    this->FindAllDescendantByComparison(&linkedElements, &isLinking);
+    for (Object *object : linkedElements) {
+        LinkingInterface *interface = object->GetLinkingInterface();
+        assert(interface);
+        linkPages({ object, interface->GetNextLink() });
+    }
+
+    ListOfObjects endings;
+    ClassIdComparison isEnding(ENDING);
+    this->FindAllDescendantByComparison(&endings, &isEnding);
+    for (Object *object : endings) {
+        Ending *ending = vrv_cast<Ending *>(object);
+        assert(ending);
+        linkPages({ ending, ending->GetEnd() });
+    }
+
+    int firstIdx = 0;
+    for (int idx = 0; idx < pageCount; ++idx) {
+        if (linkedToNext.at(idx)) continue;
+        ranges.push_back({ firstIdx, idx });
+        firstIdx = idx + 1;
+    }
 
-    return m_drawingPage;
+    return ranges;
 }
 
 int Doc::CalcMusicFontSize()
@@ -1798,26 +2541,28 @@ int Doc::CalcMusicFontSize()
 
 int Doc::GetAdjustedDrawingPageHeight() const
 {
-    assert(m_drawingPage);
+    const DrawingPageValues *values = this->GetDrawingValues();
+    assert(values->m_page);
 
     if ((this->GetType() == Transcription) || (this->GetType() == Facs)) {
-        return m_drawingPage->m_pageHeight / DEFINITION_FACTOR;
+        return values->m_page->m_pageHeight / DEFINITION_FACTOR;
     }
 
-    int contentHeight = m_drawingPage->GetContentHeight();
-    return (contentHeight + m_drawingPageMarginTop + m_drawingPageMarginBottom) / DEFINITION_FACTOR;
+    int contentHeight = values->m_page->GetContentHeight();
+    return (contentHeight + values->m_pageMarginTop + values->m_pageMarginBottom) / DEFINITION_FACTOR;
 }
 
 int Doc::GetAdjustedDrawingPageWidth() const
 {
-    assert(m_drawingPage);
+    const DrawingPageValues *values = this->GetDrawingValues();
+    assert(values->m_page);
 
     if ((this->GetType() == Transcription) || (this->GetType() == Facs)) {
-        return m_drawingPage->m_pageWidth / DEFINITION_FACTOR;
+        return values->m_page->m_pageWidth / DEFINITION_FACTOR;
     }
 
-    int contentWidth = m_drawingPage->GetContentWidth();
-    return (contentWidth + m_drawingPageMarginLeft + m_drawingPageMarginRight) / DEFINITION_FACTOR;
+    int contentWidth = values->m_page->GetContentWidth();
+    return (contentWidth + values->m_pageMarginLeft + values->m_pageMarginRight) / DEFINITION_FACTOR;
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,265 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        editortoolkit.cpp
+// Author:      Laurent Pugin, Juliette Regimbal
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "editortoolkit.h"
+
+//--------------------------------------------------------------------------------
+
+#include "comparison.h"
+#include "facsimile.h"
+#include "facsimileinterface.h"
+#include "surface.h"
+#include "vrv.h"
+
+//--------------------------------------------------------------------------------
+
+/** The maximum number of steps kept for undo */
+#define EDITOR_UNDO_STEPS 100
+
+namespace vrv {
+
+//--------------------------------------------------------------------------------
+// EditorUndoStep
+//--------------------------------------------------------------------------------
+
+EditorUndoStep::~EditorUndoStep()
+{
+    for (auto &operation : m_operations) {
+        if (operation.second) delete operation.second;
+    }
+}
+
+//--------------------------------------------------------------------------------
+// EditorToolkit
+//--------------------------------------------------------------------------------
+
+/**
+ * Give the uuids of an object and its descendants to its copy.
+ * Return false if the copy does not have the same structure.
+ */
+static bool CopyUuids(Object *object, Object *copy)
+{
+    if ((object->GetClassId() != copy->GetClassId()) || (object->GetChildCount() != copy->GetChildCount())) {
+        return false;
+    }
+    copy->SetUuid(object->GetUuid());
+    for (int i = 0; i < object->GetChildCount(); ++i) {
+        if (!CopyUuids(object->GetChild(i), copy->GetChild(i))) return false;
+    }
+    return true;
+}
+
+EditorToolkit::~EditorToolkit()
+{
+    if (m_currentStep) delete m_currentStep;
+    for (auto &step : m_undoSteps) {
+        delete step;
+    }
+}
+
+bool EditorToolkit::EndAction()
+{
+    if (!m_inTransaction) this->CloseCurrentStep();
+
+    bool redoLayout = m_redoLayout;
+    m_redoLayout = false;
+    return redoLayout;
+}
+
+bool EditorToolkit::BeginTransaction()
+{
+    if (m_inTransaction) {
+        LogWarning("A transaction is already open");
+        return false;
+    }
+
+    // Actions performed before in the same chain make their own step
+    this->CloseCurrentStep();
+    m_inTransaction = true;
+    m_drawingDeferred = false;
+    return true;
+}
+
+bool EditorToolkit::CommitTransaction()
+{
+    if (!m_inTransaction) {
+        LogWarning("No transaction to commit");
+        return false;
+    }
+
+    m_inTransaction = false;
+    this->CloseCurrentStep();
+
+    // Update the drawing once for all the actions of the transaction
+    if (m_drawingDeferred) this->RedoDrawing();
+    m_drawingDeferred = false;
+    return true;
+}
+
+bool EditorToolkit::Undo()
+{
+    // Undoing within a transaction rolls it back
+    m_inTransaction = false;
+    m_drawingDeferred = false;
+    this->CloseCurrentStep();
+
+    if (m_undoSteps.empty()) {
+        LogWarning("Nothing to undo");
+        return false;
+    }
+
+    EditorUndoStep *step = m_undoSteps.back();
+    m_undoSteps.pop_back();
+
+    bool castOffInvalid = false;
+    for (auto it = step->m_operations.rbegin(); it != step->m_operations.rend(); ++it) {
+        Object *current = m_doc->FindDescendantByUuid(it->first);
+        if (!current || !current->GetParent()) {
+            if (it->second) LogWarning("Element '%s' could not be restored", it->first.c_str());
+            continue;
+        }
+        Object *parent = current->GetParent();
+        if (!current->Is(MEASURE) && !current->GetFirstAncestor(MEASURE)) castOffInvalid = true;
+        // Remove an object created in the step
+        if (!it->second) {
+            parent->DeleteChild(current);
+            continue;
+        }
+        // Swap the current object with its copy - the copy is now owned by the document
+        parent->ReplaceChild(current, it->second);
+        it->second = NULL;
+        delete current;
+    }
+
+    // Zones are not part of the objects saved and are restored separately
+    if (m_doc->GetType() == Facs && m_doc->HasFacsimile()) {
+        Facsimile *facsimile = m_doc->GetFacsimile();
+        for (auto &zone : step->m_zones) {
+            Zone *current = facsimile->FindZoneByUuid(zone.first);
+            if (current) current->AttCoordinated::operator=(zone.second);
+        }
+        // The zones added in the step are no longer used
+        Surface *surface = vrv_cast<Surface *>(facsimile->FindDescendantByType(SURFACE));
+        if (surface && (step->m_surfaceZoneCount != -1)) {
+            while (surface->GetChildCount() > step->m_surfaceZoneCount) {
+                surface->DeleteChild(surface->GetLast());
+            }
+        }
+    }
+
+    delete step;
+    m_doc->InvalidateMidiTimemap();
+
+    // The objects restored need their drawing staffDef values (unless the layout comes from the facsimile)
+    if (m_doc->GetType() != Facs) m_doc->ScoreDefSetCurrentDoc(true);
+    // Modifications outside measures are not tracked for the incremental layout
+    if (castOffInvalid) m_doc->InvalidateCastOff();
+    this->RedoDrawing();
+    return true;
+}
+
+bool EditorToolkit::SaveForUndo(Object *object)
+{
+    assert(object);
+
+    // The object is about to be modified
+    m_doc->InvalidateMidiTimemap();
+    if (m_inTransaction) m_drawingDeferred = true;
+    EditorUndoStep *step = this->GetCurrentStep();
+
+    // Nothing to do if the object will be restored with an ancestor or removed
+    for (Object *ancestor = object; ancestor; ancestor = ancestor->GetParent()) {
+        if (step->m_uuids.count(ancestor->GetUuid())) return true;
+    }
+
+    if (!object->GetParent() || object->Is({ DOC, PAGES, PAGE, SYSTEM, SCORE })) {
+        LogWarning("Modifications of '%s' cannot be undone", object->GetUuid().c_str());
+        return false;
+    }
+
+    Object *copy = object->Clone();
+    if (copy) copy->CloneReset();
+    if (!copy || !CopyUuids(object, copy)) {
+        LogWarning("Modifications of '%s' cannot be undone", object->GetUuid().c_str());
+        if (copy) delete copy;
+        return false;
+    }
+
+    step->m_operations.push_back({ object->GetUuid(), copy });
+    step->m_uuids.insert(object->GetUuid());
+
+    // The copy shares the zones of the object and their coordinates are saved separately
+    if (m_doc->GetType() == Facs) {
+        ListOfObjects objects;
+        InterfaceComparison comparison(INTERFACE_FACSIMILE);
+        object->FindAllDescendantByComparison(&objects, &comparison);
+        if (object->HasInterface(INTERFACE_FACSIMILE)) objects.push_front(object);
+        for (auto &element : objects) {
+            Zone *zone = element->GetFacsimileInterface()->GetZone();
+            if (zone) step->m_zones.emplace(zone->GetUuid(), *zone);
+        }
+    }
+
+    return true;
+}
+
+void EditorToolkit::SaveCreatedForUndo(Object *object)
+{
+    assert(object);
+
+    m_doc->InvalidateMidiTimemap();
+    if (m_inTransaction) m_drawingDeferred = true;
+    EditorUndoStep *step = this->GetCurrentStep();
+    step->m_operations.push_back({ object->GetUuid(), NULL });
+    step->m_uuids.insert(object->GetUuid());
+}
+
+void EditorToolkit::UpdateDrawing()
+{
+    if (m_inTransaction) {
+        m_drawingDeferred = true;
+        return;
+    }
+    this->RedoDrawing();
+}
+
+void EditorToolkit::RedoDrawing()
+{
+    m_doc->PrepareDrawing();
+    m_redoLayout = true;
+}
+
+EditorUndoStep *EditorToolkit::GetCurrentStep()
+{
+    if (m_currentStep) return m_currentStep;
+
+    m_currentStep = new EditorUndoStep();
+    if (m_doc->GetType() == Facs && m_doc->HasFacsimile()) {
+        Object *surface = m_doc->GetFacsimile()->FindDescendantByType(SURFACE);
+        if (surface) m_currentStep->m_surfaceZoneCount = surface->GetChildCount();
+    }
+    return m_currentStep;
+}
+
+void EditorToolkit::CloseCurrentStep()
+{
+    if (!m_currentStep) return;
+
+    if (m_currentStep->IsEmpty()) {
+        delete m_currentStep;
+    }
+    else {
+        m_undoSteps.push_back(m_currentStep);
+        if ((int)m_undoSteps.size() > EDITOR_UNDO_STEPS) {
+            delete m_undoSteps.front();
+            m_undoSteps.erase(m_undoSteps.begin());
+        }
+    }
+    m_currentStep = NULL;
+}
+
+} // namespace vrv
@@ -63,11 +63,19 @@ bool EditorToolkitCMN::ParseEditorAction(const std::string &json_editorAction, b
 
     std::string action = json.get<jsonxx::String>("action");
 
-    // Action without parameter
+    // Actions without parameter
     if (action == "commit") {
+        // Committing a transaction also has the layout redone
+        if (this->IsInTransaction()) return this->CommitTransaction();
         m_doc->PrepareDrawing();
         return true;
     }
+    else if (action == "begin") {
+        return (commitOnly) ? false : this->BeginTransaction();
+    }
+    else if (action == "undo") {
+        return (commitOnly) ? false : this->Undo();
+    }
 
     if (commitOnly) {
         // Only process commit actions
@@ -219,6 +227,8 @@ bool EditorToolkitCMN::Delete(std::string &elementId)
     if (!element) return false;
 
     if (element->Is(NOTE)) {
+        Object *layer = element->GetFirstAncestor(LAYER);
+        if (layer) this->SaveForUndo(layer);
         return this->DeleteNote(dynamic_cast<Note *>(element));
     }
     return false;
@@ -236,8 +246,10 @@ bool EditorToolkitCMN::Drag(std::string &elementId, int x, int y)
         int oct;
         data_PITCHNAME pname
             = (data_PITCHNAME)m_view->CalculatePitchCode(layer, m_view->ToLogicalY(y), element->GetDrawingX(), &oct);
+        this->SaveForUndo(element);
         element->GetPitchInterface()->SetPname(pname);
         element->GetPitchInterface()->SetOct(oct);
+        element->Modify();
 
         return true;
     }
@@ -259,7 +271,9 @@ bool EditorToolkitCMN::KeyDown(std::string &elementId, int key, bool shiftKey, b
             case KEY_DOWN: step = -1; break;
             default: step = 0;
         }
+        this->SaveForUndo(element);
         interface->AdjustPitchByOffset(step);
+        element->Modify();
         return true;
     }
     return false;
@@ -310,6 +324,7 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
     measure->AddChild(element);
     interface->SetStartid("#" + startid);
     interface->SetEndid("#" + endid);
+    this->SaveCreatedForUndo(element);
 
     m_chainedId = element->GetUuid();
     m_editInfo.import("uuid", element->GetUuid());
@@ -328,6 +343,8 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
         return false;
     }
     if (elementType == "note") {
+        Object *layer = start->GetFirstAncestor(LAYER);
+        if (layer) this->SaveForUndo(layer);
         return this->InsertNote(start);
     }
     // Check if it is a LayerElement
@@ -356,6 +373,7 @@ bool EditorToolkitCMN::Insert(std::string &elementType, std::string const &start
     assert(interface);
     measure->AddChild(element);
     interface->SetStartid("#" + startid);
+    this->SaveCreatedForUndo(element);
 
     m_chainedId = element->GetUuid();
     m_editInfo.import("uuid", element->GetUuid());
@@ -368,6 +386,7 @@ bool EditorToolkitCMN::Set(std::string &elementId, std::string const &attribute,
     Object *element = this->GetElement(elementId);
     if (!element) return false;
 
+    this->SaveForUndo(element);
     bool success = false;
     if (Att::SetAnalytical(element, attribute, value))
         success = true;
@@ -398,6 +417,9 @@ bool EditorToolkitCMN::Set(std::string &elementId, std::string const &attribute,
     else if (Att::SetVisual(element, attribute, value))
         success = true;
     if (success) {
+        element->Modify();
+        // Modifications outside measures are not tracked for the incremental layout
+        if (!element->GetFirstAncestor(MEASURE)) m_doc->InvalidateCastOff();
         return true;
     }
     return false;
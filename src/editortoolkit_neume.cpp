@@ -53,6 +53,26 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         return false;
     }
 
+    // Actions without parameter
+    if (json.has<jsonxx::String>("action")) {
+        std::string action = json.get<jsonxx::String>("action");
+        bool success = false;
+        if (action == "begin") {
+            success = this->BeginTransaction();
+        }
+        else if (action == "commit") {
+            success = this->CommitTransaction();
+        }
+        else if (action == "undo") {
+            success = this->Undo();
+        }
+        if (action == "begin" || action == "commit" || action == "undo") {
+            m_infoObject.import("status", success ? "OK" : "FAILURE");
+            m_infoObject.import("message", success ? "" : "Action " + action + " could not be performed.");
+            return success;
+        }
+    }
+
     if (!json.has<jsonxx::String>("action")
         || (!json.has<jsonxx::Object>("param") && !json.has<jsonxx::Array>("param"))) {
         LogWarning("Incorrectly formatted JSON action");
@@ -74,6 +94,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::string elementId;
         int x, y;
         if (this->ParseDragAction(json.get<jsonxx::Object>("param"), &elementId, &x, &y)) {
+            this->SaveElementForUndo(elementId, false);
             return this->Drag(elementId, x, y);
         }
         LogWarning("Could not parse the drag action");
@@ -84,6 +105,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::vector<std::pair<std::string, std::string>> attributes;
         if (this->ParseInsertAction(
                 json.get<jsonxx::Object>("param"), &elementType, &staffId, &ulx, &uly, &lrx, &lry, &attributes)) {
+            this->SaveElementForUndo(staffId, true);
             return this->Insert(elementType, staffId, ulx, uly, lrx, lry, attributes);
         }
         LogWarning("Could not parse the insert action");
@@ -91,6 +113,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
     else if (action == "set") {
         std::string elementId, attrType, attrValue;
         if (this->ParseSetAction(json.get<jsonxx::Object>("param"), &elementId, &attrType, &attrValue)) {
+            this->SaveElementForUndo(elementId, false);
             return this->Set(elementId, attrType, attrValue);
         }
         LogWarning("Could not parse the set action");
@@ -98,6 +121,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
     else if (action == "setText") {
         std::string elementId, text;
         if (this->ParseSetTextAction(json.get<jsonxx::Object>("param"), &elementId, &text)) {
+            this->SaveElementForUndo(elementId, false);
             return this->SetText(elementId, text);
         }
         LogWarning("Could not parse the set text action");
@@ -105,6 +129,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
     else if (action == "setClef") {
         std::string elementId, shape;
         if (this->ParseSetClefAction(json.get<jsonxx::Object>("param"), &elementId, &shape)) {
+            this->SaveElementForUndo(elementId, true);
             return this->SetClef(elementId, shape);
         }
         LogWarning("Could not parse the set clef action");
@@ -112,6 +137,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
     else if (action == "remove") {
         std::string elementId;
         if (this->ParseRemoveAction(json.get<jsonxx::Object>("param"), &elementId)) {
+            this->SaveElementForUndo(elementId, true);
             return this->Remove(elementId);
         }
         LogWarning("Could not parse the remove action");
@@ -120,6 +146,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::string elementId;
         int ulx, uly, lrx, lry;
         if (this->ParseResizeAction(json.get<jsonxx::Object>("param"), &elementId, &ulx, &uly, &lrx, &lry)) {
+            this->SaveElementForUndo(elementId, false);
             return this->Resize(elementId, ulx, uly, lrx, lry);
         }
         LogWarning("Could not parse the resize action");
@@ -130,6 +157,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         float rotate;
         if (this->ParseResizeRotateAction(
                 json.get<jsonxx::Object>("param"), &elementId, &ulx, &uly, &lrx, &lry, &rotate)) {
+            this->SaveElementForUndo(elementId, false);
             return this->Resize(elementId, ulx, uly, lrx, lry, rotate);
         }
     }
@@ -144,6 +172,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::string groupType;
         std::vector<std::string> elementIds;
         if (this->ParseGroupAction(json.get<jsonxx::Object>("param"), &groupType, &elementIds)) {
+            if (!elementIds.empty()) this->SaveElementForUndo(elementIds.front(), true);
             return this->Group(groupType, elementIds);
         }
     }
@@ -151,12 +180,14 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::string groupType;
         std::vector<std::string> elementIds;
         if (this->ParseUngroupAction(json.get<jsonxx::Object>("param"), &groupType, &elementIds)) {
+            if (!elementIds.empty()) this->SaveElementForUndo(elementIds.front(), true);
             return this->Ungroup(groupType, elementIds);
         }
     }
     else if (action == "merge") {
         std::vector<std::string> elementIds;
         if (this->ParseMergeAction(json.get<jsonxx::Object>("param"), &elementIds)) {
+            if (!elementIds.empty()) this->SaveElementForUndo(elementIds.front(), true);
             return this->Merge(elementIds);
         }
         LogWarning("Could not parse merge action");
@@ -165,6 +196,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::string elementId;
         int x;
         if (this->ParseSplitAction(json.get<jsonxx::Object>("param"), &elementId, &x)) {
+            this->SaveElementForUndo(elementId, true);
             return this->Split(elementId, x);
         }
         LogWarning("Could not parse split action");
@@ -173,6 +205,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::string elementId;
         std::string contour;
         if (this->ParseChangeGroupAction(json.get<jsonxx::Object>("param"), &elementId, &contour)) {
+            this->SaveElementForUndo(elementId, true);
             return this->ChangeGroup(elementId, contour);
         }
         LogWarning("Could not parse change group action");
@@ -181,6 +214,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         std::vector<std::string> elementIds;
         std::string isLigature;
         if (this->ParseToggleLigatureAction(json.get<jsonxx::Object>("param"), &elementIds, &isLigature)) {
+            if (!elementIds.empty()) this->SaveElementForUndo(elementIds.front(), true);
             return this->ToggleLigature(elementIds, isLigature);
         }
         LogWarning("Could not parse toggle ligature action");
@@ -188,6 +222,7 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
     else if (action == "changeStaff") {
         std::string elementId;
         if (this->ParseChangeStaffAction(json.get<jsonxx::Object>("param"), &elementId)) {
+            this->SaveElementForUndo(elementId, true);
             return this->ChangeStaff(elementId);
         }
         LogWarning("Could not parse change staff action");
@@ -219,6 +254,40 @@ bool EditorToolkitNeume::Chain(jsonxx::Array actions)
     return status;
 }
 
+void EditorToolkitNeume::RedoDrawing()
+{
+    // With a facsimile, elements are drawn from their zones
+    if (m_doc->GetType() == Facs) return;
+
+    m_doc->PrepareDrawing();
+    if (m_doc->GetDrawingPage()) m_doc->GetDrawingPage()->LayOut(true);
+}
+
+void EditorToolkitNeume::SaveElementForUndo(const std::string &elementId, bool withMeasure)
+{
+    if (!m_doc->GetDrawingPage()) return;
+
+    Object *element = m_doc->GetDrawingPage()->FindDescendantByUuid(elementId);
+    Object *scope = NULL;
+    if (!element) {
+        // For example when inserting a staff
+        if (withMeasure) scope = m_doc->GetDrawingPage()->FindDescendantByType(MEASURE);
+    }
+    else if (element->Is(MEASURE)) {
+        scope = element;
+    }
+    // Moving a clef changes the pitch of the following elements
+    else if (withMeasure || element->Is(CLEF)) {
+        scope = element->GetFirstAncestor(MEASURE);
+    }
+    else {
+        scope = (element->Is(STAFF)) ? element : element->GetFirstAncestor(STAFF);
+        if (!scope) scope = element->GetFirstAncestor(MEASURE);
+    }
+
+    if (scope) this->SaveForUndo(scope);
+}
+
 bool EditorToolkitNeume::Drag(std::string elementId, int x, int y)
 {
     std::string status = "OK", message = "";
@@ -1063,8 +1132,7 @@ bool EditorToolkitNeume::Set(std::string elementId, std::string attrType, std::s
     else if (Att::SetVisual(element, attrType, attrValue))
         success = true;
     if (success && m_doc->GetType() != Facs) {
-        m_doc->PrepareDrawing();
-        m_doc->GetDrawingPage()->LayOut(true);
+        this->UpdateDrawing();
     }
     m_infoObject.import("status", success ? "OK" : "FAILURE");
     m_infoObject.import("message", success ? "" : "Could not set attribute '" + attrType + "' to '" + attrValue + "'.");
@@ -1224,8 +1292,7 @@ bool EditorToolkitNeume::SetClef(std::string elementId, std::string shape)
         }
     }
     if (success && m_doc->GetType() != Facs) {
-        m_doc->PrepareDrawing();
-        m_doc->GetDrawingPage()->LayOut(true);
+        this->UpdateDrawing();
     }
     m_infoObject.import("status", "OK");
     m_infoObject.import("message", "");
@@ -2336,8 +2403,7 @@ bool EditorToolkitNeume::ToggleLigature(std::vector<std::string> elementIds, std
         return false;
     }
     if (success1 && success2 && m_doc->GetType() != Facs) {
-        m_doc->PrepareDrawing();
-        m_doc->GetDrawingPage()->LayOut(true);
+        this->UpdateDrawing();
     }
     m_infoObject.import("status", "OK");
     m_infoObject.import("message", "");
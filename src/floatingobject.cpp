@@ -259,6 +259,16 @@ FloatingPositioner::FloatingPositioner(FloatingObject *object, StaffAlignment *a
     ResetPositioner();
 }
 
+void *FloatingPositioner::operator new(size_t size)
+{
+    return LayoutPool::Allocate(size);
+}
+
+void FloatingPositioner::operator delete(void *block, size_t size)
+{
+    LayoutPool::Release(block, size);
+}
+
 void FloatingPositioner::ResetPositioner()
 {
     BoundingBox::ResetBoundingBox();
@@ -459,6 +469,21 @@ void FloatingCurvePositioner::ResetCurveParams()
     m_crossStaff = NULL;
     m_cachedMinMaxY = VRV_UNSET;
     ClearSpannedElements();
+
+    m_drawingX1 = 0;
+    m_drawingX2 = 0;
+    m_drawingStaff = NULL;
+    m_drawingSpanningType = SPANNING_START_END;
+    m_drawingGraphic = NULL;
+}
+
+void FloatingCurvePositioner::SetDrawingParams(int x1, int x2, Staff *staff, char spanningType, Object *graphic)
+{
+    m_drawingX1 = x1;
+    m_drawingX2 = x2;
+    m_drawingStaff = staff;
+    m_drawingSpanningType = spanningType;
+    m_drawingGraphic = graphic;
 }
 
 void FloatingCurvePositioner::UpdateCurveParams(
@@ -44,6 +44,14 @@ FTrem::FTrem() : LayerElement("ftrem-"), BeamDrawingInterface(), AttFTremVis(),
 
 FTrem::~FTrem() {}
 
+void FTrem::CloneReset()
+{
+    // The coordinates belong to the fTrem copied
+    m_beamElementCoords.clear();
+
+    LayerElement::CloneReset();
+}
+
 void FTrem::Reset()
 {
     LayerElement::Reset();
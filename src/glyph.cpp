@@ -49,13 +49,13 @@ Glyph::Glyph(std::string path, std::string codeStr)
     m_path = path;
     m_codeStr = codeStr;
 
-    pugi::xml_document doc;
-    pugi::xml_parse_result result = doc.load_file(path.c_str());
-    if (!result) {
+    // The parsed file is kept by Resources for copying the glyph into the SVG <defs>
+    std::shared_ptr<const pugi::xml_document> doc = Resources::GetXmlResource(path);
+    if (!doc) {
         LogError("Font file '%s' could not be loaded", path.c_str());
         return;
     }
-    pugi::xml_node root = doc.first_child();
+    pugi::xml_node root = doc->first_child();
 
     // look at the viewBox attribute for getting the units per em
     if (!root.attribute("viewBox")) {
@@ -74,6 +74,19 @@ Glyph::Glyph(std::string path, std::string codeStr)
     m_unitsPerEm = atoi(viewBox.substr(viewBox.find_last_of(' ')).c_str()) * 10;
 }
 
+Glyph::Glyph(std::string path, std::string codeStr, int unitsPerEm)
+{
+    // The file is not parsed here since the units per em are given
+    m_x = 0;
+    m_y = 0;
+    m_width = 0;
+    m_height = 0;
+    m_horizAdvX = 0;
+    m_unitsPerEm = unitsPerEm * 10;
+    m_path = path;
+    m_codeStr = codeStr;
+}
+
 Glyph::Glyph(int unitsPerEm)
 {
     m_x = 0;
@@ -96,7 +109,7 @@ void Glyph::SetBoundingBox(double x, double y, double w, double h)
     m_height = (int)(10.0 * h);
 }
 
-void Glyph::GetBoundingBox(int &x, int &y, int &w, int &h)
+void Glyph::GetBoundingBox(int &x, int &y, int &w, int &h) const
 {
     x = m_x;
     y = m_y;
@@ -126,14 +139,17 @@ void Glyph::SetAnchor(std::string anchorStr, double x, double y)
     m_anchors[anchorId] = Point(x * this->GetUnitsPerEm() / 4, y * this->GetUnitsPerEm() / 4);
 }
 
-bool Glyph::HasAnchor(SMuFLGlyphAnchor anchor)
+bool Glyph::HasAnchor(SMuFLGlyphAnchor anchor) const
 {
     return (m_anchors.count(anchor) == 1);
 }
 
-const Point *Glyph::GetAnchor(SMuFLGlyphAnchor anchor)
+const Point *Glyph::GetAnchor(SMuFLGlyphAnchor anchor) const
 {
-    return &m_anchors[anchor];
+    // Missing anchors are at the origin
+    static const Point origin;
+    auto it = m_anchors.find(anchor);
+    return (it != m_anchors.end()) ? &it->second : &origin;
 }
 
 } // namespace vrv
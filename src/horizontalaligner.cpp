@@ -50,30 +50,28 @@ void HorizontalAligner::Reset()
 
 Alignment *HorizontalAligner::SearchAlignmentAtTime(double time, AlignmentType type, int &idx)
 {
-    int i;
     idx = -1; // the index if we reach the end.
-    Alignment *alignment = NULL;
-    // First try to see if we already have something at the time position
-    for (i = 0; i < GetAlignmentCount(); ++i) {
-        alignment = vrv_cast<Alignment *>(GetChildren()->at(i));
+    const ArrayOfObjects *children = this->GetChildren();
+
+    // The alignments are ordered by time and then by type, so we can do a binary search for the first alignment that
+    // is not before the time and type we are looking for
+    auto it = std::lower_bound(children->begin(), children->end(), time, [type](Object *object, double time) {
+        Alignment *alignment = vrv_cast<Alignment *>(object);
         assert(alignment);
+        if (AreEqual(alignment->GetTime(), time)) return (alignment->GetType() < type);
+        return (alignment->GetTime() < time);
+    });
 
-        double alignment_time = alignment->GetTime();
-        if (AreEqual(alignment_time, time)) {
-            if (alignment->GetType() == type) {
-                return alignment;
-            }
-            else if (alignment->GetType() > type) {
-                idx = i;
-                break;
-            }
-        }
-        // nothing found, do not go any further but keep the index
-        if (alignment->GetTime() > time) {
-            idx = i;
-            break;
-        }
-    }
+    // nothing found, and nothing after
+    if (it == children->end()) return NULL;
+
+    Alignment *alignment = vrv_cast<Alignment *>(*it);
+    assert(alignment);
+    // we already have something of that type at the time position
+    if (AreEqual(alignment->GetTime(), time) && (alignment->GetType() == type)) return alignment;
+
+    // keep the index where it needs to be inserted
+    idx = (int)(it - children->begin());
     return NULL;
 }
 
@@ -132,7 +130,7 @@ Alignment *MeasureAligner::GetAlignmentAtTime(double time, AlignmentType type)
     if (idx == -1) {
         if (type != ALIGNMENT_MEASURE_END) {
             // This typically occurs when a tstamp event occurs after the last note of a measure
-            int rightBarlineIdx = m_rightBarLineAlignment->GetIdx();
+            int rightBarlineIdx = this->GetRightBarLineAlignmentIdx();
             assert(rightBarlineIdx != -1);
             idx = rightBarlineIdx;
             this->SetMaxTime(time);
@@ -152,7 +150,7 @@ void MeasureAligner::SetMaxTime(double time)
     assert(m_rightBarLineAlignment);
 
     // it must be found in the aligner
-    int idx = m_rightBarLineAlignment->GetIdx();
+    int idx = this->GetRightBarLineAlignmentIdx();
     assert(idx != -1);
 
     int i;
@@ -166,6 +164,15 @@ void MeasureAligner::SetMaxTime(double time)
     }
 }
 
+int MeasureAligner::GetRightBarLineAlignmentIdx() const
+{
+    // The right barline is expected to be close to the end, so look for it backwards
+    const ArrayOfObjects *children = this->GetChildren();
+    auto it = std::find(children->rbegin(), children->rend(), m_rightBarLineAlignment);
+    if (it == children->rend()) return -1;
+    return (int)(children->rend() - it) - 1;
+}
+
 double MeasureAligner::GetMaxTime() const
 {
     // we have to have a m_rightBarLineAlignment
@@ -306,6 +313,16 @@ GraceAligner::GraceAligner() : HorizontalAligner()
 
 GraceAligner::~GraceAligner() {}
 
+void *GraceAligner::operator new(size_t size)
+{
+    return LayoutPool::Allocate(size);
+}
+
+void GraceAligner::operator delete(void *block, size_t size)
+{
+    LayoutPool::Release(block, size);
+}
+
 void GraceAligner::Reset()
 {
     HorizontalAligner::Reset();
@@ -462,6 +479,16 @@ Alignment::~Alignment()
     ClearGraceAligners();
 }
 
+void *Alignment::operator new(size_t size)
+{
+    return LayoutPool::Allocate(size);
+}
+
+void Alignment::operator delete(void *block, size_t size)
+{
+    LayoutPool::Release(block, size);
+}
+
 void Alignment::ClearGraceAligners()
 {
     MapOfIntGraceAligners::const_iterator iter;
@@ -689,6 +716,16 @@ AlignmentReference::AlignmentReference(int staffN) : Object(), AttNInteger()
 
 AlignmentReference::~AlignmentReference() {}
 
+void *AlignmentReference::operator new(size_t size)
+{
+    return LayoutPool::Allocate(size);
+}
+
+void AlignmentReference::operator delete(void *block, size_t size)
+{
+    LayoutPool::Release(block, size);
+}
+
 void AlignmentReference::Reset()
 {
     Object::Reset();
@@ -22876,6 +22876,17 @@ std::string HumdrumInput::GetMeiString()
     return meioutput.GetOutput();
 }
 
+//////////////////////////////
+//
+// HumdrumInput::ReleaseHumdrumData -- Free the Humdrum data once the
+//     document has been converted.  GetHumdrumString() is empty afterwards.
+//
+
+void HumdrumInput::ReleaseHumdrumData()
+{
+    m_infiles.clear();
+}
+
 //////////////////////////////
 //
 // HumdrumInput::setLocationId -- use the file location of the item
@@ -24188,7 +24199,7 @@ void HumdrumInput::finalizeDocument(Doc *doc)
 {
     doc->ExpandExpansions();
     doc->ConvertToPageBasedDoc();
-    doc->ConvertMarkupDoc();
+    doc->ConvertMarkupDoc(!doc->GetOptions()->m_preserveAnalyticalMarkup.GetValue());
 
     if (m_mens) {
         doc->SetMensuralMusicOnly(true);
@@ -2455,6 +2455,46 @@ std::string MEIOutput::DocTypeToStr(DocType type)
     return value;
 }
 
+//----------------------------------------------------------------------------
+// MEIMemoryBuffer
+//----------------------------------------------------------------------------
+
+/**
+ * A read-only and seekable stream buffer over a string for importing in-memory MEI data with MEIInput::ImportStream.
+ */
+class MEIMemoryBuffer : public std::streambuf {
+public:
+    MEIMemoryBuffer(const std::string &data)
+    {
+        char *begin = const_cast<char *>(data.data());
+        this->setg(begin, begin, begin + data.size());
+    }
+
+protected:
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+    {
+        if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+        char *pos = this->gptr();
+        if (dir == std::ios_base::beg) {
+            pos = this->eback() + off;
+        }
+        else if (dir == std::ios_base::cur) {
+            pos += off;
+        }
+        else {
+            pos = this->egptr() + off;
+        }
+        if ((pos < this->eback()) || (pos > this->egptr())) return pos_type(off_type(-1));
+        this->setg(this->eback(), pos, this->egptr());
+        return pos_type(pos - this->eback());
+    }
+
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+    {
+        return this->seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
 //----------------------------------------------------------------------------
 // MEIInput
 //----------------------------------------------------------------------------
@@ -2465,12 +2505,19 @@ MEIInput::MEIInput(Doc *doc) : Input(doc)
     m_useScoreDefForDoc = false;
     m_readingScoreBased = false;
     m_version = MEI_UNDEFINED;
+    m_stream = NULL;
 }
 
 MEIInput::~MEIInput() {}
 
 bool MEIInput::Import(const std::string &mei)
 {
+    if (m_doc->GetOptions()->m_streamMei.GetValue()) {
+        MEIMemoryBuffer buffer(mei);
+        std::istream stream(&buffer);
+        return this->ImportStream(stream);
+    }
+
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
@@ -2485,6 +2532,180 @@ bool MEIInput::Import(const std::string &mei)
     }
 }
 
+bool MEIInput::ImportStream(std::istream &mei)
+{
+    bool success = false;
+    try {
+        m_doc->Reset();
+        m_doc->SetType(Raw);
+        pugi::xml_document doc;
+        {
+            std::string skeleton;
+            if (!this->ReadStreamSkeleton(mei, skeleton)) return false;
+            doc.load_buffer(
+                skeleton.data(), skeleton.size(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol);
+        }
+        m_stream = &mei;
+        pugi::xml_node root = doc.first_child();
+        success = ReadDoc(root);
+    }
+    catch (char *str) {
+        LogError("%s", str);
+        success = false;
+    }
+    m_stream = NULL;
+    m_streamedMeasures.clear();
+    return success;
+}
+
+bool MEIInput::ReadStreamSkeleton(std::istream &mei, std::string &skeleton)
+{
+    m_streamedMeasures.clear();
+
+    std::streambuf *buffer = mei.rdbuf();
+    std::streamoff offset = mei.tellg();
+    if (!buffer || (offset < 0)) {
+        LogError("The MEI data cannot be streamed because the input is not seekable");
+        return false;
+    }
+
+    // Read one character and copy it to the skeleton unless we are within a measure
+    bool inMeasure = false;
+    auto next = [&]() {
+        int c = buffer->sbumpc();
+        if (c == std::char_traits<char>::eof()) return c;
+        ++offset;
+        if (!inMeasure) skeleton.push_back(char(c));
+        return c;
+    };
+    // Read up to and including the given delimiter
+    auto skipTo = [&](const char *delimiter) {
+        const std::string end = delimiter;
+        std::string last(end.size(), ' ');
+        while (last != end) {
+            int c = next();
+            if (c == std::char_traits<char>::eof()) return false;
+            last.erase(0, 1);
+            last.push_back(char(c));
+        }
+        return true;
+    };
+
+    std::streamoff measureStart = 0;
+    size_t skeletonSize = 0;
+    int measureDepth = 0;
+    std::string name;
+    int c;
+    while ((c = next()) != std::char_traits<char>::eof()) {
+        if (c != '<') continue;
+        const std::streamoff tagStart = offset - 1;
+        const size_t tagSkeletonSize = skeleton.size() - 1;
+        c = next();
+        if (c == '?') {
+            if (!skipTo("?>")) break;
+            continue;
+        }
+        if (c == '!') {
+            c = next();
+            if (c == '-') {
+                // Comment
+                if (next() != '-' || !skipTo("-->")) break;
+            }
+            else if (c == '[') {
+                // CDATA section
+                if (!skipTo("]]>")) break;
+            }
+            else {
+                // Doctype with a possible internal subset
+                int brackets = 0;
+                while (c != std::char_traits<char>::eof() && (c != '>' || brackets > 0)) {
+                    if (c == '[') ++brackets;
+                    if (c == ']') --brackets;
+                    c = next();
+                }
+            }
+            continue;
+        }
+        const bool isEndTag = (c == '/');
+        if (isEndTag) c = next();
+        name.clear();
+        while (c != std::char_traits<char>::eof() && !isspace(c) && c != '>' && c != '/') {
+            name.push_back(char(c));
+            c = next();
+        }
+        // Go to the end of the tag, skipping quoted attribute values
+        bool isEmpty = false;
+        char quote = 0;
+        while (c != std::char_traits<char>::eof() && (c != '>' || quote)) {
+            if (quote) {
+                if (c == quote) quote = 0;
+            }
+            else if (c == '"' || c == '\'') {
+                quote = char(c);
+            }
+            isEmpty = (c == '/');
+            c = next();
+        }
+        if (c == std::char_traits<char>::eof()) break;
+        if (name != "measure") continue;
+
+        if (isEndTag) {
+            if (!inMeasure || (--measureDepth > 0)) continue;
+        }
+        else if (!inMeasure) {
+            measureStart = tagStart;
+            skeletonSize = tagSkeletonSize;
+            inMeasure = true;
+            measureDepth = 1;
+            if (!isEmpty) continue;
+        }
+        else {
+            if (!isEmpty) ++measureDepth;
+            continue;
+        }
+        // We are at the end of a measure - replace it with a placeholder
+        inMeasure = false;
+        skeleton.resize(skeletonSize);
+        skeleton += StringFormat("<measure verovio.streamed=\"%d\"/>", (int)m_streamedMeasures.size());
+        m_streamedMeasures.push_back({ measureStart, offset - measureStart });
+    }
+
+    if (inMeasure) {
+        LogError("The MEI data ends within a <measure> element");
+        return false;
+    }
+    return true;
+}
+
+pugi::xml_node MEIInput::LoadStreamedMeasure(pugi::xml_node measure, pugi::xml_document &fragment)
+{
+    assert(m_stream);
+
+    const int idx = measure.attribute("verovio.streamed").as_int(-1);
+    if ((idx < 0) || (idx >= (int)m_streamedMeasures.size())) {
+        LogError("Invalid streamed <measure> placeholder");
+        return pugi::xml_node();
+    }
+
+    const auto &range = m_streamedMeasures.at(idx);
+    std::string content(range.second, '\0');
+    m_stream->clear();
+    m_stream->seekg(range.first);
+    m_stream->read(&content[0], range.second);
+    if (m_stream->gcount() != range.second) {
+        LogError("The content of the <measure> could not be read from the MEI stream");
+        return pugi::xml_node();
+    }
+
+    pugi::xml_parse_result result = fragment.load_buffer(
+        content.data(), content.size(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol);
+    if (!result) {
+        LogError("The content of the <measure> cannot be parsed (%s)", result.description());
+        return pugi::xml_node();
+    }
+    return fragment.first_child();
+}
+
 bool MEIInput::IsAllowed(std::string element, Object *filterParent)
 {
     if (!filterParent || (element == "")) {
@@ -2968,8 +3189,8 @@ bool MEIInput::ReadDoc(pugi::xml_node root)
     if ((!facsimile.empty()) && (m_doc->GetOptions()->m_useFacsimile.GetValue())) {
         ReadFacsimile(m_doc, facsimile);
         m_doc->SetType(Facs);
-        m_doc->m_drawingPageHeight = m_doc->GetFacsimile()->GetMaxY();
-        m_doc->m_drawingPageWidth = m_doc->GetFacsimile()->GetMaxX();
+        m_doc->GetDrawingValues()->m_pageHeight = m_doc->GetFacsimile()->GetMaxY();
+        m_doc->GetDrawingValues()->m_pageWidth = m_doc->GetFacsimile()->GetMaxX();
     }
 
     front = music.child("front");
@@ -4113,6 +4334,13 @@ bool MEIInput::ReadLabelAbbr(Object *parent, pugi::xml_node labelAbbr)
 
 bool MEIInput::ReadMeasure(Object *parent, pugi::xml_node measure)
 {
+    // With a streamed import, the measure is a placeholder and its content is parsed only now
+    pugi::xml_document fragment;
+    if (m_stream && measure.attribute("verovio.streamed")) {
+        measure = this->LoadStreamedMeasure(measure, fragment);
+        if (!measure) return false;
+    }
+
     Measure *vrvMeasure = new Measure();
     if (m_doc->IsMensuralMusicOnly()) {
         LogWarning("Mixing mensural and non mensural music is not supported. Trying to go ahead...");
@@ -6576,12 +6804,13 @@ void MEIInput::SetMeiUuid(pugi::xml_node element, Object *object)
         m_comment.clear();
     }
 
-    if (!element.attribute("xml:id")) {
+    pugi::xml_attribute uuid = element.attribute("xml:id");
+    if (!uuid) {
         return;
     }
 
-    object->SetUuid(element.attribute("xml:id").value());
-    element.remove_attribute("xml:id");
+    object->SetUuid(uuid.value());
+    element.remove_attribute(uuid);
 }
 
 DocType MEIInput::StrToDocType(std::string type)
@@ -166,20 +166,44 @@ std::string MusicXmlInput::GetContent(const pugi::xml_node node) const
 
 std::string MusicXmlInput::GetContentOfChild(const pugi::xml_node node, const std::string &child) const
 {
-    pugi::xpath_node childNode = node.select_node(child.c_str());
+    pugi::xpath_node childNode = SelectNode(node, child.c_str());
     if (childNode.node()) {
         return GetContent(childNode.node());
     }
     return "";
 }
 
+pugi::xpath_node MusicXmlInput::SelectNode(const pugi::xml_node node, const char *xpath) const
+{
+    return node.select_node(GetXPathQuery(xpath));
+}
+
+pugi::xpath_node_set MusicXmlInput::SelectNodes(const pugi::xml_node node, const char *xpath) const
+{
+    return node.select_nodes(GetXPathQuery(xpath));
+}
+
+const pugi::xpath_query &MusicXmlInput::GetXPathQuery(const char *xpath) const
+{
+    auto iter = m_xpathQueries.find(xpath);
+    if (iter == m_xpathQueries.end()) {
+        iter = m_xpathQueries.try_emplace(xpath, xpath).first;
+    }
+    return iter->second;
+}
+
+Measure *MusicXmlInput::FindMeasureByN(const std::string &measureN) const
+{
+    auto iter = m_measuresByN.find(measureN);
+    return (iter != m_measuresByN.end()) ? iter->second : NULL;
+}
+
 void MusicXmlInput::ProcessClefChangeQueue(Section *section)
 {
     while (!m_clefChangeQueue.empty()) {
         musicxml::ClefChange clefChange = m_clefChangeQueue.front();
         m_clefChangeQueue.pop();
-        AttNNumberLikeComparison comparisonMeasure(MEASURE, clefChange.m_measureNum);
-        Measure *currentMeasure = vrv_cast<Measure *>(section->FindDescendantByComparison(&comparisonMeasure));
+        Measure *currentMeasure = FindMeasureByN(clefChange.m_measureNum);
         if (!currentMeasure) {
             LogWarning("MusicXML import: Clef change at measure %s, staff %d, time %d not inserted",
                 clefChange.m_measureNum.c_str(), clefChange.m_staff->GetN(), clefChange.m_scoreOnset);
@@ -317,13 +341,14 @@ void MusicXmlInput::AddMeasure(Section *section, Measure *measure, int i)
     assert(i >= 0);
 
     // we just need to add a measure
-    if (section->GetChildCount(MEASURE) <= i - GetMrestMeasuresCountBeforeIndex(i)) {
+    if ((int)m_sectionMeasures.size() <= i - GetMrestMeasuresCountBeforeIndex(i)) {
         section->AddChild(measure);
+        m_sectionMeasures.push_back(measure);
+        m_measuresByN.emplace(measure->GetN(), measure);
     }
     // otherwise copy the content to the corresponding existing measure
     else {
-        AttNNumberLikeComparison comparisonMeasure(MEASURE, measure->GetN());
-        Measure *existingMeasure = vrv_cast<Measure *>(section->FindDescendantByComparison(&comparisonMeasure, 1));
+        Measure *existingMeasure = FindMeasureByN(measure->GetN());
         if (existingMeasure) {
             for (auto current : *measure->GetChildren()) {
                 if (!current->Is(STAFF)) {
@@ -741,20 +766,20 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     Section *section = new Section();
     score->AddChild(section);
     // initialize layout
-    if (root.select_node("/score-partwise/part/measure/print")) {
+    if (SelectNode(root, "/score-partwise/part/measure/print")) {
         m_hasLayoutInformation = true;
-        if (!root.select_node("/score-partwise/part[1]/measure[1]/print[@new-system or @new-page]")) {
+        if (!SelectNode(root, "/score-partwise/part[1]/measure[1]/print[@new-system or @new-page]")) {
             // always start with a new page
             Pb *pb = new Pb();
             section->AddChild(pb);
         }
     }
 
-    pugi::xpath_node layout = root.select_node("/score-partwise/defaults/page-layout");
-    const float bottom = layout.node().select_node("page-margins/bottom-margin").node().text().as_float();
+    pugi::xpath_node layout = SelectNode(root, "/score-partwise/defaults/page-layout");
+    const float bottom = SelectNode(layout.node(), "page-margins/bottom-margin").node().text().as_float();
 
     // generate page head
-    pugi::xpath_node_set credits = root.select_nodes("/score-partwise/credit[@page='1']/credit-words");
+    pugi::xpath_node_set credits = SelectNodes(root, "/score-partwise/credit[@page='1']/credit-words");
     if (!credits.empty()) {
         PgHead *head = NULL;
         PgFoot *foot = NULL;
@@ -803,12 +828,19 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     int staffOffset = 0;
     m_octDis.push_back(0);
 
-    pugi::xpath_node scoreMidiBpm = root.select_node("/score-partwise/part[1]/measure[1]/sound[@tempo][1]");
+    pugi::xpath_node scoreMidiBpm = SelectNode(root, "/score-partwise/part[1]/measure[1]/sound[@tempo][1]");
     if (scoreMidiBpm) m_doc->m_mdivScoreDef.SetMidiBpm(scoreMidiBpm.node().attribute("tempo").as_int());
 
-    pugi::xpath_node_set partListChildren = root.select_nodes("/score-partwise/part-list/*");
-    for (pugi::xpath_node_set::const_iterator it = partListChildren.begin(); it != partListChildren.end(); ++it) {
-        pugi::xpath_node xpathNode = *it;
+    // index the parts by id once instead of looking up each of them from the root
+    const pugi::xml_node scorePartwise = root.root().child("score-partwise");
+    std::map<std::string, pugi::xml_node> partsById;
+    for (pugi::xml_node part : scorePartwise.children("part")) {
+        partsById.emplace(part.attribute("id").as_string(), part);
+    }
+
+    for (pugi::xml_node partListChild : scorePartwise.child("part-list").children()) {
+        if (partListChild.type() != pugi::node_element) continue;
+        pugi::xpath_node xpathNode = partListChild;
         if (IsElement(xpathNode.node(), "part-group")) {
             if (HasAttributeWithValue(xpathNode.node(), "type", "start")) {
                 StaffGrp *staffGrp = new StaffGrp();
@@ -839,7 +871,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                     = GetContentOfChild(xpathNode.node(), "group-abbreviation[not(@print-object='no')]");
                 if (!groupName.empty() && !m_label) {
                     m_label = new Label();
-                    if (xpathNode.node().select_node("group-name-display[not(@print-object='no')]")) {
+                    if (SelectNode(xpathNode.node(), "group-name-display[not(@print-object='no')]")) {
                         const std::string name = StyleLabel(xpathNode.node().child("group-name-display"));
                         Text *text = new Text();
                         text->SetText(UTF8to16(name));
@@ -855,7 +887,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 }
                 if (!groupAbbr.empty() && !m_labelAbbr) {
                     m_labelAbbr = new LabelAbbr();
-                    if (xpathNode.node().select_node("group-abbreviation-display[not(@print-object='no')]")) {
+                    if (SelectNode(xpathNode.node(), "group-abbreviation-display[not(@print-object='no')]")) {
                         const std::string name = StyleLabel(xpathNode.node().child("group-abbreviation-display"));
                         Text *text = new Text();
                         text->SetText(UTF8to16(name));
@@ -880,9 +912,10 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
         else if (IsElement(xpathNode.node(), "score-part")) {
             // get the attributes element of the first measure of the part
             const std::string partId = xpathNode.node().attribute("id").as_string();
-            std::string xpath = StringFormat("/score-partwise/part[@id='%s']/measure[1]", partId.c_str());
-            pugi::xpath_node partFirstMeasure = root.select_node(xpath.c_str());
-            if (!partFirstMeasure.node().child("attributes")) {
+            auto partIter = partsById.find(partId);
+            const pugi::xml_node part = (partIter != partsById.end()) ? partIter->second : pugi::xml_node();
+            const pugi::xml_node partFirstMeasure = part.child("measure");
+            if (!partFirstMeasure.child("attributes")) {
                 LogWarning("MusicXML import: Could not find the 'attributes' element in the first "
                            "measure of part '%s'",
                     partId.c_str());
@@ -895,7 +928,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             pugi::xml_node midiInstrument = xpathNode.node().child("midi-instrument");
             if (!partName.empty() && !m_label) {
                 m_label = new Label();
-                if (xpathNode.node().select_node("part-name-display[not(@print-object='no')]")) {
+                if (SelectNode(xpathNode.node(), "part-name-display[not(@print-object='no')]")) {
                     const std::string name = StyleLabel(xpathNode.node().child("part-name-display"));
                     Text *text = new Text();
                     text->SetText(UTF8to16(name));
@@ -918,7 +951,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             }
             if (!partAbbr.empty() && !m_labelAbbr) {
                 m_labelAbbr = new LabelAbbr();
-                if (xpathNode.node().select_node("part-abbreviation-display[not(@print-object='no')]")) {
+                if (SelectNode(xpathNode.node(), "part-abbreviation-display[not(@print-object='no')]")) {
                     const std::string name = StyleLabel(xpathNode.node().child("part-abbreviation-display"));
                     Text *text = new Text();
                     text->SetText(UTF8to16(name));
@@ -956,7 +989,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             StaffGrp *partStaffGrp = new StaffGrp();
             partStaffGrp->SetUuid(partId.c_str());
             const int nbStaves
-                = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure.node(), partStaffGrp, staffOffset);
+                = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure, partStaffGrp, staffOffset);
             // if we have more than one staff in the part we create a new staffGrp
             if (nbStaves > 1) {
                 partStaffGrp->SetBarThru(BOOLEAN_true);
@@ -972,14 +1005,12 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 delete partStaffGrp;
             }
 
-            // find the part and read it
-            xpath = StringFormat("/score-partwise/part[@id='%s']", partId.c_str());
-            pugi::xpath_node part = root.select_node(xpath.c_str());
+            // read the part
             if (!part) {
                 LogWarning("MusicXML import: Could not find the part '%s'", partId.c_str());
                 continue;
             }
-            ReadMusicXmlPart(part.node(), section, nbStaves, staffOffset);
+            ReadMusicXmlPart(part, section, nbStaves, staffOffset);
             // increment the staffOffset for reading the next part
             staffOffset += nbStaves;
         }
@@ -995,8 +1026,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     std::vector<std::pair<std::string, ControlElement *>>::iterator iter;
     for (iter = m_controlElements.begin(); iter != m_controlElements.end(); ++iter) {
         if (!measure || (measure->GetN() != iter->first)) {
-            AttNNumberLikeComparison comparisonMeasure(MEASURE, iter->first);
-            measure = dynamic_cast<Measure *>(section->FindDescendantByComparison(&comparisonMeasure, 1));
+            measure = FindMeasureByN(iter->first);
         }
         if (!measure) {
             LogWarning("MusicXML import: Element '%s' could not be added to measure %s",
@@ -1091,10 +1121,10 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
 void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
 {
     assert(root);
-    pugi::xpath_node workTitle = root.select_node("/score-partwise/work/work-title");
-    pugi::xpath_node movementTitle = root.select_node("/score-partwise/movement-title");
-    pugi::xpath_node workNumber = root.select_node("/score-partwise/work/work-number");
-    pugi::xpath_node movementNumber = root.select_node("/score-partwise/movement-number");
+    pugi::xpath_node workTitle = SelectNode(root, "/score-partwise/work/work-title");
+    pugi::xpath_node movementTitle = SelectNode(root, "/score-partwise/movement-title");
+    pugi::xpath_node workNumber = SelectNode(root, "/score-partwise/work/work-number");
+    pugi::xpath_node movementNumber = SelectNode(root, "/score-partwise/movement-number");
     pugi::xml_node meiHead = m_doc->m_header.append_child("meiHead");
 
     // <fileDesc> /////////////
@@ -1122,7 +1152,7 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
 
     pugi::xml_node respStmt = titleStmt.append_child("respStmt");
 
-    pugi::xpath_node_set creators = root.select_nodes("/score-partwise/identification/creator");
+    pugi::xpath_node_set creators = SelectNodes(root, "/score-partwise/identification/creator");
     for (pugi::xpath_node_set::const_iterator it = creators.begin(); it != creators.end(); ++it) {
         pugi::xpath_node creator = *it;
         pugi::xml_node persName = respStmt.append_child("persName");
@@ -1131,7 +1161,7 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
     }
 
     // Convert rights into availability
-    pugi::xpath_node_set rightsSet = root.select_nodes("/score-partwise/identification/rights");
+    pugi::xpath_node_set rightsSet = SelectNodes(root, "/score-partwise/identification/rights");
     if (!rightsSet.empty()) {
         pugi::xml_node availability = pubStmt.append_child("availability");
         for (pugi::xpath_node_set::const_iterator it = rightsSet.begin(); it != rightsSet.end(); ++it) {
@@ -1142,7 +1172,7 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
         }
     }
 
-    pugi::xpath_node_set dateSet = root.select_nodes("/score-partwise/identification/encoding/encoding-date");
+    pugi::xpath_node_set dateSet = SelectNodes(root, "/score-partwise/identification/encoding/encoding-date");
     for (pugi::xpath_node_set::const_iterator it = dateSet.begin(); it != dateSet.end(); ++it) {
         pugi::xpath_node encodingDate = *it;
         pugi::xml_node date = pubStmt.append_child("date");
@@ -1180,7 +1210,7 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
 
     // First get the number of staves in the part
     int nbStaves = 1;
-    pugi::xpath_node staves = node.select_node("attributes[1]/staves");
+    pugi::xpath_node staves = SelectNode(node, "attributes[1]/staves");
     if (staves) {
         nbStaves = staves.node().text().as_int();
     }
@@ -1235,10 +1265,10 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
 
             // clef sign - first look if we have a clef-sign with the corresponding staff @number
             std::string xpath = StringFormat("clef[@number='%d']", i + 1);
-            pugi::xpath_node clef = it->select_node(xpath.c_str());
+            pugi::xpath_node clef = SelectNode(*it, xpath.c_str());
             // if not, look at a common one
             if (!clef) {
-                clef = it->select_node("clef[not(@number)]");
+                clef = SelectNode(*it, "clef[not(@number)]");
                 if (nbStaves > 1) clef.node().remove_attribute("id");
             }
             Clef *meiClef = ConvertClef(clef.node());
@@ -1246,9 +1276,9 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
 
             // key sig
             xpath = StringFormat("key[@number='%d']", i + 1);
-            pugi::xpath_node key = it->select_node(xpath.c_str());
+            pugi::xpath_node key = SelectNode(*it, xpath.c_str());
             if (!key) {
-                key = it->select_node("key[not(@number)]");
+                key = SelectNode(*it, "key[not(@number)]");
                 if (nbStaves > 1) key.node().remove_attribute("id");
             }
             if (key) {
@@ -1259,22 +1289,22 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             // staff details
             pugi::xpath_node staffDetails;
             xpath = StringFormat("staff-details[@number='%d']", i + 1);
-            staffDetails = it->select_node(xpath.c_str());
+            staffDetails = SelectNode(*it, xpath.c_str());
             if (!staffDetails) {
-                staffDetails = it->select_node("staff-details");
+                staffDetails = SelectNode(*it, "staff-details");
             }
-            int staffLines = staffDetails.node().select_node("staff-lines").node().text().as_int();
+            int staffLines = SelectNode(staffDetails.node(), "staff-lines").node().text().as_int();
             if (staffLines) {
                 staffDef->SetLines(staffLines);
             }
             else if (!staffDef->HasLines()) {
                 staffDef->SetLines(5);
             }
-            std::string scaleStr = staffDetails.node().select_node("staff-size").node().text().as_string();
+            std::string scaleStr = SelectNode(staffDetails.node(), "staff-size").node().text().as_string();
             if (!scaleStr.empty()) {
                 staffDef->SetScale(staffDef->AttScalable::StrToPercent(scaleStr + "%"));
             }
-            pugi::xpath_node staffTuning = staffDetails.node().select_node("staff-tuning");
+            pugi::xpath_node staffTuning = SelectNode(staffDetails.node(), "staff-tuning");
             if (staffTuning) {
                 staffDef->SetNotationtype(NOTATIONTYPE_tab);
             }
@@ -1283,9 +1313,9 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             MeterSig *meterSig = NULL;
             pugi::xpath_node time;
             xpath = StringFormat("time[@number='%d']", i + 1);
-            time = it->select_node(xpath.c_str());
+            time = SelectNode(*it, xpath.c_str());
             if (!time) {
-                time = it->select_node("time[not(@number)]");
+                time = SelectNode(*it, "time[not(@number)]");
                 if (nbStaves > 1) time.node().remove_attribute("id");
             }
             if (time) {
@@ -1302,7 +1332,7 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
                     else
                         meterSig->SetForm(METERFORM_norm);
                 }
-                if (time.node().select_nodes("beats").size() > 1) {
+                if (SelectNodes(time.node(), "beats").size() > 1) {
                     LogWarning("MusicXML import: Compound meter signatures are not supported");
                 }
                 pugi::xml_node beats = time.node().child("beats");
@@ -1330,22 +1360,22 @@ int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(pugi::xml_node node, Sta
             // transpose
             pugi::xpath_node transpose;
             xpath = StringFormat("transpose[@number='%d']", i + 1);
-            transpose = it->select_node(xpath.c_str());
+            transpose = SelectNode(*it, xpath.c_str());
             if (!transpose) {
-                transpose = it->select_node("transpose");
+                transpose = SelectNode(*it, "transpose");
             }
             if (transpose) {
                 staffDef->SetTransDiat(transpose.node().child("diatonic").text().as_int());
                 staffDef->SetTransSemi(transpose.node().child("chromatic").text().as_int());
             }
             // ppq
-            pugi::xpath_node divisions = it->select_node("divisions");
+            pugi::xpath_node divisions = SelectNode(*it, "divisions");
             if (divisions) {
                 m_ppq = divisions.node().text().as_int();
                 staffDef->SetPpq(m_ppq);
             }
             // measure style
-            pugi::xpath_node measureSlash = it->select_node("measure-style/slash");
+            pugi::xpath_node measureSlash = SelectNode(*it, "measure-style/slash");
             if (measureSlash) {
                 if (HasAttributeWithValue(measureSlash.node(), "type", "start"))
                     m_slash = true;
@@ -1363,7 +1393,7 @@ bool MusicXmlInput::ReadMusicXmlPart(pugi::xml_node node, Section *section, int
     assert(node);
     assert(section);
 
-    pugi::xpath_node_set measures = node.select_nodes("measure");
+    pugi::xpath_node_set measures = SelectNodes(node, "measure");
     if (measures.size() == 0) {
         LogWarning("MusicXML import: No measure to load");
         return false;
@@ -1469,10 +1499,11 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
     // read the content of the measure
     for (pugi::xml_node::iterator it = node.begin(); it != node.end(); ++it) {
         // first check if there is a multi measure rest
-        if (it->select_node(".//multiple-rest")) {
-            const int multiRestLength = it->select_node(".//multiple-rest").node().text().as_int();
+        const pugi::xpath_node multipleRest = SelectNode(*it, ".//multiple-rest");
+        if (multipleRest) {
+            const int multiRestLength = multipleRest.node().text().as_int();
             MultiRest *multiRest = new MultiRest;
-            if (it->select_node(".//multiple-rest[@use-symbols='yes']")) multiRest->SetBlock(BOOLEAN_false);
+            if (SelectNode(*it, ".//multiple-rest[@use-symbols='yes']")) multiRest->SetBlock(BOOLEAN_false);
             multiRest->SetNum(multiRestLength);
             Layer *layer = SelectLayer(1, measure);
             AddLayerElement(layer, multiRest);
@@ -1513,7 +1544,7 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
             ReadMusicXmlNote(*it, measure, measureNum, staffOffset, section);
         }
         // for now only check first part
-        else if (IsElement(*it, "print") && node.select_node("parent::part[not(preceding-sibling::part)]")) {
+        else if (IsElement(*it, "print") && SelectNode(node, "parent::part[not(preceding-sibling::part)]")) {
             ReadMusicXmlPrint(*it, section);
         }
     }
@@ -1609,8 +1640,8 @@ void MusicXmlInput::ReadMusicXmlAttributes(
     pugi::xml_node time = node.child("time");
 
     // for now only read first key change in first part and update scoreDef
-    if ((key || time || divisionChange) && node.select_node("ancestor::part[not(preceding-sibling::part)]")
-        && !node.select_node("preceding-sibling::attributes/key")) {
+    if ((key || time || divisionChange) && SelectNode(node, "ancestor::part[not(preceding-sibling::part)]")
+        && !SelectNode(node, "preceding-sibling::attributes/key")) {
         ScoreDef *scoreDef = new ScoreDef();
         if (key) {
             KeySig *meiKey = ConvertKey(key);
@@ -1638,7 +1669,7 @@ void MusicXmlInput::ReadMusicXmlAttributes(
                 meterSig->SetCount(m_meterCount);
                 m_meterUnit = beatType.text().as_int();
                 meterSig->SetUnit(m_meterUnit);
-                if (time.select_nodes("beats").size() > 1) {
+                if (SelectNodes(time, "beats").size() > 1) {
                     LogWarning("MusicXML import: Compound meter signatures are not supported");
                 }
             }
@@ -1660,8 +1691,8 @@ void MusicXmlInput::ReadMusicXmlAttributes(
         section->AddChild(scoreDef);
     }
 
-    pugi::xpath_node measureRepeat = node.select_node("measure-style/measure-repeat");
-    pugi::xpath_node measureSlash = node.select_node("measure-style/slash");
+    pugi::xpath_node measureRepeat = SelectNode(node, "measure-style/measure-repeat");
+    pugi::xpath_node measureSlash = SelectNode(node, "measure-style/slash");
     if (measureRepeat) {
         if (HasAttributeWithValue(measureRepeat.node(), "type", "start"))
             m_mRpt = true;
@@ -1695,7 +1726,7 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, c
     assert(staff);
 
     const std::string barStyle = node.child("bar-style").text().as_string();
-    pugi::xpath_node repeat = node.select_node("repeat");
+    pugi::xpath_node repeat = SelectNode(node, "repeat");
     if (!barStyle.empty()) {
         data_BARRENDITION barRendition = ConvertStyleToRend(barStyle, repeat);
         if (HasAttributeWithValue(node, "location", "left")) {
@@ -1743,7 +1774,7 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, c
         if (endingType == "start") {
             // check for corresponding stop points
             std::string xpath = StringFormat("following::ending[@number='%s'][@type != 'start']", endingNumber.c_str());
-            pugi::xpath_node endingEnd = node.select_node(xpath.c_str());
+            pugi::xpath_node endingEnd = SelectNode(node, xpath.c_str());
             if (endingEnd && (m_endingStack.empty() || NotInEndingStack(measure->GetN()))) {
                 musicxml::EndingInfo endingInfo(endingNumber, endingType, endingText);
                 std::vector<Measure *> measureList;
@@ -1799,7 +1830,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     const std::string directionId = node.attribute("id").as_string();
 
     const pugi::xml_node typeNode = node.child("direction-type");
-    const pugi::xpath_node voice = node.select_node("voice");
+    const pugi::xpath_node voice = SelectNode(node, "voice");
     const int offset = node.child("offset").text().as_int();
     const pugi::xml_node staffNode = node.child("staff");
     const pugi::xml_node soundNode = node.child("sound");
@@ -1865,7 +1896,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Dashes (to be connected with previous <dir> or <dynam> as @extender and @tstamp2 attribute
-    pugi::xpath_node dashes = typeNode.select_node("bracket|dashes");
+    pugi::xpath_node dashes = SelectNode(typeNode, "bracket|dashes");
     if (dashes) {
         int dashesNumber = dashes.node().attribute("number").as_int();
         dashesNumber = (dashesNumber < 1) ? 1 : dashesNumber;
@@ -1931,16 +1962,16 @@ void MusicXmlInput::ReadMusicXmlDirection(
         }
     }
 
-    pugi::xpath_node_set words = node.select_nodes("direction-type/words");
+    pugi::xpath_node_set words = SelectNodes(node, "direction-type/words");
     const bool containsWords = !words.empty();
     bool containsDynamics
-        = !node.select_node("direction-type/dynamics").node().empty() or soundNode.attribute("dynamics");
-    bool containsTempo = !node.select_node("direction-type/metronome").node().empty() or soundNode.attribute("tempo");
+        = !SelectNode(node, "direction-type/dynamics").node().empty() or soundNode.attribute("dynamics");
+    bool containsTempo = !SelectNode(node, "direction-type/metronome").node().empty() or soundNode.attribute("tempo");
 
     // Directive
     int defaultY = 0; // y position attribute, only for directives and dynamics
     if (containsWords && !containsTempo && !containsDynamics) {
-        pugi::xpath_node_set words = node.select_nodes("direction-type/*[self::words or self::coda or self::segno]");
+        pugi::xpath_node_set words = SelectNodes(node, "direction-type/*[self::words or self::coda or self::segno]");
         defaultY = words.first().node().attribute("default-y").as_int();
         std::string wordStr = words.first().node().text().as_string();
         if (wordStr.rfind("cresc", 0) == 0 || wordStr.rfind("dim", 0) == 0 || wordStr.rfind("decresc", 0) == 0) {
@@ -1994,7 +2025,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
 
     // Dynamics
     if (containsDynamics) {
-        pugi::xpath_node_set dynamics = node.select_nodes(
+        pugi::xpath_node_set dynamics = SelectNodes(node, 
             containsWords ? "direction-type/dynamics|direction-type/words" : "direction-type/dynamics");
 
         dynamics.sort();
@@ -2051,7 +2082,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Hairpins
-    pugi::xpath_node_set wedges = node.select_nodes("direction-type/wedge");
+    pugi::xpath_node_set wedges = SelectNodes(node, "direction-type/wedge");
     for (pugi::xpath_node_set::const_iterator wedge = wedges.begin(); wedge != wedges.end(); ++wedge) {
         int hairpinNumber = wedge->node().attribute("number").as_int();
         hairpinNumber = (hairpinNumber < 1) ? 1 : hairpinNumber;
@@ -2293,7 +2324,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Tempo
-    pugi::xpath_node metronome = node.select_node("direction-type/metronome");
+    pugi::xpath_node metronome = SelectNode(node, "direction-type/metronome");
     if (containsTempo) {
         Tempo *tempo = new Tempo();
         if (!words.empty()) {
@@ -2382,7 +2413,7 @@ void MusicXmlInput::ReadMusicXmlHarmony(pugi::xml_node node, Measure *measure, c
     int durOffset = 0;
 
     std::string harmText = GetContentOfChild(node, "root/root-step");
-    pugi::xpath_node alter = node.select_node("root/root-alter");
+    pugi::xpath_node alter = SelectNode(node, "root/root-alter");
     if (alter) harmText += ConvertAlterToSymbol(GetContent(alter.node()));
     pugi::xml_node kind = node.child("kind");
     if (kind) {
@@ -2449,21 +2480,21 @@ void MusicXmlInput::ReadMusicXmlNote(
         return;
     }
 
-    const pugi::xpath_node notations = node.select_node("notations[not(@print-object='no')]");
+    const pugi::xpath_node notations = SelectNode(node, "notations[not(@print-object='no')]");
 
-    const bool cue = (node.child("cue") || node.select_node("type[@size='cue']")) ? true : false;
+    const bool cue = (node.child("cue") || SelectNode(node, "type[@size='cue']")) ? true : false;
     pugi::xml_node grace = node.child("grace");
 
     // duration string and dots
     const std::string typeStr = node.child("type").text().as_string();
-    const int dots = (int)node.select_nodes("dot").size();
+    const int dots = (int)SelectNodes(node, "dot").size();
 
     ReadMusicXmlBeamsAndTuplets(node, layer, isChord);
 
     // beam start
-    bool beamStart = node.select_node("beam[@number='1'][text()='begin']");
+    bool beamStart = SelectNode(node, "beam[@number='1'][text()='begin']");
     // tremolos
-    pugi::xpath_node tremolo = notations.node().select_node("ornaments/tremolo");
+    pugi::xpath_node tremolo = SelectNode(notations.node(), "ornaments/tremolo");
     int tremSlashNum = -1;
     if (tremolo) {
         if (HasAttributeWithValue(tremolo.node(), "type", "start")) {
@@ -2476,7 +2507,7 @@ void MusicXmlInput::ReadMusicXmlNote(
                 while (beamStart && beamAttachedNum < 8) { // count number of (attached) beams, max 8
                     std::ostringstream o;
                     o << "beam[@number='" << ++beamAttachedNum + 1 << "'][text()='begin']";
-                    beamStart = node.select_node(o.str().c_str());
+                    beamStart = SelectNode(node, o.str().c_str());
                 }
                 fTrem->SetBeams(beamFloatNum + beamAttachedNum);
                 fTrem->SetBeamsFloat(beamFloatNum);
@@ -2655,7 +2686,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         if (node.child("notehead-text")) LogWarning("MusicXML import: notehead-text is not supported");
 
         // look at the next note to see if we are starting or ending a chord
-        pugi::xpath_node nextNote = node.select_node("./following-sibling::note");
+        pugi::xpath_node nextNote = SelectNode(node, "./following-sibling::note");
         if (nextNote.node().child("chord")) nextIsChord = true;
         Chord *chord = NULL;
         if (nextIsChord) {
@@ -2847,7 +2878,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // slurs
-        pugi::xpath_node_set slurs = node.select_nodes("notations/slur");
+        pugi::xpath_node_set slurs = SelectNodes(node, "notations/slur");
         for (pugi::xpath_node_set::const_iterator it = slurs.begin(); it != slurs.end(); ++it) {
             pugi::xml_node slur = it->node();
             int slurNumber = slur.attribute("number").as_int();
@@ -2872,8 +2903,8 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // ties
-        pugi::xpath_node startTie = notations.node().select_node("tied[@type='start']");
-        pugi::xpath_node endTie = notations.node().select_node("tied[@type='stop']");
+        pugi::xpath_node startTie = SelectNode(notations.node(), "tied[@type='start']");
+        pugi::xpath_node endTie = SelectNode(notations.node(), "tied[@type='stop']");
         if (endTie) { // add to stack if (endTie) or if pitch/oct match to open tie on m_tieStack
             if (!m_tieStack.empty() && note->GetPname() == m_tieStack.back().second->GetPname()
                 && note->GetOct() == m_tieStack.back().second->GetOct()) {
@@ -2975,7 +3006,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     m_ID = "#" + element->GetUuid();
 
     // breath marks
-    pugi::xpath_node xmlBreath = notations.node().select_node("articulations/breath-mark");
+    pugi::xpath_node xmlBreath = SelectNode(notations.node(), "articulations/breath-mark");
     if (xmlBreath) {
         Breath *breath = new Breath();
         m_controlElements.push_back(std::make_pair(measureNum, breath));
@@ -2987,7 +3018,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // caesura
-    pugi::xpath_node xmlCaesura = notations.node().select_node("articulations/caesura");
+    pugi::xpath_node xmlCaesura = SelectNode(notations.node(), "articulations/caesura");
     if (xmlCaesura) {
         Caesura *caesura = new Caesura();
         m_controlElements.push_back(std::make_pair(measureNum, caesura));
@@ -3037,7 +3068,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // fingering
-    auto xmlFing = notations.node().select_node("technical/fingering");
+    auto xmlFing = SelectNode(notations.node(), "technical/fingering");
     if (xmlFing) {
         const std::string fingText = xmlFing.node().text().as_string();
         Fing *fing = new Fing();
@@ -3051,7 +3082,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // glissando and slide
-    pugi::xpath_node_set glissandi = notations.node().select_nodes("glissando|slide");
+    pugi::xpath_node_set glissandi = SelectNodes(notations.node(), "glissando|slide");
     for (pugi::xpath_node_set::const_iterator it = glissandi.begin(); it != glissandi.end(); ++it) {
         std::string noteID = m_ID;
         // prevent from using chords
@@ -3085,7 +3116,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // mordents
-    pugi::xpath_node xmlMordent = notations.node().select_node("ornaments/*[contains(name(), 'mordent')]");
+    pugi::xpath_node xmlMordent = SelectNode(notations.node(), "ornaments/*[contains(name(), 'mordent')]");
     if (xmlMordent) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back(std::make_pair(measureNum, mordent));
@@ -3133,7 +3164,7 @@ void MusicXmlInput::ReadMusicXmlNote(
 
     // schleifer/haydn (counts as mordent with different glyph)
     pugi::xpath_node xmlExtOrnament
-        = notations.node().select_node("ornaments/*[contains(name(), 'schleifer') or contains(name(), 'haydn')]");
+        = SelectNode(notations.node(), "ornaments/*[contains(name(), 'schleifer') or contains(name(), 'haydn')]");
     if (xmlExtOrnament) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back(std::make_pair(measureNum, mordent));
@@ -3150,8 +3181,8 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // trill
-    pugi::xpath_node xmlTrill = notations.node().select_node("ornaments/trill-mark");
-    pugi::xpath_node xmlTrillLine = notations.node().select_node("ornaments/wavy-line[@type='start']");
+    pugi::xpath_node xmlTrill = SelectNode(notations.node(), "ornaments/trill-mark");
+    pugi::xpath_node xmlTrillLine = SelectNode(notations.node(), "ornaments/wavy-line[@type='start']");
     if (xmlTrill || xmlTrillLine) {
         Trill *trill = new Trill();
         m_controlElements.push_back(std::make_pair(measureNum, trill));
@@ -3182,9 +3213,9 @@ void MusicXmlInput::ReadMusicXmlNote(
             }
         }
     }
-    if (!m_trillStack.empty() && notations.node().select_node("ornaments/wavy-line[@type='stop']")) {
+    if (!m_trillStack.empty() && SelectNode(notations.node(), "ornaments/wavy-line[@type='stop']")) {
         int extNumber
-            = notations.node().select_node("ornaments/wavy-line[@type='stop']").node().attribute("number").as_int();
+            = SelectNode(notations.node(), "ornaments/wavy-line[@type='stop']").node().attribute("number").as_int();
         std::vector<std::pair<Trill *, musicxml::OpenSpanner>>::iterator iter = m_trillStack.begin();
         while (iter != m_trillStack.end()) {
             const int measureDifference = m_measureCounts.at(measure) - iter->second.m_lastMeasureCount;
@@ -3201,7 +3232,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // turns
-    pugi::xpath_node xmlTurn = notations.node().select_node("ornaments/*[contains(name(), 'turn')]");
+    pugi::xpath_node xmlTurn = SelectNode(notations.node(), "ornaments/*[contains(name(), 'turn')]");
     if (xmlTurn) {
         Turn *turn = new Turn();
         m_controlElements.push_back(std::make_pair(measureNum, turn));
@@ -3237,7 +3268,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // arpeggio
-    pugi::xpath_node xmlArpeggiate = notations.node().select_node("*[contains(name(), 'arpeggiate')]");
+    pugi::xpath_node xmlArpeggiate = SelectNode(notations.node(), "*[contains(name(), 'arpeggiate')]");
     if (xmlArpeggiate) {
         int arpegN = xmlArpeggiate.node().attribute("number").as_int();
         arpegN = (arpegN < 1) ? 1 : arpegN;
@@ -3291,15 +3322,15 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // tuplet end
-    pugi::xpath_node tupletEnd = notations.node().select_node("tuplet[@type='stop']");
+    pugi::xpath_node tupletEnd = SelectNode(notations.node(), "tuplet[@type='stop']");
     if (tupletEnd) {
         RemoveLastFromStack(TUPLET, layer);
     }
 
     // beam end
-    bool beamEnd = node.select_node("beam[text()='end']");
+    bool beamEnd = SelectNode(node, "beam[text()='end']");
     if (beamEnd) {
-        int breakSec = (int)node.select_nodes("beam[text()='continue']").size();
+        int breakSec = (int)SelectNodes(node, "beam[text()='continue']").size();
         if (breakSec) {
             if (element->Is(NOTE)) {
                 Note *note = dynamic_cast<Note *>(element);
@@ -3390,13 +3421,13 @@ void MusicXmlInput::ReadMusicXmlPrint(pugi::xml_node node, Section *section)
 
 void MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Layer *layer, bool isChord)
 {
-    pugi::xpath_node beamStart = node.select_node("beam[@number='1' and text()='begin']");
-    pugi::xpath_node tupletStart = node.select_node("notations/tuplet[@type='start']");
-    pugi::xpath_node currentMeasure = node.select_node("ancestor::measure");
+    pugi::xpath_node beamStart = SelectNode(node, "beam[@number='1' and text()='begin']");
+    pugi::xpath_node tupletStart = SelectNode(node, "notations/tuplet[@type='start']");
+    pugi::xpath_node currentMeasure = SelectNode(node, "ancestor::measure");
 
-    pugi::xml_node beamEnd = node.select_node("./following-sibling::note[beam[@number='1' and text()='end']]").node();
+    pugi::xml_node beamEnd = SelectNode(node, "./following-sibling::note[beam[@number='1' and text()='end']]").node();
     pugi::xml_node tupletEnd
-        = node.select_node("./following-sibling::note[notations[tuplet[@type='stop']]]").node();
+        = SelectNode(node, "./following-sibling::note[notations[tuplet[@type='stop']]]").node();
 
     const auto measureNodeChildren = currentMeasure.node().children();
     std::vector<pugi::xml_node> currentMeasureNodes(measureNodeChildren.begin(), measureNodeChildren.end());
@@ -3422,7 +3453,7 @@ void MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Laye
     else if (beamStart) {
         // find whether there is a tuplet that starts during the span of the beam
         pugi::xpath_node nextTupletStart
-            = node.select_node("./following-sibling::note[notations[tuplet[@type='start']]]").node();
+            = SelectNode(node, "./following-sibling::note[notations[tuplet[@type='start']]]").node();
 
         // find start and end of the beam
         const auto beamStartIterator = std::find(currentMeasureNodes.begin(), currentMeasureNodes.end(), node);
@@ -3462,11 +3493,11 @@ void MusicXmlInput::ReadMusicXmlTupletStart(const pugi::xml_node &node, const pu
     Tuplet *tuplet = new Tuplet();
     AddLayerElement(layer, tuplet);
     m_elementStackMap.at(layer).push_back(tuplet);
-    int num = node.select_node("time-modification/actual-notes").node().text().as_int();
-    int numbase = node.select_node("time-modification/normal-notes").node().text().as_int();
+    int num = SelectNode(node, "time-modification/actual-notes").node().text().as_int();
+    int numbase = SelectNode(node, "time-modification/normal-notes").node().text().as_int();
     if (tupletStart.first_child()) {
-        num = tupletStart.select_node("tuplet-actual/tuplet-number").node().text().as_int();
-        numbase = tupletStart.select_node("tuplet-normal/tuplet-number").node().text().as_int();
+        num = SelectNode(tupletStart, "tuplet-actual/tuplet-number").node().text().as_int();
+        numbase = SelectNode(tupletStart, "tuplet-normal/tuplet-number").node().text().as_int();
     }
     if (num) tuplet->SetNum(num);
     if (numbase) tuplet->SetNumbase(numbase);
@@ -3479,7 +3510,7 @@ void MusicXmlInput::ReadMusicXmlTupletStart(const pugi::xml_node &node, const pu
 
 void MusicXmlInput::ReadMusicXmlBeamStart(const pugi::xml_node &node, const pugi::xml_node &beamStart, Layer *layer)
 {
-    if (!beamStart || (node.select_node("notations/ornaments/tremolo[@type='start']"))) return;
+    if (!beamStart || (SelectNode(node, "notations/ornaments/tremolo[@type='start']"))) return;
     if (m_elementStackMap.at(layer).size() > 0 && m_elementStackMap.at(layer).back()->Is(BEAM)) {
         LogDebug("MusicXML import: Adding a beam to a beam");
         if (!node.child("grace")) return;
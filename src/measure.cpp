@@ -103,6 +103,13 @@ void Measure::CloneReset()
     m_drawingScoreDef = NULL;
 }
 
+void Measure::Modify(bool modified)
+{
+    Object::Modify(modified);
+
+    if (modified) m_isLayoutModified = true;
+}
+
 void Measure::Reset()
 {
     Object::Reset();
@@ -133,6 +140,7 @@ void Measure::Reset()
 
     m_drawingEnding = NULL;
     m_hasAlignmentRefWithMultipleLayers = false;
+    m_isLayoutModified = true;
 
     m_scoreTimeOffset.clear();
     m_realTimeOffsetMilliseconds.clear();
@@ -427,8 +435,7 @@ Staff *Measure::GetBottomVisibleStaff()
 int Measure::EnclosesTime(int time) const
 {
     int repeat = 1;
-    int timeDuration = int(
-        m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX * 60.0 / m_currentTempo * 1000.0 + 0.5);
+    int timeDuration = this->GetRealTimeDurationMilliseconds();
     std::vector<double>::const_iterator iter;
     for (iter = m_realTimeOffsetMilliseconds.begin(); iter != m_realTimeOffsetMilliseconds.end(); ++iter) {
         if ((time >= *iter) && (time <= *iter + timeDuration)) return repeat;
@@ -443,6 +450,36 @@ double Measure::GetRealTimeOffsetMilliseconds(int repeat) const
     return m_realTimeOffsetMilliseconds.at(repeat - 1);
 }
 
+int Measure::GetRealTimeDurationMilliseconds() const
+{
+    return int(
+        m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX * 60.0 / m_currentTempo * 1000.0 + 0.5);
+}
+
+void Measure::StoreTimemapValues(std::vector<double> &values) const
+{
+    values.push_back(m_currentTempo);
+    values.push_back(m_scoreTimeOffset.size());
+    values.insert(values.end(), m_scoreTimeOffset.begin(), m_scoreTimeOffset.end());
+    values.push_back(m_realTimeOffsetMilliseconds.size());
+    values.insert(values.end(), m_realTimeOffsetMilliseconds.begin(), m_realTimeOffsetMilliseconds.end());
+}
+
+bool Measure::RestoreTimemapValues(const std::vector<double> &values, int &position)
+{
+    if (position + 2 > (int)values.size()) return false;
+    m_currentTempo = values.at(position++);
+
+    for (std::vector<double> *offsets : { &m_scoreTimeOffset, &m_realTimeOffsetMilliseconds }) {
+        if (position >= (int)values.size()) return false;
+        const int count = values.at(position++);
+        if (position + count > (int)values.size()) return false;
+        offsets->assign(values.begin() + position, values.begin() + position + count);
+        position += count;
+    }
+    return true;
+}
+
 data_BARRENDITION Measure::GetDrawingLeftBarLineByStaffN(int staffN) const
 {
     auto elementIter = m_invisibleStaffBarlines.find(staffN);
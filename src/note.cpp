@@ -7,6 +7,7 @@
 
 #include "note.h"
 
+#include <algorithm>
 #include <iostream>
 //----------------------------------------------------------------------------
 
@@ -87,7 +88,22 @@ Note::Note()
     Reset();
 }
 
-Note::~Note() {}
+Note::~Note()
+{
+    // The cluster of the chord must not keep the note once deleted
+    if (m_cluster) {
+        auto it = std::find(m_cluster->begin(), m_cluster->end(), this);
+        if (it != m_cluster->end()) m_cluster->erase(it);
+    }
+}
+
+void Note::CloneReset()
+{
+    LayerElement::CloneReset();
+
+    m_clusterPosition = 0;
+    m_cluster = NULL;
+}
 
 void Note::Reset()
 {
@@ -351,7 +367,7 @@ Point Note::GetStemUpSE(Doc *doc, int staffSize, bool isCueSize)
         p.x = doc->GetGlyphWidth(code, staffSize, isCueSize);
     }
 
-    Glyph *glyph = Resources::GetGlyph(code);
+    const Glyph *glyph = Resources::GetGlyph(code);
     assert(glyph);
 
     if (glyph->HasAnchor(SMUFL_stemUpSE)) {
@@ -382,7 +398,7 @@ Point Note::GetStemDownNW(Doc *doc, int staffSize, bool isCueSize)
         p.x = doc->GetGlyphWidth(code, staffSize, isCueSize);
     }
 
-    Glyph *glyph = Resources::GetGlyph(code);
+    const Glyph *glyph = Resources::GetGlyph(code);
     assert(glyph);
 
     if (glyph->HasAnchor(SMUFL_stemDownNW)) {
@@ -630,6 +646,24 @@ char Note::GetMIDIPitch() const
     return m_MIDIPitch;
 }
 
+void Note::StoreTimemapValues(std::vector<double> &values) const
+{
+    values.insert(values.end(), { m_scoreTimeOnset, m_scoreTimeOffset, m_realTimeOnsetMilliseconds,
+                                    m_realTimeOffsetMilliseconds, m_scoreTimeTiedDuration });
+}
+
+bool Note::RestoreTimemapValues(const std::vector<double> &values, int &position)
+{
+    if (position + 5 > (int)values.size()) return false;
+
+    m_scoreTimeOnset = values.at(position++);
+    m_scoreTimeOffset = values.at(position++);
+    m_realTimeOnsetMilliseconds = values.at(position++);
+    m_realTimeOffsetMilliseconds = values.at(position++);
+    m_scoreTimeTiedDuration = values.at(position++);
+    return true;
+}
+
 int Note::GetChromaticAlteration()
 {
     Accid *accid = this->GetDrawingAccid();
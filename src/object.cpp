@@ -13,6 +13,7 @@
 #include <climits>
 #include <iostream>
 #include <math.h>
+#include <mutex>
 #include <sstream>
 
 //----------------------------------------------------------------------------
@@ -53,11 +54,72 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// AttClassRegistry
+//----------------------------------------------------------------------------
+
+static std::mutex attClassRegistryMutex;
+
+AttClassRegistry::AttClassRegistry(const AttClassRegistry *parent, int key) : m_key(key), m_next(NULL), m_sibling(NULL)
+{
+    if (parent) {
+        m_attClasses = parent->m_attClasses;
+        m_interfaces = parent->m_interfaces;
+    }
+}
+
+const AttClassRegistry *AttClassRegistry::GetEmpty()
+{
+    static const AttClassRegistry *empty = new AttClassRegistry(NULL, -1);
+    return empty;
+}
+
+const AttClassRegistry *AttClassRegistry::AddAttClass(AttClassId attClassId) const
+{
+    return this->GetNext(attClassId, NULL);
+}
+
+const AttClassRegistry *AttClassRegistry::AddInterface(
+    const std::vector<AttClassId> *attClasses, InterfaceId interfaceId) const
+{
+    assert(attClasses);
+
+    return this->GetNext(ATT_CLASS_max + interfaceId, attClasses);
+}
+
+const AttClassRegistry *AttClassRegistry::GetNext(int key, const std::vector<AttClassId> *attClasses) const
+{
+    AttClassRegistry *next;
+    for (next = m_next.load(std::memory_order_acquire); next; next = next->m_sibling.load(std::memory_order_acquire)) {
+        if (next->m_key == key) return next;
+    }
+
+    std::lock_guard<std::mutex> lock(attClassRegistryMutex);
+    // Another thread might have added it in the meantime
+    AttClassRegistry *first = m_next.load(std::memory_order_acquire);
+    for (next = first; next; next = next->m_sibling.load(std::memory_order_acquire)) {
+        if (next->m_key == key) return next;
+    }
+
+    next = new AttClassRegistry(this, key);
+    if (key < ATT_CLASS_max) {
+        next->m_attClasses.set(key);
+    }
+    else {
+        for (AttClassId attClassId : *attClasses) next->m_attClasses.set(attClassId);
+        next->m_interfaces.set(key - ATT_CLASS_max);
+    }
+    next->m_sibling.store(first, std::memory_order_relaxed);
+    m_next.store(next, std::memory_order_release);
+    return next;
+}
+
 //----------------------------------------------------------------------------
 // Object
 //----------------------------------------------------------------------------
 
 thread_local unsigned long Object::s_objectCounter = 0;
+thread_local unsigned long Object::s_uuidRevision = 0;
 
 Object::Object() : BoundingBox()
 {
@@ -96,8 +158,7 @@ Object::Object(const Object &object) : BoundingBox(object)
     m_isReferenceObject = object.m_isReferenceObject;
 
     // Also copy attribute classes
-    m_attClasses = object.m_attClasses;
-    m_interfaces = object.m_interfaces;
+    m_attClassRegistry = object.m_attClassRegistry;
     // New uuid
     this->GenerateUuid();
     // For now do not copy them
@@ -141,8 +202,7 @@ Object &Object::operator=(const Object &object)
         m_isReferenceObject = object.m_isReferenceObject;
 
         // Also copy attribute classes
-        m_attClasses = object.m_attClasses;
-        m_interfaces = object.m_interfaces;
+        m_attClassRegistry = object.m_attClassRegistry;
         // New uuid
         this->GenerateUuid();
         // For now do now copy them
@@ -165,6 +225,7 @@ Object &Object::operator=(const Object &object)
 Object::~Object()
 {
     ClearChildren();
+    ++s_uuidRevision;
 }
 
 void Object::Init(const std::string &classid)
@@ -175,6 +236,7 @@ void Object::Init(const std::string &classid)
     m_isAttribute = false;
     m_isModified = true;
     m_isReferenceObject = false;
+    m_attClassRegistry = AttClassRegistry::GetEmpty();
     // Comments
     m_comment = "";
     m_closingComment = "";
@@ -204,12 +266,6 @@ void Object::Reset()
     ResetBoundingBox();
 }
 
-void Object::RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId)
-{
-    m_attClasses.insert(m_attClasses.end(), attClasses->begin(), attClasses->end());
-    m_interfaces.push_back(interfaceId);
-}
-
 bool Object::IsBoundaryElement()
 {
     if (this->IsEditorialElement() || this->Is(ENDING) || this->Is(SECTION)) {
@@ -299,6 +355,7 @@ void Object::MoveItselfTo(Object *targetParent)
 void Object::SetUuid(std::string uuid)
 {
     m_uuid = uuid;
+    ++s_uuidRevision;
 }
 
 void Object::SwapUuid(Object *other)
@@ -494,10 +551,32 @@ void Object::ClearRelinquishedChildren()
 
 Object *Object::FindDescendantByUuid(std::string uuid, int deepness, bool direction)
 {
+    Doc *doc = NULL;
+    // The uuid index of the Doc can be used only when looking through the entire subtree
+    if ((deepness == UNLIMITED_DEPTH) && (direction == FORWARD)) {
+        Object *root = this;
+        while (root->m_parent) root = root->m_parent;
+        if (root->Is(DOC)) doc = vrv_cast<Doc *>(root);
+    }
+
+    if (doc) {
+        Object *element = doc->GetIndexedObject(uuid);
+        // Make sure the indexed object is a descendant of this one
+        if (element && (element != this)) {
+            Object *ancestor = element->m_parent;
+            while (ancestor && (ancestor != this)) ancestor = ancestor->m_parent;
+            if (ancestor) return element;
+        }
+    }
+
     Functor findByUuid(&Object::FindByUuid);
     FindByUuidParams findbyUuidParams;
     findbyUuidParams.m_uuid = uuid;
     this->Process(&findByUuid, &findbyUuidParams, NULL, NULL, deepness, direction, true);
+
+    // The object was added after the index was built
+    if (doc && findbyUuidParams.m_element) doc->AddToUuidIndex(findbyUuidParams.m_element);
+
     return findbyUuidParams.m_element;
 }
 
@@ -591,6 +670,7 @@ void Object::GenerateUuid()
 void Object::ResetUuid()
 {
     GenerateUuid();
+    ++s_uuidRevision;
 }
 
 void Object::SetParent(Object *parent)
@@ -685,7 +765,8 @@ void Object::Modify(bool modified)
     if (m_parent && modified) {
         m_parent->Modify();
     }
-    m_isModified = modified;
+    // Only write the flag when it changes, since the ancestors are shared by pages laid out in parallel
+    if (m_isModified != modified) m_isModified = modified;
 }
 
 void Object::FillFlatList(ArrayOfObjects *flatList)
@@ -1247,6 +1328,17 @@ int Object::FindByUuid(FunctorParams *functorParams)
     return FUNCTOR_CONTINUE;
 }
 
+int Object::FillUuidIndex(FunctorParams *functorParams)
+{
+    FillUuidIndexParams *params = vrv_params_cast<FillUuidIndexParams *>(functorParams);
+    assert(params);
+
+    // Does not replace the object if the uuid is already in the index
+    params->m_uuidIndex->emplace(this->GetUuid(), this);
+
+    return FUNCTOR_CONTINUE;
+}
+
 int Object::FindByComparison(FunctorParams *functorParams)
 {
     FindByComparisonParams *params = vrv_params_cast<FindByComparisonParams *>(functorParams);
@@ -1495,6 +1587,8 @@ int Object::ScoreDefSetCurrent(FunctorParams *functorParams)
             params->m_drawLabels = true;
         }
         page->m_drawingScoreDef = *params->m_upcomingScoreDef;
+        // The content of a page pending to be cast off continues the last system
+        params->m_continueSystem = (params->m_doc->IsCastOffPending() && (page == page->GetParent()->GetLast()));
         return FUNCTOR_CONTINUE;
     }
 
@@ -1514,18 +1608,22 @@ int Object::ScoreDefSetCurrent(FunctorParams *functorParams)
         int drawingFlags = 0;
         // This is the first measure of the system - more to do...
         if (params->m_currentSystem) {
-            drawingFlags |= Measure::BarlineDrawingFlags::SYSTEM_BREAK;
-            // We had a scoreDef so we need to put cautionnary values
-            // This will also happend with clef in the last measure - however, the cautionnary functor will not do
-            // anything then
-            if (params->m_upcomingScoreDef->m_setAsDrawing && params->m_previousMeasure) {
-                ScoreDef cautionaryScoreDef = *params->m_upcomingScoreDef;
-                SetCautionaryScoreDefParams setCautionaryScoreDefParams(&cautionaryScoreDef);
-                Functor setCautionaryScoreDef(&Object::SetCautionaryScoreDef);
-                params->m_previousMeasure->Process(&setCautionaryScoreDef, &setCautionaryScoreDefParams);
+            // No system break before the content of a pending page since it is laid out as the continuation
+            if (!params->m_continueSystem) {
+                drawingFlags |= Measure::BarlineDrawingFlags::SYSTEM_BREAK;
+                // We had a scoreDef so we need to put cautionnary values
+                // This will also happend with clef in the last measure - however, the cautionnary functor will not
+                // do anything then
+                if (params->m_upcomingScoreDef->m_setAsDrawing && params->m_previousMeasure) {
+                    ScoreDef cautionaryScoreDef = *params->m_upcomingScoreDef;
+                    SetCautionaryScoreDefParams setCautionaryScoreDefParams(&cautionaryScoreDef);
+                    Functor setCautionaryScoreDef(&Object::SetCautionaryScoreDef);
+                    params->m_previousMeasure->Process(&setCautionaryScoreDef, &setCautionaryScoreDefParams);
+                }
+                // Set the flags we want to have. This also sets m_setAsDrawing to true so the next measure will keep
+                // it
+                params->m_upcomingScoreDef->SetRedrawFlags(true, true, false, false, false);
             }
-            // Set the flags we want to have. This also sets m_setAsDrawing to true so the next measure will keep it
-            params->m_upcomingScoreDef->SetRedrawFlags(true, true, false, false, false);
             // Set it to the current system (used e.g. for endings)
             params->m_currentSystem->SetDrawingScoreDef(params->m_upcomingScoreDef);
             params->m_currentSystem->GetDrawingScoreDef()->SetDrawLabels(params->m_drawLabels);
@@ -768,6 +768,18 @@ Options::Options()
     m_standardOutput.SetShortOption(' ', true);
     m_baseOptions.AddOption(&m_standardOutput);
 
+    m_server.SetInfo("Server", "Process newline-delimited JSON jobs read from the standard input with the same toolkit");
+    m_server.Init(false);
+    m_server.SetKey("server");
+    m_server.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_server);
+
+    m_serverSocket.SetInfo("Server socket", "Process the jobs read from a local (Unix) socket at this path");
+    m_serverSocket.Init("");
+    m_serverSocket.SetKey("serverSocket");
+    m_serverSocket.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_serverSocket);
+
     m_help.SetInfo("Help", "Display this message");
     m_help.Init(false);
     m_help.SetKey("help");
@@ -787,6 +799,12 @@ Options::Options()
     m_inputFrom.SetShortOption('f', false);
     m_baseOptions.AddOption(&m_inputFrom);
 
+    m_threads.SetInfo("Threads", "Number of threads for laying out and rendering the pages to SVG with --all-pages");
+    m_threads.Init(1, 1, 256);
+    m_threads.SetKey("threads");
+    m_threads.SetShortOption('j', true);
+    m_baseOptions.AddOption(&m_threads);
+
     m_outfile.SetInfo("Output file", "Output file name (use \"-\" as file name for standard output)");
     m_outfile.Init("svg");
     m_outfile.SetKey("outfile");
@@ -846,6 +864,11 @@ Options::Options()
     m_breaks.Init(BREAKS_auto, &Option::s_breaks);
     this->Register(&m_breaks, "breaks", &m_general);
 
+    m_breaksProgressive.SetInfo("Progressive breaks",
+        "Cast off only the first page when loading and the rest of the document when needed");
+    m_breaksProgressive.Init(false);
+    this->Register(&m_breaksProgressive, "breaksProgressive", &m_general);
+
     m_breaksSmartSb.SetInfo("Smart breaks sb usage threshold",
         "In smart breaks mode, the portion of system width usage at which an encoded sb will be used");
     m_breaksSmartSb.Init(0.66, 0.0, 1.0);
@@ -971,6 +994,10 @@ Options::Options()
     m_shrinkToFit.Init(false);
     this->Register(&m_shrinkToFit, "shrinkToFit", &m_general);
 
+    m_streamMei.SetInfo("Stream MEI", "Import MEI measure by measure without building the XML tree of the full document");
+    m_streamMei.Init(false);
+    this->Register(&m_streamMei, "streamMei", &m_general);
+
     m_svgBoundingBoxes.SetInfo("Svg bounding boxes viewbox on svg root", "Include bounding boxes in SVG output");
     m_svgBoundingBoxes.Init(false);
     this->Register(&m_svgBoundingBoxes, "svgBoundingBoxes", &m_general);
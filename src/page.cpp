@@ -17,6 +17,7 @@
 #include "comparison.h"
 #include "doc.h"
 #include "functorparams.h"
+#include "measure.h"
 #include "pages.h"
 #include "pgfoot.h"
 #include "pgfoot2.h"
@@ -46,6 +47,7 @@ void Page::Reset()
 
     m_drawingScoreDef.Reset();
     m_layoutDone = false;
+    m_layoutSizes.clear();
     this->ResetUuid();
 
     // by default we have no values and use the document ones
@@ -83,11 +85,11 @@ RunningElement *Page::GetHeader() const
     assert(pages);
 
     // first page or use the pgHeader for all pages?
-    if ((pages->GetFirst() == this) || (doc->GetOptions()->m_usePgHeaderForAll.GetValue())) {
-        return doc->m_mdivScoreDef.GetPgHead();
+    if ((pages->GetChildren()->front() == this) || (doc->GetOptions()->m_usePgHeaderForAll.GetValue())) {
+        return doc->GetDrawingRunningElement(doc->m_mdivScoreDef.GetPgHead());
     }
     else {
-        return doc->m_mdivScoreDef.GetPgHead2();
+        return doc->GetDrawingRunningElement(doc->m_mdivScoreDef.GetPgHead2());
     }
 }
 
@@ -102,11 +104,11 @@ RunningElement *Page::GetFooter() const
     assert(pages);
 
     // first page or use the pgFooter for all pages?
-    if ((pages->GetFirst() == this) || (doc->GetOptions()->m_usePgFooterForAll.GetValue())) {
-        return doc->m_mdivScoreDef.GetPgFoot();
+    if ((pages->GetChildren()->front() == this) || (doc->GetOptions()->m_usePgFooterForAll.GetValue())) {
+        return doc->GetDrawingRunningElement(doc->m_mdivScoreDef.GetPgFoot());
     }
     else {
-        return doc->m_mdivScoreDef.GetPgFoot2();
+        return doc->GetDrawingRunningElement(doc->m_mdivScoreDef.GetPgFoot2());
     }
 }
 
@@ -119,13 +121,41 @@ void Page::LayOut(bool force)
         return;
     }
 
+    Doc *doc = vrv_cast<Doc *>(GetFirstAncestor(DOC));
+    assert(doc);
+
+    m_layoutSizes.clear();
+
+    // Filling the aligners marks the measures as modified - keep the modification flags for the incremental layout
+    ListOfObjects measures;
+    ClassIdComparison isMeasure(MEASURE);
+    this->FindAllDescendantByComparison(&measures, &isMeasure, 2);
+    std::vector<bool> layoutModified;
+    for (Object *object : measures) {
+        layoutModified.push_back(vrv_cast<Measure *>(object)->IsLayoutModified());
+    }
+
     this->LayOutHorizontally();
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        m_layoutSizes.push_back(measure->GetWidth());
+        m_layoutSizes.push_back(measure->GetDrawingOverflow());
+    }
+
     this->JustifyHorizontally();
     this->LayOutVertically();
+    for (Object *child : *this->GetChildren()) {
+        if (!child->Is(SYSTEM)) continue;
+        System *system = vrv_cast<System *>(child);
+        assert(system);
+        m_layoutSizes.push_back(system->GetHeight());
+        m_layoutSizes.push_back(system->m_systemAligner.GetOverflowAbove(doc));
+        m_layoutSizes.push_back(system->m_systemAligner.GetOverflowBelow(doc));
+    }
+
     this->JustifyVertically();
 
-    Doc *doc = vrv_cast<Doc *>(GetFirstAncestor(DOC));
-    assert(doc);
     if (doc->GetOptions()->m_svgBoundingBoxes.GetValue()) {
         View view;
         view.SetDoc(doc);
@@ -135,6 +165,11 @@ void Page::LayOut(bool force)
         view.DrawCurrentPage(&bBoxDC, false);
     }
 
+    int i = 0;
+    for (Object *object : measures) {
+        if (!layoutModified.at(i++)) vrv_cast<Measure *>(object)->ResetLayoutModified();
+    }
+
     m_layoutDone = true;
 }
 
@@ -458,14 +493,14 @@ void Page::LayOutVertically()
     AdjustSlursParams adjustSlursParams(doc, &adjustSlurs);
     this->Process(&adjustSlurs, &adjustSlursParams);
 
-    // If slurs were adjusted we need to redraw to adjust the bounding boxes
+    // If slurs were adjusted we need to redraw them to adjust the bounding boxes
+    // Only the slurs are changed by AdjustSlurs, so the rest of the page does not need to be redrawn
     if (adjustSlursParams.m_adjusted) {
         // There is a problem here with cross-staff slurs: if they have been adjusted, the
         // Slur::m_isCrossStaff flag will trigger View::DrawSlurInitial to be called again.
         // The slur will then remain not adjusted. It will again when AdjustSlurs is called below,
         // but in between, we can have wrong collisions detections. To be improved
-        view.SetPage(this->GetIdx(), false);
-        view.DrawCurrentPage(&bBoxDC, false);
+        view.DrawCurrentPageSlurs(&bBoxDC);
     }
 
     // Fill the arrays of bounding boxes (above and below) for each staff alignment for which the box overflows.
@@ -503,8 +538,7 @@ void Page::LayOutVertically()
 
     // Redraw are re-adjust the position of the slurs when we have cross-staff ones
     if (adjustSlursParams.m_crossStaffSlurs) {
-        view.SetPage(this->GetIdx(), false);
-        view.DrawCurrentPage(&bBoxDC, false);
+        view.DrawCurrentPageSlurs(&bBoxDC);
         this->Process(&adjustSlurs, &adjustSlursParams);
     }
 
@@ -518,7 +552,7 @@ void Page::LayOutVertically()
 
     // Adjust system Y position
     AlignSystemsParams alignSystemsParams(doc);
-    alignSystemsParams.m_shift = doc->m_drawingPageContentHeight;
+    alignSystemsParams.m_shift = doc->GetDrawingValues()->m_pageContentHeight;
     alignSystemsParams.m_systemMargin = (doc->GetOptions()->m_spacingSystem.GetValue()) * doc->GetDrawingUnit(100);
     Functor alignSystems(&Object::AlignSystems);
     Functor alignSystemsEnd(&Object::AlignSystemsEnd);
@@ -539,15 +573,16 @@ void Page::JustifyHorizontally()
     assert(this == doc->GetDrawingPage());
 
     if ((doc->GetOptions()->m_adjustPageWidth.GetValue())) {
-        doc->m_drawingPageContentWidth = this->GetContentWidth();
-        doc->m_drawingPageWidth
-            = doc->m_drawingPageContentWidth + doc->m_drawingPageMarginLeft + doc->m_drawingPageMarginRight;
+        DrawingPageValues *drawingValues = doc->GetDrawingValues();
+        drawingValues->m_pageContentWidth = this->GetContentWidth();
+        drawingValues->m_pageWidth
+            = drawingValues->m_pageContentWidth + drawingValues->m_pageMarginLeft + drawingValues->m_pageMarginRight;
     }
     else {
         // Justify X position
         Functor justifyX(&Object::JustifyX);
         JustifyXParams justifyXParams(&justifyX, doc);
-        justifyXParams.m_systemFullWidth = doc->m_drawingPageContentWidth;
+        justifyXParams.m_systemFullWidth = doc->GetDrawingValues()->m_pageContentWidth;
         this->Process(&justifyX, &justifyXParams);
     }
 }
@@ -638,7 +673,7 @@ int Page::GetContentHeight() const
 
     System *last = dynamic_cast<System *>(GetChildren()->back());
     assert(last);
-    int height = doc->m_drawingPageContentHeight - last->GetDrawingYRel() + last->GetHeight();
+    int height = doc->GetDrawingValues()->m_pageContentHeight - last->GetDrawingYRel() + last->GetHeight();
 
     if (this->GetFooter()) {
         height += this->GetFooter()->GetTotalHeight();
@@ -157,7 +157,7 @@ int RunningElement::GetWidth() const
     Doc *doc = dynamic_cast<Doc *>(m_drawingPage->GetFirstAncestor(DOC));
     if (!doc) return 0;
 
-    return (doc->m_drawingPageContentWidth);
+    return (doc->GetDrawingValues()->m_pageContentWidth);
     // return m_drawingPage->GetContentWidth();
 }
 
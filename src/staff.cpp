@@ -85,13 +85,14 @@ void Staff::Reset()
 
 void Staff::CloneReset()
 {
-    Object::CloneReset();
-
+    // The ledger lines belong to the staff copied and must not be deleted when resetting the drawing
     m_ledgerLinesAbove = NULL;
     m_ledgerLinesBelow = NULL;
     m_ledgerLinesAboveCue = NULL;
     m_ledgerLinesBelowCue = NULL;
 
+    Object::CloneReset();
+
     m_drawingStaffSize = 100;
     m_drawingLines = 5;
     m_drawingNotationType = NOTATIONTYPE_NONE;
@@ -29,6 +29,11 @@ Svg::Svg() : Object("fig-")
     Reset();
 }
 
+Svg::Svg(const Svg &svg) : Object(svg)
+{
+    m_svg.append_copy(svg.m_svg.first_child());
+}
+
 Svg::~Svg() {}
 
 void Svg::Reset()
@@ -29,6 +29,56 @@ namespace vrv {
 #define space " "
 #define semicolon ";"
 
+//----------------------------------------------------------------------------
+// SvgStringWriter
+//----------------------------------------------------------------------------
+
+/**
+ * A pugixml writer appending to a string
+ */
+class SvgStringWriter : public pugi::xml_writer {
+public:
+    SvgStringWriter(std::string &output) : m_output(output) {}
+    virtual void write(const void *data, size_t size) { m_output.append(static_cast<const char *>(data), size); }
+
+private:
+    std::string &m_output;
+};
+
+//----------------------------------------------------------------------------
+// SvgNode
+//----------------------------------------------------------------------------
+
+void SvgNode::Reset(const char *name, SvgNode *parent)
+{
+    m_name = name;
+    m_parent = parent;
+    m_depth = (parent) ? parent->m_depth + 1 : 0;
+    m_attributes.clear();
+    m_children.clear();
+    m_firstG = std::string::npos;
+    m_isResumable = false;
+}
+
+bool SvgNode::HasChildNodes() const
+{
+    for (const Child &child : m_children) {
+        if (child.m_node) return true;
+    }
+    return false;
+}
+
+const char *SvgNode::GetAttribute(const char *name, size_t &length) const
+{
+    // attribute values cannot contain '"' since it is escaped
+    std::string search = " " + std::string(name) + "=\"";
+    size_t start = m_attributes.find(search);
+    if (start == std::string::npos) return NULL;
+    start += search.size();
+    length = m_attributes.find('"', start) - start;
+    return m_attributes.c_str() + start;
+}
+
 //----------------------------------------------------------------------------
 // SvgDeviceContext
 //----------------------------------------------------------------------------
@@ -55,20 +105,22 @@ SvgDeviceContext::SvgDeviceContext() : DeviceContext()
     m_facsimile = false;
     m_indent = 2;
 
+    m_leafName = NULL;
+    m_leafParent = NULL;
+    m_leafPosition = SvgNode::APPEND;
+    m_blockSize = 0;
+    m_blockUsed = 0;
+
     // create the initial SVG element
     // width and height need to be set later; these are taken care of in "commit"
-    m_svgNode = m_svgDoc.append_child("svg");
-    m_svgNode.append_attribute("version") = "1.1";
-    m_svgNode.append_attribute("xmlns") = "http://www.w3.org/2000/svg";
-    m_svgNode.append_attribute("xmlns:xlink") = "http://www.w3.org/1999/xlink";
-    m_svgNode.append_attribute("xmlns:mei") = "http://www.music-encoding.org/ns/mei";
-    m_svgNode.append_attribute("overflow") = "visible";
-
-    // start the stack
-    m_svgNodeStack.push_back(m_svgNode);
-    m_currentNode = m_svgNode;
-
-    m_outdata.clear();
+    m_currentNode = NULL;
+    m_svgNode = this->OpenNode("svg", SvgNode::APPEND);
+    this->WriteAttribute(m_svgNode->m_attributes, "version", "1.1");
+    this->WriteAttribute(m_svgNode->m_attributes, "xmlns", "http://www.w3.org/2000/svg");
+    this->WriteAttribute(m_svgNode->m_attributes, "xmlns:xlink", "http://www.w3.org/1999/xlink");
+    this->WriteAttribute(m_svgNode->m_attributes, "xmlns:mei", "http://www.music-encoding.org/ns/mei");
+    this->WriteAttribute(m_svgNode->m_attributes, "overflow", "visible");
+    m_pageNode = NULL;
 
     m_glyphPostfixId = Object::GenerateRandUuid();
 }
@@ -101,66 +153,76 @@ void SvgDeviceContext::Commit(bool xml_declaration)
         format = "%gmm";
     }
 
+    std::string attributes;
     if (m_svgViewBox) {
-        m_svgNode.prepend_attribute("viewBox") = StringFormat("0 0 %g %g", width, height).c_str();
+        this->WriteAttribute(attributes, "viewBox", StringFormat("0 0 %g %g", width, height));
     }
     else {
-        m_svgNode.prepend_attribute("height") = StringFormat(format, height).c_str();
-        m_svgNode.prepend_attribute("width") = StringFormat(format, width).c_str();
+        this->WriteAttribute(attributes, "width", StringFormat(format, width));
+        this->WriteAttribute(attributes, "height", StringFormat(format, height));
     }
+    attributes.append(m_svgNode->m_attributes);
 
-    // add the woff VerovioText font if needed
-    if (m_vrvTextFont) {
-        std::string woff = Resources::GetPath() + "/woff.xml";
-        pugi::xml_document woffDoc;
-        woffDoc.load_file(woff.c_str());
-        m_svgNode.prepend_copy(woffDoc.first_child());
+    m_outdata.clear();
+    if (xml_declaration) {
+        m_outdata.append("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>");
+        if (!m_formatRaw) m_outdata.push_back('\n');
     }
+    m_outdata.append("<svg");
+    m_outdata.append(attributes);
+    m_outdata.push_back('>');
+
+    // add description statement
+    this->WriteIndent(m_outdata, 1);
+    m_outdata.append("<desc>");
+    this->WriteEscaped(m_outdata, StringFormat("Engraved by Verovio %s", GetVersion().c_str()).c_str(), false);
+    m_outdata.append("</desc>");
 
     // header
     if (m_smuflGlyphs.size() > 0) {
 
-        pugi::xml_node defs = m_svgNode.prepend_child("defs");
-        pugi::xml_document sourceDoc;
+        pugi::xml_document defsDoc;
+        pugi::xml_node defs = defsDoc.append_child("defs");
 
         // for each needed glyph
         std::set<std::string>::const_iterator it;
         for (it = m_smuflGlyphs.begin(); it != m_smuflGlyphs.end(); ++it) {
-            // load the XML file that contains it as a pugi::xml_document
-            std::ifstream source((*it).c_str());
-            sourceDoc.load(source);
+            // get the XML document that contains it - already loaded with the font
+            std::shared_ptr<const pugi::xml_document> sourceDoc = Resources::GetXmlResource(*it);
+            if (!sourceDoc) continue;
 
             // copy all the nodes inside into the master document
-            for (pugi::xml_node child = sourceDoc.first_child(); child; child = child.next_sibling()) {
+            for (pugi::xml_node child = sourceDoc->first_child(); child; child = child.next_sibling()) {
+                pugi::xml_node copy = defs.append_copy(child);
                 std::string id = StringFormat("%s-%s", child.attribute("id").value(), m_glyphPostfixId.c_str());
-                child.attribute("id").set_value(id.c_str());
-                defs.append_copy(child);
+                copy.attribute("id").set_value(id.c_str());
             }
         }
+        this->WritePugiNode(m_outdata, defs, 1);
     }
 
-    unsigned int output_flags = pugi::format_default | pugi::format_no_declaration;
-    if (xml_declaration) {
-        // edit the xml declaration
-        output_flags = pugi::format_default;
-        pugi::xml_node decl = m_svgDoc.prepend_child(pugi::node_declaration);
-        decl.append_attribute("version") = "1.0";
-        decl.append_attribute("encoding") = "UTF-8";
-        decl.append_attribute("standalone") = "no";
+    // add the woff VerovioText font if needed
+    if (m_vrvTextFont) {
+        std::shared_ptr<const pugi::xml_document> woffDoc
+            = Resources::GetXmlResource(Resources::GetPath() + "/woff.xml");
+        if (woffDoc) this->WritePugiNode(m_outdata, woffDoc->first_child(), 1);
     }
 
-    if (m_formatRaw) {
-        output_flags |= pugi::format_raw;
-    }
+    // the content of the page - nodes still there are the ones that could have been resumed
+    this->SerializeChildNodes(m_svgNode);
+    size_t length = 0;
+    for (const SvgNode::Child &child : m_svgNode->m_children) length += child.m_length;
+    m_outdata.reserve(m_outdata.size() + length + 16);
+    for (const SvgNode::Child &child : m_svgNode->m_children) m_outdata.append(child.m_text, child.m_length);
 
-    // add description statement
-    pugi::xml_node desc = m_svgNode.prepend_child("desc");
-    desc.append_child(pugi::node_pcdata)
-        .set_value(StringFormat("Engraved by Verovio %s", GetVersion().c_str()).c_str());
+    // the serialized content is no longer needed
+    std::vector<SvgNode::Child>().swap(m_svgNode->m_children);
+    m_resumableNodes.clear();
+    m_blocks.clear();
 
-    // save the glyph data to m_outdata
-    std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-    m_svgDoc.save(m_outdata, indent.c_str(), output_flags);
+    this->WriteIndent(m_outdata, 0);
+    m_outdata.append("</svg>");
+    if (!m_formatRaw) m_outdata.push_back('\n');
 
     m_committed = true;
 }
@@ -175,15 +237,15 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
         }
     }
 
-    if (prepend) {
-        m_currentNode = m_currentNode.prepend_child("g");
-    }
-    else {
-        m_currentNode = m_currentNode.append_child("g");
-    }
-    m_svgNodeStack.push_back(m_currentNode);
+    this->OpenNode("g", (prepend) ? SvgNode::PREPEND : SvgNode::APPEND, true);
     AppendIdAndClass(gId, object->GetClassName(), gClass, primary);
 
+    // keep the graphics that can be resumed with View::DrawTimeSpanningElement, View::DrawEnding or View::DrawTuplet
+    if ((gId == object->GetUuid()) && (m_html5 || primary)
+        && (object->GetTimeSpanningInterface() || object->Is({ ENDING, TUPLET_BRACKET, TUPLET_NUM }))) {
+        m_currentNode->m_isResumable = m_resumableNodes.emplace(gId, m_currentNode).second;
+    }
+
     // this sets staffDef styles for lyrics
     if (object->Is(STAFF)) {
         Staff *staff = vrv_cast<Staff *>(object);
@@ -206,7 +268,7 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
             styleStr.append(
                 "font-weight:" + staff->AttTyped::FontweightToStr(staff->m_drawingStaffDef->GetLyricWeight()) + ";");
         }
-        if (!styleStr.empty()) m_currentNode.append_attribute("style") = styleStr.c_str();
+        if (!styleStr.empty()) this->WriteAttribute(m_currentNode->m_attributes, "style", styleStr.c_str());
     }
 
     if (object->HasAttClass(ATT_COLOR)) {
@@ -214,9 +276,9 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
         assert(att);
         if (att->HasColor()) {
             if (object->IsControlElement()) {
-                m_currentNode.append_attribute("color") = att->GetColor().c_str();
+                this->WriteAttribute(m_currentNode->m_attributes, "color", att->GetColor().c_str());
             }
-            m_currentNode.append_attribute("fill") = att->GetColor().c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "fill", att->GetColor().c_str());
         }
     }
 
@@ -224,9 +286,9 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
         AttLabelled *att = dynamic_cast<AttLabelled *>(object);
         assert(att);
         if (att->HasLabel()) {
-            pugi::xml_node svgTitle = m_currentNode.prepend_child("title");
-            svgTitle.append_attribute("class") = "labelAttr";
-            svgTitle.append_child(pugi::node_pcdata).set_value(att->GetLabel().c_str());
+            std::string &svgTitle = this->StartLeaf("title", m_currentNode, SvgNode::PREPEND);
+            this->WriteAttribute(svgTitle, "class", "labelAttr");
+            this->EndLeaf(att->GetLabel());
         }
     }
 
@@ -234,20 +296,18 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
         AttLang *att = dynamic_cast<AttLang *>(object);
         assert(att);
         if (att->HasLang()) {
-            m_currentNode.append_attribute("xml:lang") = att->GetLang().c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "xml:lang", att->GetLang().c_str());
         }
     }
 
     if (object->HasAttClass(ATT_TYPOGRAPHY)) {
         AttTypography *att = dynamic_cast<AttTypography *>(object);
         assert(att);
-        if (att->HasFontname()) m_currentNode.append_attribute("font-family") = att->GetFontname().c_str();
+        if (att->HasFontname()) this->WriteAttribute(m_currentNode->m_attributes, "font-family", att->GetFontname().c_str());
         if (att->HasFontstyle())
-            m_currentNode.append_attribute("font-style")
-                = att->AttConverter::FontstyleToStr(att->GetFontstyle()).c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "font-style", att->AttConverter::FontstyleToStr(att->GetFontstyle()).c_str());
         if (att->HasFontweight())
-            m_currentNode.append_attribute("font-weight")
-                = att->AttConverter::FontweightToStr(att->GetFontweight()).c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "font-weight", att->AttConverter::FontweightToStr(att->GetFontweight()).c_str());
     }
 
     if (object->HasAttClass(ATT_VISIBILITY)) {
@@ -255,10 +315,10 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
         assert(att);
         if (att->HasVisible()) {
             if (att->GetVisible() == BOOLEAN_true) {
-                m_currentNode.append_attribute("visibility") = "visible";
+                this->WriteAttribute(m_currentNode->m_attributes, "visibility", "visible");
             }
             else if (att->GetVisible() == BOOLEAN_false) {
-                m_currentNode.append_attribute("visibility") = "hidden";
+                this->WriteAttribute(m_currentNode->m_attributes, "visibility", "hidden");
             }
         }
     }
@@ -267,10 +327,10 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
         AttLinking *att = dynamic_cast<AttLinking *>(object);
         assert(att);
         if (att->HasFollows()) {
-            m_currentNode.append_attribute("mei:follows") = att->GetFollows().c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "mei:follows", att->GetFollows().c_str());
         }
         if (att->HasPrecedes()) {
-            m_currentNode.append_attribute("mei:precedes") = att->GetPrecedes().c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "mei:precedes", att->GetPrecedes().c_str());
         }
     }
 
@@ -282,30 +342,28 @@ void SvgDeviceContext::StartGraphic(Object *object, std::string gClass, std::str
 
 void SvgDeviceContext::StartCustomGraphic(std::string name, std::string gClass, std::string gId)
 {
-    m_currentNode = m_currentNode.append_child("g");
-    m_svgNodeStack.push_back(m_currentNode);
+    this->OpenNode("g", SvgNode::APPEND, true);
     AppendIdAndClass(gId, name, gClass);
 }
 
 void SvgDeviceContext::StartTextGraphic(Object *object, std::string gClass, std::string gId)
 {
-    m_currentNode = AppendChild("tspan");
-    m_svgNodeStack.push_back(m_currentNode);
+    this->OpenNode("tspan", SvgNode::BEFORE_FIRST_G);
     AppendIdAndClass(gId, object->GetClassName(), gClass);
 
     if (object->HasAttClass(ATT_COLOR)) {
         AttColor *att = dynamic_cast<AttColor *>(object);
         assert(att);
-        if (att->HasColor()) m_currentNode.append_attribute("fill") = att->GetColor().c_str();
+        if (att->HasColor()) this->WriteAttribute(m_currentNode->m_attributes, "fill", att->GetColor().c_str());
     }
 
     if (object->HasAttClass(ATT_LABELLED)) {
         AttLabelled *att = dynamic_cast<AttLabelled *>(object);
         assert(att);
         if (att->HasLabel()) {
-            pugi::xml_node svgTitle = m_currentNode.prepend_child("title");
-            svgTitle.append_attribute("class") = "labelAttr";
-            svgTitle.append_child(pugi::node_pcdata).set_value(att->GetLabel().c_str());
+            std::string &svgTitle = this->StartLeaf("title", m_currentNode, SvgNode::PREPEND);
+            this->WriteAttribute(svgTitle, "class", "labelAttr");
+            this->EndLeaf(att->GetLabel());
         }
     }
 
@@ -313,27 +371,25 @@ void SvgDeviceContext::StartTextGraphic(Object *object, std::string gClass, std:
         AttLang *att = dynamic_cast<AttLang *>(object);
         assert(att);
         if (att->HasLang()) {
-            m_currentNode.append_attribute("xml:lang") = att->GetLang().c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "xml:lang", att->GetLang().c_str());
         }
     }
 
     if (object->HasAttClass(ATT_TYPOGRAPHY)) {
         AttTypography *att = dynamic_cast<AttTypography *>(object);
         assert(att);
-        if (att->HasFontname()) m_currentNode.append_attribute("font-family") = att->GetFontname().c_str();
+        if (att->HasFontname()) this->WriteAttribute(m_currentNode->m_attributes, "font-family", att->GetFontname().c_str());
         if (att->HasFontstyle())
-            m_currentNode.append_attribute("font-style")
-                = att->AttConverter::FontstyleToStr(att->GetFontstyle()).c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "font-style", att->AttConverter::FontstyleToStr(att->GetFontstyle()).c_str());
         if (att->HasFontweight())
-            m_currentNode.append_attribute("font-weight")
-                = att->AttConverter::FontweightToStr(att->GetFontweight()).c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "font-weight", att->AttConverter::FontweightToStr(att->GetFontweight()).c_str());
     }
 
     if (object->HasAttClass(ATT_WHITESPACE)) {
         AttWhitespace *att = dynamic_cast<AttWhitespace *>(object);
         assert(att);
         if (att->HasSpace()) {
-            m_currentNode.append_attribute("xml:space") = att->GetSpace().c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "xml:space", att->GetSpace().c_str());
             ;
         }
     }
@@ -341,11 +397,9 @@ void SvgDeviceContext::StartTextGraphic(Object *object, std::string gClass, std:
 
 void SvgDeviceContext::ResumeGraphic(Object *object, std::string gId)
 {
-    std::string xpathPrefix = m_html5 ? "//g[@data-id=\"" : "//g[@id=\"";
-    std::string xpath = xpathPrefix + gId + "\"]";
-    pugi::xpath_node selection = m_currentNode.select_node(xpath.c_str());
-    if (selection) {
-        m_currentNode = selection.node();
+    std::map<std::string, SvgNode *>::iterator iter = m_resumableNodes.find(gId);
+    if (iter != m_resumableNodes.end()) {
+        m_currentNode = iter->second;
     }
     m_svgNodeStack.push_back(m_currentNode);
 }
@@ -353,14 +407,12 @@ void SvgDeviceContext::ResumeGraphic(Object *object, std::string gId)
 void SvgDeviceContext::EndGraphic(Object *object, View *view)
 {
     DrawSvgBoundingBox(object, view);
-    m_svgNodeStack.pop_back();
-    m_currentNode = m_svgNodeStack.back();
+    this->CloseNode();
 }
 
 void SvgDeviceContext::EndCustomGraphic()
 {
-    m_svgNodeStack.pop_back();
-    m_currentNode = m_svgNodeStack.back();
+    this->CloseNode();
 }
 
 void SvgDeviceContext::EndResumedGraphic(Object *object, View *view)
@@ -372,17 +424,17 @@ void SvgDeviceContext::EndResumedGraphic(Object *object, View *view)
 void SvgDeviceContext::EndTextGraphic(Object *object, View *view)
 {
     DrawSvgBoundingBox(object, view);
-    m_svgNodeStack.pop_back();
-    m_currentNode = m_svgNodeStack.back();
+    this->CloseNode();
 }
 
 void SvgDeviceContext::RotateGraphic(Point const &orig, double angle)
 {
-    if (m_currentNode.attribute("transform")) {
+    size_t length;
+    if (m_currentNode->GetAttribute("transform", length)) {
         return;
     }
 
-    m_currentNode.append_attribute("transform") = StringFormat("rotate(%f %d,%d)", angle, orig.x, orig.y).c_str();
+    this->WriteAttribute(m_currentNode->m_attributes, "transform", StringFormat("rotate(%f %d,%d)", angle, orig.x, orig.y).c_str());
 }
 
 void SvgDeviceContext::StartPage()
@@ -392,37 +444,31 @@ void SvgDeviceContext::StartPage()
 
     // default styles
     if (this->UseGlobalStyling()) {
-        m_currentNode = m_currentNode.append_child("style");
-        m_currentNode.append_attribute("type") = "text/css";
-        m_currentNode.append_child(pugi::node_pcdata)
-            .set_value("g.page-margin{font-family:Times;} "
-                       //"g.page-margin{background: pink;} "
-                       //"g.bounding-box{stroke:red; stroke-width:10} "
-                       //"g.content-bounding-box{stroke:blue; stroke-width:10} "
-                       "g.ending, g.reh, g.tempo{font-weight:bold;} g.dir, g.dynam, "
-                       "g.mNum{font-style:italic;} g.label{font-weight:normal;}");
-        m_currentNode = m_svgNodeStack.back();
+        std::string &style = this->StartLeaf("style", m_currentNode, SvgNode::APPEND);
+        this->WriteAttribute(style, "type", "text/css");
+        this->EndLeaf("g.page-margin{font-family:Times;} "
+                      //"g.page-margin{background: pink;} "
+                      //"g.bounding-box{stroke:red; stroke-width:10} "
+                      //"g.content-bounding-box{stroke:blue; stroke-width:10} "
+                      "g.ending, g.reh, g.tempo{font-weight:bold;} g.dir, g.dynam, "
+                      "g.mNum{font-style:italic;} g.label{font-weight:normal;}");
     }
 
     // a graphic for definition scaling
-    m_currentNode = m_currentNode.append_child("svg");
-    m_svgNodeStack.push_back(m_currentNode);
-    m_currentNode.append_attribute("class") = "definition-scale";
-    m_currentNode.append_attribute("color") = "black";
+    this->OpenNode("svg", SvgNode::APPEND);
+    this->WriteAttribute(m_currentNode->m_attributes, "class", "definition-scale");
+    this->WriteAttribute(m_currentNode->m_attributes, "color", "black");
     if (this->GetFacsimile()) {
-        m_currentNode.append_attribute("viewBox") = StringFormat("0 0 %d %d", GetWidth(), GetHeight()).c_str();
+        this->WriteAttribute(m_currentNode->m_attributes, "viewBox", StringFormat("0 0 %d %d", GetWidth(), GetHeight()).c_str());
     }
     else {
-        m_currentNode.append_attribute("viewBox")
-            = StringFormat("0 0 %d %d", GetWidth() * DEFINITION_FACTOR, GetContentHeight() * DEFINITION_FACTOR).c_str();
+        this->WriteAttribute(m_currentNode->m_attributes, "viewBox", StringFormat("0 0 %d %d", GetWidth() * DEFINITION_FACTOR, GetContentHeight() * DEFINITION_FACTOR).c_str());
     }
 
     // a graphic for the origin
-    m_currentNode = m_currentNode.append_child("g");
-    m_svgNodeStack.push_back(m_currentNode);
-    m_currentNode.append_attribute("class") = "page-margin";
-    m_currentNode.append_attribute("transform")
-        = StringFormat("translate(%d, %d)", (int)((double)m_originX), (int)((double)m_originY)).c_str();
+    this->OpenNode("g", SvgNode::APPEND, true);
+    this->WriteAttribute(m_currentNode->m_attributes, "class", "page-margin");
+    this->WriteAttribute(m_currentNode->m_attributes, "transform", StringFormat("translate(%d, %d)", (int)((double)m_originX), (int)((double)m_originY)).c_str());
 
     // margin rectangle for debugging
     // pugi::xml_node rect = m_currentNode.append_child("rect");
@@ -436,12 +482,11 @@ void SvgDeviceContext::StartPage()
 void SvgDeviceContext::EndPage()
 {
     // end page-margin
-    m_svgNodeStack.pop_back();
+    this->CloseNode();
     // end definition-scale
-    m_svgNodeStack.pop_back();
+    this->CloseNode();
     // end page-scale
-    // m_svgNodeStack.pop_back();
-    m_currentNode = m_svgNodeStack.back();
+    // this->CloseNode();
 }
 
 void SvgDeviceContext::SetBackground(int colour, int style)
@@ -477,73 +522,337 @@ Point SvgDeviceContext::GetLogicalOrigin()
     return Point(m_originX, m_originY);
 }
 
-pugi::xml_node SvgDeviceContext::AppendChild(std::string name)
+SvgNode *SvgDeviceContext::OpenNode(const char *name, SvgNode::Position position, bool isG)
 {
-    pugi::xml_node g = m_currentNode.child("g");
-    if (g)
-        return m_currentNode.insert_child_before(name.c_str(), g);
-    else
-        return m_currentNode.append_child(name.c_str());
+    SvgNode *node = NULL;
+    if (!m_freeNodes.empty()) {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else {
+        m_nodes.push_back(std::make_unique<SvgNode>());
+        node = m_nodes.back().get();
+    }
+    node->Reset(name, m_currentNode);
+    if (m_currentNode) {
+        SvgNode::Child child;
+        child.m_node = node;
+        this->InsertChild(m_currentNode, child, position, isG);
+    }
+
+    m_currentNode = node;
+    m_svgNodeStack.push_back(m_currentNode);
+    return node;
+}
+
+void SvgDeviceContext::CloseNode()
+{
+    SvgNode *node = m_svgNodeStack.back();
+    m_svgNodeStack.pop_back();
+    m_currentNode = m_svgNodeStack.back();
+
+    // the node can still be needed - it will be serialized in Commit
+    if (node->m_isResumable || !node->m_parent || node->HasChildNodes()) return;
+
+    // serialize the node and release it for reuse
+    this->ReplaceChild(node);
+}
+
+void SvgDeviceContext::InsertChild(SvgNode *parent, const SvgNode::Child &child, SvgNode::Position position, bool isG)
+{
+    size_t index = parent->m_children.size();
+    if (position == SvgNode::PREPEND) {
+        index = 0;
+    }
+    else if ((position == SvgNode::BEFORE_FIRST_G) && (parent->m_firstG != std::string::npos)) {
+        index = parent->m_firstG;
+    }
+    const bool isFirstG = isG && ((parent->m_firstG == std::string::npos) || (index <= parent->m_firstG));
+
+    // merge with the previous text if it is just before in the buffer
+    if (!child.m_node && !isFirstG && (index > 0)) {
+        SvgNode::Child &previous = parent->m_children.at(index - 1);
+        if (!previous.m_node && (previous.m_text + previous.m_length == child.m_text)) {
+            previous.m_length += child.m_length;
+            return;
+        }
+    }
+
+    parent->m_children.insert(parent->m_children.begin() + index, child);
+    if (isFirstG) {
+        parent->m_firstG = index;
+    }
+    else if ((parent->m_firstG != std::string::npos) && (index <= parent->m_firstG)) {
+        ++parent->m_firstG;
+    }
+}
+
+void SvgDeviceContext::ReplaceChild(SvgNode *node)
+{
+    assert(!node->HasChildNodes());
+
+    SvgNode *parent = node->m_parent;
+    assert(parent);
+
+    size_t index = parent->m_children.size();
+    while (index > 0) {
+        --index;
+        if (parent->m_children.at(index).m_node == node) break;
+    }
+    assert(parent->m_children.at(index).m_node == node);
+
+    // the start tag
+    m_leaf.clear();
+    this->WriteIndent(m_leaf, node->m_depth);
+    m_leaf.push_back('<');
+    m_leaf.append(node->m_name);
+    m_leaf.append(node->m_attributes);
+    if (node->m_children.empty()) {
+        m_leaf.append((m_formatRaw) ? "/>" : " />");
+        parent->m_children.at(index) = this->StoreText(m_leaf);
+        m_freeNodes.push_back(node);
+        return;
+    }
+    m_leaf.push_back('>');
+    parent->m_children.at(index) = this->StoreText(m_leaf);
+
+    // the children and the end tag
+    m_leaf.clear();
+    this->WriteIndent(m_leaf, node->m_depth);
+    m_leaf.append("</");
+    m_leaf.append(node->m_name);
+    m_leaf.push_back('>');
+    node->m_children.push_back(this->StoreText(m_leaf));
+    parent->m_children.insert(
+        parent->m_children.begin() + index + 1, node->m_children.begin(), node->m_children.end());
+    if ((parent->m_firstG != std::string::npos) && (index < parent->m_firstG)) {
+        parent->m_firstG += node->m_children.size();
+    }
+
+    // do not keep the capacity of large nodes in the pool
+    if (node->m_children.capacity() > 64) std::vector<SvgNode::Child>().swap(node->m_children);
+    m_freeNodes.push_back(node);
+}
+
+void SvgDeviceContext::SerializeChildNodes(SvgNode *node)
+{
+    size_t i = 0;
+    while (i < node->m_children.size()) {
+        SvgNode *child = node->m_children.at(i).m_node;
+        if (child) {
+            this->SerializeChildNodes(child);
+            this->ReplaceChild(child);
+        }
+        // the serialized child is now at the same position
+        ++i;
+    }
+}
+
+SvgNode::Child SvgDeviceContext::StoreText(const std::string &text)
+{
+    if (m_blocks.empty() || (m_blockSize - m_blockUsed < text.size())) {
+        m_blockSize = std::max((size_t)65536, text.size());
+        m_blocks.push_back(std::unique_ptr<char[]>(new char[m_blockSize]));
+        m_blockUsed = 0;
+    }
+    SvgNode::Child child;
+    child.m_text = m_blocks.back().get() + m_blockUsed;
+    child.m_length = text.size();
+    std::copy(text.begin(), text.end(), m_blocks.back().get() + m_blockUsed);
+    m_blockUsed += text.size();
+    return child;
+}
+
+std::string &SvgDeviceContext::AppendChild(const char *name)
+{
+    return this->StartLeaf(name, m_currentNode, SvgNode::BEFORE_FIRST_G);
+}
+
+std::string &SvgDeviceContext::StartLeaf(const char *name, SvgNode *parent, SvgNode::Position position)
+{
+    assert(parent);
+
+    m_leafName = name;
+    m_leafParent = parent;
+    m_leafPosition = position;
+
+    m_leaf.clear();
+    this->WriteIndent(m_leaf, parent->m_depth + 1);
+    m_leaf.push_back('<');
+    m_leaf.append(name);
+    return m_leaf;
+}
+
+void SvgDeviceContext::EndLeaf()
+{
+    m_leaf.append((m_formatRaw) ? "/>" : " />");
+    this->InsertChild(m_leafParent, this->StoreText(m_leaf), m_leafPosition, false);
+}
+
+void SvgDeviceContext::EndLeaf(const std::string &text)
+{
+    m_leaf.push_back('>');
+    this->WriteEscaped(m_leaf, text.c_str(), false);
+    m_leaf.append("</");
+    m_leaf.append(m_leafName);
+    m_leaf.push_back('>');
+    this->InsertChild(m_leafParent, this->StoreText(m_leaf), m_leafPosition, false);
+}
+
+void SvgDeviceContext::WriteAttribute(std::string &output, const char *name, const std::string &value)
+{
+    this->WriteAttribute(output, name, value.c_str());
+}
+
+void SvgDeviceContext::WriteAttribute(std::string &output, const char *name, const char *value)
+{
+    output.push_back(' ');
+    output.append(name);
+    output.append("=\"");
+    this->WriteEscaped(output, value, true);
+    output.push_back('"');
+}
+
+void SvgDeviceContext::WriteAttribute(std::string &output, const char *name, int value)
+{
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%d", value);
+    this->WriteAttribute(output, name, buffer);
+}
+
+void SvgDeviceContext::WriteAttribute(std::string &output, const char *name, float value)
+{
+    // same precision as pugixml
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%.9g", double(value));
+    this->WriteAttribute(output, name, buffer);
+}
+
+void SvgDeviceContext::WriteEscaped(std::string &output, const char *text, bool attribute)
+{
+    // escape the text as pugixml does
+    for (const char *s = text; *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        switch (c) {
+            case '&': output.append("&amp;"); break;
+            case '<': output.append("&lt;"); break;
+            case '>':
+                if (attribute) {
+                    output.push_back('>');
+                }
+                else {
+                    output.append("&gt;");
+                }
+                break;
+            case '"':
+                if (attribute) {
+                    output.append("&quot;");
+                }
+                else {
+                    output.push_back('"');
+                }
+                break;
+            default:
+                if ((c < 32) && (attribute || ((c != '\t') && (c != '\r') && (c != '\n')))) {
+                    output.append("&#");
+                    output.push_back('0' + c / 10);
+                    output.push_back('0' + c % 10);
+                    output.push_back(';');
+                }
+                else {
+                    output.push_back(*s);
+                }
+        }
+    }
+}
+
+void SvgDeviceContext::WriteIndent(std::string &output, int depth)
+{
+    if (m_formatRaw) return;
+
+    output.push_back('\n');
+    if (m_indent == -1) {
+        output.append(depth, '\t');
+    }
+    else {
+        output.append(depth * m_indent, ' ');
+    }
+}
+
+void SvgDeviceContext::WritePugiNode(std::string &output, pugi::xml_node node, int depth)
+{
+    // pugixml indents the node and adds a newline after it
+    if (!m_formatRaw) output.push_back('\n');
+
+    std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
+    unsigned int flags = pugi::format_default;
+    if (m_formatRaw) flags |= pugi::format_raw;
+
+    SvgStringWriter writer(output);
+    node.print(writer, indent.c_str(), flags, pugi::encoding_auto, depth);
+    if (!m_formatRaw && !output.empty() && (output.back() == '\n')) output.pop_back();
 }
 
 // Drawing methods
 void SvgDeviceContext::DrawQuadBezierPath(Point bezier[3])
 {
-    pugi::xml_node pathChild = AppendChild("path");
-    pathChild.append_attribute("d") = StringFormat("M%d,%d Q%d,%d %d,%d", // Base string
+    std::string &pathChild = this->AppendChild("path");
+    this->WriteAttribute(pathChild, "d", StringFormat("M%d,%d Q%d,%d %d,%d", // Base string
         bezier[0].x, bezier[0].y, // M Command
         bezier[1].x, bezier[1].y, bezier[2].x, bezier[2].y)
-                                          .c_str();
-    pathChild.append_attribute("fill") = "none";
-    pathChild.append_attribute("stroke") = GetColour(m_penStack.top().GetColour()).c_str();
-    pathChild.append_attribute("stroke-linecap") = "round";
-    pathChild.append_attribute("stroke-linejoin") = "round";
-    pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
+                                          .c_str());
+    this->WriteAttribute(pathChild, "fill", "none");
+    this->WriteAttribute(pathChild, "stroke", GetColour(m_penStack.top().GetColour()).c_str());
+    this->WriteAttribute(pathChild, "stroke-linecap", "round");
+    this->WriteAttribute(pathChild, "stroke-linejoin", "round");
+    this->WriteAttribute(pathChild, "stroke-width", m_penStack.top().GetWidth());
     if (m_penStack.top().GetDashLength() > 0) {
         // Since we have stroke-linecap=round, change the dash length to be the percieved length.
         int dashOn = std::max(m_penStack.top().GetDashLength() - m_penStack.top().GetWidth(), 0);
         int dashOff = m_penStack.top().GetDashLength() + m_penStack.top().GetWidth();
-        pathChild.append_attribute("stroke-dasharray") = StringFormat("%d, %d", dashOn, dashOff).c_str();
+        this->WriteAttribute(pathChild, "stroke-dasharray", StringFormat("%d, %d", dashOn, dashOff).c_str());
     }
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawCubicBezierPath(Point bezier[4])
 {
-    pugi::xml_node pathChild = AppendChild("path");
-    pathChild.append_attribute("d") = StringFormat("M%d,%d C%d,%d %d,%d %d,%d", // Base string
+    std::string &pathChild = this->AppendChild("path");
+    this->WriteAttribute(pathChild, "d", StringFormat("M%d,%d C%d,%d %d,%d %d,%d", // Base string
         bezier[0].x, bezier[0].y, // M Command
         bezier[1].x, bezier[1].y, bezier[2].x, bezier[2].y, bezier[3].x, bezier[3].y // Remaining bezier points.
         )
-                                          .c_str();
-    pathChild.append_attribute("fill") = "none";
-    pathChild.append_attribute("stroke") = GetColour(m_penStack.top().GetColour()).c_str();
-    pathChild.append_attribute("stroke-linecap") = "round";
-    pathChild.append_attribute("stroke-linejoin") = "round";
-    pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
+                                          .c_str());
+    this->WriteAttribute(pathChild, "fill", "none");
+    this->WriteAttribute(pathChild, "stroke", GetColour(m_penStack.top().GetColour()).c_str());
+    this->WriteAttribute(pathChild, "stroke-linecap", "round");
+    this->WriteAttribute(pathChild, "stroke-linejoin", "round");
+    this->WriteAttribute(pathChild, "stroke-width", m_penStack.top().GetWidth());
     if (m_penStack.top().GetDashLength() > 0) {
         // Since we have stroke-linecap=round, change the dash length to be the percieved length.
         int dashOn = std::max(m_penStack.top().GetDashLength() - m_penStack.top().GetWidth(), 0);
         int dashOff = m_penStack.top().GetDashLength() + m_penStack.top().GetWidth();
-        pathChild.append_attribute("stroke-dasharray") = StringFormat("%d, %d", dashOn, dashOff).c_str();
+        this->WriteAttribute(pathChild, "stroke-dasharray", StringFormat("%d, %d", dashOn, dashOff).c_str());
     }
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4])
 {
-    pugi::xml_node pathChild = AppendChild("path");
-    pathChild.append_attribute("d")
-        = StringFormat("M%d,%d C%d,%d %d,%d %d,%d C%d,%d %d,%d %d,%d", bezier1[0].x, bezier1[0].y, // M command
+    std::string &pathChild = this->AppendChild("path");
+    this->WriteAttribute(pathChild, "d", StringFormat("M%d,%d C%d,%d %d,%d %d,%d C%d,%d %d,%d %d,%d", bezier1[0].x, bezier1[0].y, // M command
             bezier1[1].x, bezier1[1].y, bezier1[2].x, bezier1[2].y, bezier1[3].x, bezier1[3].y, // First bezier
             bezier2[2].x, bezier2[2].y, bezier2[1].x, bezier2[1].y, bezier2[0].x, bezier2[0].y // Second Bezier
             )
-              .c_str();
+              .c_str());
     // pathChild.append_attribute("fill") = "currentColor";
     // pathChild.append_attribute("fill-opacity") = "1";
-    pathChild.append_attribute("stroke") = GetColour(m_penStack.top().GetColour()).c_str();
-    pathChild.append_attribute("stroke-linecap") = "round";
-    pathChild.append_attribute("stroke-linejoin") = "round";
+    this->WriteAttribute(pathChild, "stroke", GetColour(m_penStack.top().GetColour()).c_str());
+    this->WriteAttribute(pathChild, "stroke-linecap", "round");
+    this->WriteAttribute(pathChild, "stroke-linejoin", "round");
     // pathChild.append_attribute("stroke-opacity") = "1";
-    pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
+    this->WriteAttribute(pathChild, "stroke-width", m_penStack.top().GetWidth());
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawCircle(int x, int y, int radius)
@@ -562,17 +871,18 @@ void SvgDeviceContext::DrawEllipse(int x, int y, int width, int height)
     int rh = height / 2;
     int rw = width / 2;
 
-    pugi::xml_node ellipseChild = AppendChild("ellipse");
-    ellipseChild.append_attribute("cx") = x + rw;
-    ellipseChild.append_attribute("cy") = y + rh;
-    ellipseChild.append_attribute("rx") = rw;
-    ellipseChild.append_attribute("ry") = rh;
-    if (currentBrush.GetOpacity() != 1.0) ellipseChild.append_attribute("fill-opacity") = currentBrush.GetOpacity();
-    if (currentPen.GetOpacity() != 1.0) ellipseChild.append_attribute("stroke-opacity") = currentPen.GetOpacity();
+    std::string &ellipseChild = this->AppendChild("ellipse");
+    this->WriteAttribute(ellipseChild, "cx", x + rw);
+    this->WriteAttribute(ellipseChild, "cy", y + rh);
+    this->WriteAttribute(ellipseChild, "rx", rw);
+    this->WriteAttribute(ellipseChild, "ry", rh);
+    if (currentBrush.GetOpacity() != 1.0) this->WriteAttribute(ellipseChild, "fill-opacity", currentBrush.GetOpacity());
+    if (currentPen.GetOpacity() != 1.0) this->WriteAttribute(ellipseChild, "stroke-opacity", currentPen.GetOpacity());
     if (currentPen.GetWidth() > 0) {
-        ellipseChild.append_attribute("stroke-width") = currentPen.GetWidth();
-        ellipseChild.append_attribute("stroke") = GetColour(m_penStack.top().GetColour()).c_str();
+        this->WriteAttribute(ellipseChild, "stroke-width", currentPen.GetWidth());
+        this->WriteAttribute(ellipseChild, "stroke", GetColour(m_penStack.top().GetColour()).c_str());
     }
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawEllipticArc(int x, int y, int width, int height, double start, double end)
@@ -633,33 +943,33 @@ void SvgDeviceContext::DrawEllipticArc(int x, int y, int width, int height, doub
     else
         fSweep = 0;
 
-    pugi::xml_node pathChild = AppendChild("path");
-    pathChild.append_attribute("d") = StringFormat(
+    std::string &pathChild = this->AppendChild("path");
+    this->WriteAttribute(pathChild, "d", StringFormat(
         "M%d %d A%d %d 0.0 %d %d %d %d", int(xs), int(ys), abs(int(rx)), abs(int(ry)), fArc, fSweep, int(xe), int(ye))
-                                          .c_str();
+                                          .c_str());
     // pathChild.append_attribute("fill") = "currentColor";
-    if (currentBrush.GetOpacity() != 1.0) pathChild.append_attribute("fill-opacity") = currentBrush.GetOpacity();
-    if (currentPen.GetOpacity() != 1.0) pathChild.append_attribute("stroke-opacity") = currentPen.GetOpacity();
+    if (currentBrush.GetOpacity() != 1.0) this->WriteAttribute(pathChild, "fill-opacity", currentBrush.GetOpacity());
+    if (currentPen.GetOpacity() != 1.0) this->WriteAttribute(pathChild, "stroke-opacity", currentPen.GetOpacity());
     if (currentPen.GetWidth() > 0) {
-        pathChild.append_attribute("stroke-width") = currentPen.GetWidth();
-        pathChild.append_attribute("stroke") = GetColour(m_penStack.top().GetColour()).c_str();
+        this->WriteAttribute(pathChild, "stroke-width", currentPen.GetWidth());
+        this->WriteAttribute(pathChild, "stroke", GetColour(m_penStack.top().GetColour()).c_str());
     }
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawLine(int x1, int y1, int x2, int y2)
 {
-    pugi::xml_node pathChild = AppendChild("path");
-    pathChild.append_attribute("d") = StringFormat("M%d %d L%d %d", x1, y1, x2, y2).c_str();
-    pathChild.append_attribute("stroke") = GetColour(m_penStack.top().GetColour()).c_str();
+    std::string &pathChild = this->AppendChild("path");
+    this->WriteAttribute(pathChild, "d", StringFormat("M%d %d L%d %d", x1, y1, x2, y2).c_str());
+    this->WriteAttribute(pathChild, "stroke", GetColour(m_penStack.top().GetColour()).c_str());
     if (m_penStack.top().GetLineCap() > 0) {
-        pathChild.append_attribute("stroke-linecap") = "round";
-        pathChild.append_attribute("stroke-dasharray")
-            = StringFormat("1, %d", int(2.5 * m_penStack.top().GetDashLength())).c_str();
+        this->WriteAttribute(pathChild, "stroke-linecap", "round");
+        this->WriteAttribute(pathChild, "stroke-dasharray", StringFormat("1, %d", int(2.5 * m_penStack.top().GetDashLength())).c_str());
     }
     else if (m_penStack.top().GetDashLength() > 0)
-        pathChild.append_attribute("stroke-dasharray")
-            = StringFormat("%d, %d", m_penStack.top().GetDashLength(), m_penStack.top().GetDashLength()).c_str();
-    if (m_penStack.top().GetWidth() > 1) pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
+        this->WriteAttribute(pathChild, "stroke-dasharray", StringFormat("%d, %d", m_penStack.top().GetDashLength(), m_penStack.top().GetDashLength()).c_str());
+    if (m_penStack.top().GetWidth() > 1) this->WriteAttribute(pathChild, "stroke-width", m_penStack.top().GetWidth());
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawPolygon(int n, Point points[], int xoffset, int yoffset, int fill_style)
@@ -670,25 +980,26 @@ void SvgDeviceContext::DrawPolygon(int n, Point points[], int xoffset, int yoffs
     Pen currentPen = m_penStack.top();
     Brush currentBrush = m_brushStack.top();
 
-    pugi::xml_node polygonChild = AppendChild("polygon");
+    std::string &polygonChild = this->AppendChild("polygon");
     // if (fillStyle == wxODDEVEN_RULE)
     //    polygonChild.append_attribute("fill-rule") = "evenodd;";
     // else
-    if (currentPen.GetWidth() > 0) polygonChild.append_attribute("stroke") = GetColour(currentPen.GetColour()).c_str();
+    if (currentPen.GetWidth() > 0) this->WriteAttribute(polygonChild, "stroke", GetColour(currentPen.GetColour()).c_str());
     if (currentPen.GetWidth() > 1)
-        polygonChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
+        this->WriteAttribute(polygonChild, "stroke-width", StringFormat("%d", currentPen.GetWidth()).c_str());
     if (currentPen.GetOpacity() != 1.0)
-        polygonChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+        this->WriteAttribute(polygonChild, "stroke-opacity", StringFormat("%f", currentPen.GetOpacity()).c_str());
     if (currentBrush.GetColour() != AxNONE)
-        polygonChild.append_attribute("fill") = GetColour(currentBrush.GetColour()).c_str();
+        this->WriteAttribute(polygonChild, "fill", GetColour(currentBrush.GetColour()).c_str());
     if (currentBrush.GetOpacity() != 1.0)
-        polygonChild.append_attribute("fill-opacity") = StringFormat("%f", currentBrush.GetOpacity()).c_str();
+        this->WriteAttribute(polygonChild, "fill-opacity", StringFormat("%f", currentBrush.GetOpacity()).c_str());
 
     std::string pointsString;
     for (int i = 0; i < n; ++i) {
         pointsString += StringFormat("%d,%d ", points[i].x + xoffset, points[i].y + yoffset);
     }
-    polygonChild.append_attribute("points") = pointsString.c_str();
+    this->WriteAttribute(polygonChild, "points", pointsString.c_str());
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawRectangle(int x, int y, int width, int height)
@@ -698,23 +1009,23 @@ void SvgDeviceContext::DrawRectangle(int x, int y, int width, int height)
 
 void SvgDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height, int radius)
 {
-    pugi::xml_node rectChild = AppendChild("rect");
+    std::string &rectChild = this->AppendChild("rect");
 
     if (m_penStack.size()) {
         Pen currentPen = m_penStack.top();
-        if (currentPen.GetWidth() > 0) rectChild.append_attribute("stroke") = GetColour(currentPen.GetColour()).c_str();
+        if (currentPen.GetWidth() > 0) this->WriteAttribute(rectChild, "stroke", GetColour(currentPen.GetColour()).c_str());
         if (currentPen.GetWidth() > 1)
-            rectChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
+            this->WriteAttribute(rectChild, "stroke-width", StringFormat("%d", currentPen.GetWidth()).c_str());
         if (currentPen.GetOpacity() != 1.0)
-            rectChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+            this->WriteAttribute(rectChild, "stroke-opacity", StringFormat("%f", currentPen.GetOpacity()).c_str());
     }
 
     if (m_brushStack.size()) {
         Brush currentBrush = m_brushStack.top();
         if (currentBrush.GetColour() != AxNONE)
-            rectChild.append_attribute("fill") = GetColour(currentBrush.GetColour()).c_str();
+            this->WriteAttribute(rectChild, "fill", GetColour(currentBrush.GetColour()).c_str());
         if (currentBrush.GetOpacity() != 1.0)
-            rectChild.append_attribute("fill-opacity") = StringFormat("%f", currentBrush.GetOpacity()).c_str();
+            this->WriteAttribute(rectChild, "fill-opacity", StringFormat("%f", currentBrush.GetOpacity()).c_str());
     }
 
     // negative heights or widths are not allowed in SVG
@@ -727,11 +1038,12 @@ void SvgDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height,
         x -= width;
     }
 
-    rectChild.append_attribute("x") = x;
-    rectChild.append_attribute("y") = y;
-    rectChild.append_attribute("height") = height;
-    rectChild.append_attribute("width") = width;
-    if (radius != 0) rectChild.append_attribute("rx") = radius;
+    this->WriteAttribute(rectChild, "x", x);
+    this->WriteAttribute(rectChild, "y", y);
+    this->WriteAttribute(rectChild, "height", height);
+    this->WriteAttribute(rectChild, "width", width);
+    if (radius != 0) this->WriteAttribute(rectChild, "rx", radius);
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::StartText(int x, int y, data_HORIZONTALALIGNMENT alignment)
@@ -746,45 +1058,44 @@ void SvgDeviceContext::StartText(int x, int y, data_HORIZONTALALIGNMENT alignmen
         anchor = "middle";
     }
 
-    m_currentNode = m_currentNode.append_child("text");
-    m_svgNodeStack.push_back(m_currentNode);
-    m_currentNode.append_attribute("x") = x;
-    m_currentNode.append_attribute("y") = y;
+    this->OpenNode("text", SvgNode::APPEND);
+    this->WriteAttribute(m_currentNode->m_attributes, "x", x);
+    this->WriteAttribute(m_currentNode->m_attributes, "y", y);
     // unless dx, dy have a value they don't need to be set
     // m_currentNode.append_attribute("dx") = 0;
     // m_currentNode.append_attribute("dy") = 0;
     if (!anchor.empty()) {
-        m_currentNode.append_attribute("text-anchor") = anchor.c_str();
+        this->WriteAttribute(m_currentNode->m_attributes, "text-anchor", anchor.c_str());
     }
     // font-size seems to be required in <text> in FireFox and also we set it to 0px so space
     // is not added between tspan elements
-    m_currentNode.append_attribute("font-size") = "0px";
+    this->WriteAttribute(m_currentNode->m_attributes, "font-size", "0px");
     //
     if (!m_fontStack.top()->GetFaceName().empty()) {
-        m_currentNode.append_attribute("font-family") = m_fontStack.top()->GetFaceName().c_str();
+        this->WriteAttribute(m_currentNode->m_attributes, "font-family", m_fontStack.top()->GetFaceName().c_str());
     }
     if (m_fontStack.top()->GetStyle() != FONTSTYLE_NONE) {
         if (m_fontStack.top()->GetStyle() == FONTSTYLE_italic) {
-            m_currentNode.append_attribute("font-style") = "italic";
+            this->WriteAttribute(m_currentNode->m_attributes, "font-style", "italic");
         }
         else if (m_fontStack.top()->GetStyle() == FONTSTYLE_normal) {
-            m_currentNode.append_attribute("font-style") = "normal";
+            this->WriteAttribute(m_currentNode->m_attributes, "font-style", "normal");
         }
         else if (m_fontStack.top()->GetStyle() == FONTSTYLE_oblique) {
-            m_currentNode.append_attribute("font-style") = "oblique";
+            this->WriteAttribute(m_currentNode->m_attributes, "font-style", "oblique");
         }
     }
     if (m_fontStack.top()->GetWeight() != FONTWEIGHT_NONE) {
         if (m_fontStack.top()->GetWeight() == FONTWEIGHT_bold) {
-            m_currentNode.append_attribute("font-weight") = "bold";
+            this->WriteAttribute(m_currentNode->m_attributes, "font-weight", "bold");
         }
     }
 }
 
 void SvgDeviceContext::MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment)
 {
-    m_currentNode.append_attribute("x") = x;
-    m_currentNode.append_attribute("y") = y;
+    this->WriteAttribute(m_currentNode->m_attributes, "x", x);
+    this->WriteAttribute(m_currentNode->m_attributes, "y", y);
     if (alignment != HORIZONTALALIGNMENT_NONE) {
         std::string anchor = "start";
         if (alignment == HORIZONTALALIGNMENT_right) {
@@ -793,19 +1104,18 @@ void SvgDeviceContext::MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignme
         if (alignment == HORIZONTALALIGNMENT_center) {
             anchor = "middle";
         }
-        m_currentNode.append_attribute("text-anchor") = anchor.c_str();
+        this->WriteAttribute(m_currentNode->m_attributes, "text-anchor", anchor.c_str());
     }
 }
 
 void SvgDeviceContext::MoveTextVerticallyTo(int y)
 {
-    m_currentNode.append_attribute("y") = y;
+    this->WriteAttribute(m_currentNode->m_attributes, "y", y);
 }
 
 void SvgDeviceContext::EndText()
 {
-    m_svgNodeStack.pop_back();
-    m_currentNode = m_svgNodeStack.back();
+    this->CloseNode();
 }
 
 // draw text element with optional parameters to specify the bounding box of the text
@@ -825,50 +1135,58 @@ void SvgDeviceContext::DrawText(const std::string &text, const std::wstring wtex
         svgText.replace(svgText.size() - 1, 1, "\xC2\xA0");
     }
 
-    std::string currentFaceName
-        = (m_currentNode.attribute("font-family")) ? m_currentNode.attribute("font-family").value() : "";
+    // The attribute value is escaped and we compare it to the escaped font name
+    size_t currentFaceLength = 0;
+    const char *currentFaceName = m_currentNode->GetAttribute("font-family", currentFaceLength);
     std::string fontFaceName = m_fontStack.top()->GetFaceName();
+    std::string escapedFaceName;
+    this->WriteEscaped(escapedFaceName, fontFaceName.c_str(), true);
+    const bool sameFaceName
+        = currentFaceName && (escapedFaceName.compare(0, std::string::npos, currentFaceName, currentFaceLength) == 0);
 
-    pugi::xml_node textChild = AppendChild("tspan");
+    std::string &textChild = this->AppendChild("tspan");
     // We still add @xml::space (No: this seems to create problems with Safari)
     // textChild.append_attribute("xml:space") = "preserve";
     // Set the @font-family only if it is not the same as in the parent node
-    if (!fontFaceName.empty() && (fontFaceName != currentFaceName)) {
-        textChild.append_attribute("font-family") = m_fontStack.top()->GetFaceName().c_str();
+    if (!fontFaceName.empty() && !sameFaceName) {
+        this->WriteAttribute(textChild, "font-family", m_fontStack.top()->GetFaceName().c_str());
         // Special case where we want to specifiy if the VerovioText font (woff) needs to be included in the output
         if (fontFaceName == "VerovioText") this->VrvTextFont();
     }
     if (m_fontStack.top()->GetPointSize() != 0) {
-        textChild.append_attribute("font-size") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+        this->WriteAttribute(textChild, "font-size", StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str());
     }
     if (m_fontStack.top()->GetStyle() != FONTSTYLE_NONE) {
         if (m_fontStack.top()->GetStyle() == FONTSTYLE_italic) {
-            textChild.append_attribute("font-style") = "italic";
+            this->WriteAttribute(textChild, "font-style", "italic");
         }
         else if (m_fontStack.top()->GetStyle() == FONTSTYLE_normal) {
-            textChild.append_attribute("font-style") = "normal";
+            this->WriteAttribute(textChild, "font-style", "normal");
         }
         else if (m_fontStack.top()->GetStyle() == FONTSTYLE_oblique) {
-            textChild.append_attribute("font-style") = "oblique";
+            this->WriteAttribute(textChild, "font-style", "oblique");
         }
     }
-    textChild.append_attribute("class") = "text";
-    textChild.append_child(pugi::node_pcdata).set_value(svgText.c_str());
+    this->WriteAttribute(textChild, "class", "text");
 
-    if ((x != 0) && (y != 0) && (x != VRV_UNSET) && (y != VRV_UNSET)
-        && (width != 0) && (height != 0) && (width != VRV_UNSET) && (height != VRV_UNSET)) {
-        pugi::xml_node g = m_currentNode.parent().parent();
-        pugi::xml_node rectChild = g.append_child("rect");
-        rectChild.append_attribute("class") = "sylTextRect";
-        rectChild.append_attribute("x") = StringFormat("%d", x).c_str();
-        rectChild.append_attribute("y") = StringFormat("%d", y).c_str();
-        rectChild.append_attribute("width") = StringFormat("%d", width).c_str();
-        rectChild.append_attribute("height") = StringFormat("%d", height).c_str();
-        rectChild.append_attribute("opacity") = "0.0";
+    const bool hasRect = ((x != 0) && (y != 0) && (x != VRV_UNSET) && (y != VRV_UNSET) && (width != 0)
+        && (height != 0) && (width != VRV_UNSET) && (height != VRV_UNSET));
+    if (!hasRect && (x != 0) && (y != 0) && (x != VRV_UNSET) && (y != VRV_UNSET)) {
+        this->WriteAttribute(textChild, "x", StringFormat("%d", x).c_str());
+        this->WriteAttribute(textChild, "y", StringFormat("%d", y).c_str());
     }
-    else if ((x != 0) && (y != 0) && (x != VRV_UNSET) && (y != VRV_UNSET)) {
-        textChild.append_attribute("x") = StringFormat("%d", x).c_str();
-        textChild.append_attribute("y") = StringFormat("%d", y).c_str();
+    this->EndLeaf(svgText);
+
+    SvgNode *g = (m_currentNode->m_parent) ? m_currentNode->m_parent->m_parent : NULL;
+    if (hasRect && g) {
+        std::string &rectChild = this->StartLeaf("rect", g, SvgNode::APPEND);
+        this->WriteAttribute(rectChild, "class", "sylTextRect");
+        this->WriteAttribute(rectChild, "x", StringFormat("%d", x).c_str());
+        this->WriteAttribute(rectChild, "y", StringFormat("%d", y).c_str());
+        this->WriteAttribute(rectChild, "width", StringFormat("%d", width).c_str());
+        this->WriteAttribute(rectChild, "height", StringFormat("%d", height).c_str());
+        this->WriteAttribute(rectChild, "opacity", "0.0");
+        this->EndLeaf();
     }
 }
 
@@ -892,7 +1210,7 @@ void SvgDeviceContext::DrawMusicText(const std::wstring &text, int x, int y, boo
     // print chars one by one
     for (unsigned int i = 0; i < text.length(); ++i) {
         wchar_t c = text.at(i);
-        Glyph *glyph = Resources::GetGlyph(c);
+        const Glyph *glyph = Resources::GetGlyph(c);
         if (!glyph) {
             continue;
         }
@@ -903,18 +1221,19 @@ void SvgDeviceContext::DrawMusicText(const std::wstring &text, int x, int y, boo
         m_smuflGlyphs.insert(path);
 
         // Write the char in the SVG
-        pugi::xml_node useChild = AppendChild("use");
-        useChild.append_attribute(hrefAttrib.c_str())
-            = StringFormat("#%s-%s", glyph->GetCodeStr().c_str(), m_glyphPostfixId.c_str()).c_str();
-        useChild.append_attribute("x") = x;
-        useChild.append_attribute("y") = y;
-        useChild.append_attribute("height") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
-        useChild.append_attribute("width") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+        std::string &useChild = this->AppendChild("use");
+        this->WriteAttribute(useChild, hrefAttrib.c_str(),
+            StringFormat("#%s-%s", glyph->GetCodeStr().c_str(), m_glyphPostfixId.c_str()).c_str());
+        this->WriteAttribute(useChild, "x", x);
+        this->WriteAttribute(useChild, "y", y);
+        this->WriteAttribute(useChild, "height", StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str());
+        this->WriteAttribute(useChild, "width", StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str());
         if (m_fontStack.top()->GetWidthToHeightRatio() != 1.0f) {
-            useChild.append_attribute("transform") = StringFormat("matrix(%f,0,0,1,%f,0)",
+            this->WriteAttribute(useChild, "transform", StringFormat("matrix(%f,0,0,1,%f,0)",
                 m_fontStack.top()->GetWidthToHeightRatio(), x * (1. - m_fontStack.top()->GetWidthToHeightRatio()))
-                                                         .c_str();
+                                                         .c_str());
         }
+        this->EndLeaf();
 
         // Get the bounds of the char
         if (glyph->GetHorizAdvX() > 0)
@@ -930,11 +1249,13 @@ void SvgDeviceContext::DrawSpline(int n, Point points[]) {}
 
 void SvgDeviceContext::DrawSvgShape(int x, int y, int width, int height, pugi::xml_node svg)
 {
-    m_currentNode.append_attribute("transform")
-        = StringFormat("translate(%d, %d) scale(%d, %d)", x, y, DEFINITION_FACTOR, DEFINITION_FACTOR).c_str();
+    this->WriteAttribute(m_currentNode->m_attributes, "transform", StringFormat("translate(%d, %d) scale(%d, %d)", x, y, DEFINITION_FACTOR, DEFINITION_FACTOR).c_str());
 
     for (pugi::xml_node child : svg.children()) {
-        m_currentNode.append_copy(child);
+        m_leaf.clear();
+        this->WritePugiNode(m_leaf, child, m_currentNode->m_depth + 1);
+        const bool isG = (child.type() == pugi::node_element) && (std::string(child.name()) == "g");
+        this->InsertChild(m_currentNode, this->StoreText(m_leaf), SvgNode::APPEND, isG);
     }
 }
 
@@ -942,8 +1263,8 @@ void SvgDeviceContext::DrawBackgroundImage(int x, int y) {}
 
 void SvgDeviceContext::AddDescription(const std::string &text)
 {
-    pugi::xml_node desc = m_currentNode.append_child("desc");
-    desc.append_child(pugi::node_pcdata).set_value(text.c_str());
+    this->StartLeaf("desc", m_currentNode, SvgNode::APPEND);
+    this->EndLeaf(text);
 }
 
 void SvgDeviceContext::AppendIdAndClass(std::string gId, std::string baseClass, std::string addedClasses, bool primary)
@@ -952,17 +1273,17 @@ void SvgDeviceContext::AppendIdAndClass(std::string gId, std::string baseClass,
 
     if (gId.length() > 0) {
         if (m_html5) {
-            m_currentNode.append_attribute("data-id") = gId.c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "data-id", gId.c_str());
         }
         else if (primary) {
             // Don't write ids for HTML5 to avoid id clashes when embedding into
             // an HTML document.
-            m_currentNode.append_attribute("id") = gId.c_str();
+            this->WriteAttribute(m_currentNode->m_attributes, "id", gId.c_str());
         }
     }
 
     if (m_html5) {
-        m_currentNode.append_attribute("data-class") = baseClass.c_str();
+        this->WriteAttribute(m_currentNode->m_attributes, "data-class", baseClass.c_str());
     }
 
     if (!primary) {
@@ -971,7 +1292,7 @@ void SvgDeviceContext::AppendIdAndClass(std::string gId, std::string baseClass,
     if (!addedClasses.empty()) {
         baseClass.append(" " + addedClasses);
     }
-    m_currentNode.append_attribute("class") = baseClass.c_str();
+    this->WriteAttribute(m_currentNode->m_attributes, "class", baseClass.c_str());
 }
 
 std::string SvgDeviceContext::GetColour(int colour)
@@ -1003,7 +1324,7 @@ std::string SvgDeviceContext::GetStringSVG(bool xml_declaration)
 {
     if (!m_committed) Commit(xml_declaration);
 
-    return m_outdata.str();
+    return m_outdata;
 }
 
 void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int height)
@@ -1020,13 +1341,14 @@ void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int
         x -= width;
     }
 
-    pugi::xml_node rectChild = AppendChild("rect");
-    rectChild.append_attribute("x") = x;
-    rectChild.append_attribute("y") = y;
-    rectChild.append_attribute("height") = height;
-    rectChild.append_attribute("width") = width;
+    std::string &rectChild = this->AppendChild("rect");
+    this->WriteAttribute(rectChild, "x", x);
+    this->WriteAttribute(rectChild, "y", y);
+    this->WriteAttribute(rectChild, "height", height);
+    this->WriteAttribute(rectChild, "width", width);
 
-    rectChild.append_attribute("fill") = "transparent";
+    this->WriteAttribute(rectChild, "fill", "transparent");
+    this->EndLeaf();
 }
 
 void SvgDeviceContext::DrawSvgBoundingBox(Object *object, View *view)
@@ -1047,7 +1369,7 @@ void SvgDeviceContext::DrawSvgBoundingBox(Object *object, View *view)
             if (!box) return;
         }
 
-        pugi::xml_node currentNode = m_currentNode;
+        SvgNode *currentNode = m_currentNode;
         if (groupInPage) {
             m_currentNode = m_pageNode;
         }
@@ -1069,7 +1391,7 @@ void SvgDeviceContext::DrawSvgBoundingBox(Object *object, View *view)
 
             for (iter = anchors.begin(); iter != anchors.end(); ++iter) {
                 if (object->GetBoundingBoxGlyph() != 0) {
-                    Glyph *glyph = Resources::GetGlyph(object->GetBoundingBoxGlyph());
+                    const Glyph *glyph = Resources::GetGlyph(object->GetBoundingBoxGlyph());
                     assert(glyph);
 
                     if (glyph->HasAnchor(*iter)) {
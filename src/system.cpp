@@ -9,6 +9,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <assert.h>
 
 //----------------------------------------------------------------------------
@@ -36,10 +37,64 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// SpannedElementList
+//----------------------------------------------------------------------------
+
+void SpannedElementList::Add(Object *object)
+{
+    assert(object);
+
+    int maxRight = m_maxRights.empty() ? VRV_UNSET : m_maxRights.back();
+    if (object->Is(TIE)) {
+        m_tieIndexes.push_back((int)m_objects.size());
+    }
+    else {
+        LayerElement *element = vrv_cast<LayerElement *>(object);
+        assert(element);
+        // ScoreDef elements are skipped by the functor and have no position in the system
+        if (!element->IsScoreDefElement()) {
+            maxRight = std::max(maxRight, element->GetDrawingX());
+            if (element->HasContentBB()) maxRight = std::max(maxRight, element->GetContentRight());
+        }
+    }
+    m_objects.push_back(object);
+    m_maxRights.push_back(maxRight);
+}
+
+void SpannedElementList::Clear()
+{
+    m_objects.clear();
+    m_maxRights.clear();
+    m_tieIndexes.clear();
+}
+
+void SpannedElementList::FindSpannedLayerElements(FindSpannedLayerElementsParams *params) const
+{
+    assert(params);
+
+    // Layer elements ending before the minimum position can neither be added nor stop the search
+    const int minPos = std::min(params->m_minPos, params->m_maxPos);
+    const int first = int(std::upper_bound(m_maxRights.begin(), m_maxRights.end(), minPos) - m_maxRights.begin());
+
+    // Ties are looked at wherever they are
+    for (int tieIdx : m_tieIndexes) {
+        if (tieIdx >= first) break;
+        m_objects.at(tieIdx)->FindSpannedLayerElements(params);
+    }
+
+    for (int i = first; i < (int)m_objects.size(); ++i) {
+        if (m_objects.at(i)->FindSpannedLayerElements(params) == FUNCTOR_STOP) break;
+    }
+}
+
 //----------------------------------------------------------------------------
 // System
 //----------------------------------------------------------------------------
 
+const std::vector<ClassId> System::s_spannedElementClassIds
+    = { ACCID, ARTIC, CHORD, CLEF, FLAG, NOTE, STEM, TIE, TUPLET_BRACKET, TUPLET_NUM };
+
 System::System() : Object("system-"), DrawingListInterface(), AttTyped()
 {
     RegisterAttClass(ATT_TYPED);
@@ -81,6 +136,8 @@ void System::Reset()
     m_drawingLabelsWidth = 0;
     m_drawingAbbrLabelsWidth = 0;
     m_drawingIsOptimized = false;
+
+    this->ResetSpannedElementIndex();
 }
 
 bool System::IsSupportedChild(Object *child)
@@ -272,8 +329,7 @@ curvature_CURVEDIR System::GetPreferredCurveDirection(LayerElement *start, Layer
     Layer *layerStart = vrv_cast<Layer *>(start->GetFirstAncestor(LAYER));
     assert(layerStart);
 
-    Functor findSpannedLayerElements(&Object::FindSpannedLayerElements);
-    Process(&findSpannedLayerElements, &findSpannedLayerElementsParams, NULL);
+    this->FindSpannedLayerElements(&findSpannedLayerElementsParams);
 
     curvature_CURVEDIR preferredDirection = curvature_CURVEDIR_NONE;
     for (auto element : findSpannedLayerElementsParams.m_elements) {
@@ -300,6 +356,58 @@ curvature_CURVEDIR System::GetPreferredCurveDirection(LayerElement *start, Layer
     return preferredDirection;
 }
 
+void System::ResetSpannedElementIndex()
+{
+    m_spannedElementIndexIsValid = false;
+    m_spannedElements.Clear();
+    m_spannedElementsByStaff.clear();
+}
+
+void System::FindSpannedLayerElements(FindSpannedLayerElementsParams *params, int staffN)
+{
+    assert(params);
+
+    if (!m_spannedElementIndexIsValid) {
+        ListOfObjects objects;
+        ClassIdsComparison matchType(s_spannedElementClassIds);
+        this->FindAllDescendantByComparison(&objects, &matchType);
+
+        // Objects not within a staff (e.g., ties) are kept with VRV_UNSET and added to all staves
+        std::vector<int> staffNs;
+        staffNs.reserve(objects.size());
+        m_spannedElementsByStaff[VRV_UNSET];
+        for (Object *object : objects) {
+            Staff *staff = vrv_cast<Staff *>(object->GetFirstAncestor(STAFF));
+            staffNs.push_back(staff ? staff->GetN() : VRV_UNSET);
+            if (staff) m_spannedElementsByStaff[staff->GetN()];
+        }
+
+        int i = 0;
+        for (Object *object : objects) {
+            m_spannedElements.Add(object);
+            if (staffNs.at(i) != VRV_UNSET) {
+                m_spannedElementsByStaff.at(staffNs.at(i)).Add(object);
+            }
+            else {
+                for (auto &staffList : m_spannedElementsByStaff) staffList.second.Add(object);
+            }
+            ++i;
+        }
+        m_spannedElementIndexIsValid = true;
+    }
+
+    if (staffN == VRV_UNSET) {
+        m_spannedElements.FindSpannedLayerElements(params);
+        return;
+    }
+
+    // With a staff @n not in the system only the objects outside a staff are looked at
+    auto iter = m_spannedElementsByStaff.find(staffN);
+    if (iter == m_spannedElementsByStaff.end()) iter = m_spannedElementsByStaff.find(VRV_UNSET);
+    assert(iter != m_spannedElementsByStaff.end());
+    iter->second.FindSpannedLayerElements(params);
+}
+
 void System::AddToDrawingListIfNeccessary(Object *object)
 {
     assert(object);
@@ -762,117 +870,7 @@ int System::AdjustFloatingPositioners(FunctorParams *functorParams)
     AdjustFloatingPositionersParams *params = vrv_params_cast<AdjustFloatingPositionersParams *>(functorParams);
     assert(params);
 
-    params->m_inBetween = false;
-
-    AdjustFloatingPositionerGrpsParams adjustFloatingPositionerGrpsParams(params->m_doc);
-    Functor adjustFloatingPositionerGrps(&Object::AdjustFloatingPositionerGrps);
-
-    params->m_classId = GLISS;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = TIE;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = SLUR;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = PHRASE;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = MORDENT;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = TURN;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = TRILL;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = DYNAM;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = HAIRPIN;
-    m_systemAligner.Process(params->m_functor, params);
-
-    adjustFloatingPositionerGrpsParams.m_classIds.clear();
-    adjustFloatingPositionerGrpsParams.m_classIds.push_back(DYNAM);
-    adjustFloatingPositionerGrpsParams.m_classIds.push_back(HAIRPIN);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_above;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_below;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-
-    params->m_classId = BRACKETSPAN;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = OCTAVE;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = BREATH;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = FERMATA;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = FING;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = DIR;
-    m_systemAligner.Process(params->m_functor, params);
-
-    adjustFloatingPositionerGrpsParams.m_classIds.clear();
-    adjustFloatingPositionerGrpsParams.m_classIds.push_back(DIR);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_above;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_below;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-
-    params->m_classId = TEMPO;
-    m_systemAligner.Process(params->m_functor, params);
-
-    params->m_classId = PEDAL;
-    m_systemAligner.Process(params->m_functor, params);
-
-    adjustFloatingPositionerGrpsParams.m_classIds.clear();
-    adjustFloatingPositionerGrpsParams.m_classIds.push_back(PEDAL);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_above;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_below;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-
-    params->m_classId = HARM;
-    m_systemAligner.Process(params->m_functor, params);
-
-    adjustFloatingPositionerGrpsParams.m_classIds.clear();
-    adjustFloatingPositionerGrpsParams.m_classIds.push_back(HARM);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_above;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_below;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-
-    params->m_classId = ENDING;
-    m_systemAligner.Process(params->m_functor, params);
-
-    adjustFloatingPositionerGrpsParams.m_classIds.clear();
-    adjustFloatingPositionerGrpsParams.m_classIds.push_back(ENDING);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_above;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-    adjustFloatingPositionerGrpsParams.m_place = STAFFREL_below;
-    m_systemAligner.Process(&adjustFloatingPositionerGrps, &adjustFloatingPositionerGrpsParams);
-
-    params->m_classId = REH;
-    m_systemAligner.Process(params->m_functor, params);
-
-    // SYL check if they are some lyrics and make space for them if any
-    params->m_classId = SYL;
-    m_systemAligner.Process(params->m_functor, params);
-
-    /**** Process elements that needs to be put in between ****/
-
-    params->m_inBetween = true;
-    // All of them with no particular processing order.
-    // The resulting layout order will correspond to the order in the encoding.
-    params->m_classId = OBJECT;
+    // All the classes are processed staff by staff in StaffAlignment::AdjustFloatingPositioners
     m_systemAligner.Process(params->m_functor, params);
 
     return FUNCTOR_SIBLINGS;
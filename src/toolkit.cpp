@@ -10,7 +10,9 @@
 //----------------------------------------------------------------------------
 
 #include <assert.h>
+#include <atomic>
 #include <regex>
+#include <thread>
 
 //----------------------------------------------------------------------------
 
@@ -33,6 +35,7 @@
 #include "note.h"
 #include "options.h"
 #include "page.h"
+#include "pages.h"
 #include "slur.h"
 #include "staff.h"
 #include "svgdevicecontext.h"
@@ -101,6 +104,7 @@ Toolkit::~Toolkit()
 bool Toolkit::SetResourcePath(const std::string &path)
 {
     Resources::SetPath(path);
+    m_doc.GetTextExtentCache()->Reset();
     return Resources::InitFonts();
 }
 
@@ -123,7 +127,7 @@ bool Toolkit::SetOutputTo(std::string const &outputTo)
     else if (outputTo == "midi") {
         m_outputTo = MIDI;
     }
-    else if (outputTo == "timemap") {
+    else if ((outputTo == "timemap") || (outputTo == "timemap-bin")) {
         m_outputTo = TIMEMAP;
     }
     else if (outputTo == "pae") {
@@ -258,6 +262,28 @@ bool Toolkit::LoadFile(const std::string &filename)
         return LoadZipFile(filename);
     }
 
+    m_doc.m_expansionMap.Reset();
+
+    if (m_options->m_streamMei.GetValue()) {
+        // Identify the format from the beginning of the file and stream it if it is MEI
+        std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!stream.is_open()) {
+            return false;
+        }
+        auto inputFormat = m_inputFrom;
+        if (inputFormat == AUTO) {
+            std::string excerpt(2000, 0);
+            stream.read(&excerpt[0], excerpt.size());
+            excerpt.resize(stream.gcount());
+            inputFormat = IdentifyInputFrom(excerpt);
+            stream.clear();
+            stream.seekg(0, std::ios::beg);
+        }
+        if (inputFormat == MEI) {
+            return this->LoadMEIStream(stream);
+        }
+    }
+
     std::ifstream in(filename.c_str());
     if (!in.is_open()) {
         return false;
@@ -272,11 +298,60 @@ bool Toolkit::LoadFile(const std::string &filename)
     std::string content(fileSize, 0);
     in.read(&content[0], fileSize);
 
-    m_doc.m_expansionMap.Reset();
-
     return LoadData(content);
 }
 
+bool Toolkit::LoadMEIStream(std::istream &stream)
+{
+    m_layoutOptions.clear();
+    m_midiTimemapKey.clear();
+
+#ifndef NO_HUMDRUM_SUPPORT
+    ClearHumdrumBuffer();
+#endif
+
+    MEIInput *input = new MEIInput(&m_doc);
+    if (!input->ImportStream(stream)) {
+        LogError("Error importing data");
+        delete input;
+        return false;
+    }
+
+    return this->PrepareImportedDoc(input);
+}
+
+Input *Toolkit::ImportConvertedHumdrum(const std::string &humdrum, std::string &meiData)
+{
+#ifndef NO_HUMDRUM_SUPPORT
+    bool viaMEI = (!m_options->m_mdivXPathQuery.GetValue().empty() || !m_options->m_appXPathQuery.GetValue().empty()
+        || !m_options->m_choiceXPathQuery.GetValue().empty() || !m_options->m_substXPathQuery.GetValue().empty());
+
+    if (!viaMEI) {
+        HumdrumInput *input = new HumdrumInput(&m_doc);
+        if (!input->Import(humdrum)) {
+            delete input;
+            return NULL;
+        }
+        // The Humdrum data is already in the Humdrum buffer, no need to keep it while laying out the document
+        input->ReleaseHumdrumData();
+        return input;
+    }
+
+    Doc tempdoc;
+    tempdoc.SetOptions(m_doc.GetOptions());
+    HumdrumInput tempinput(&tempdoc);
+    if (!tempinput.Import(humdrum)) {
+        return NULL;
+    }
+    MEIOutput meioutput(&tempdoc);
+    meioutput.SetScoreBasedMEI(true);
+    meiData = meioutput.GetOutput();
+    return new MEIInput(&m_doc);
+#else
+    return NULL;
+#endif
+}
+
 bool Toolkit::IsUTF16(const std::string &filename)
 {
     std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
@@ -417,6 +492,22 @@ bool Toolkit::LoadData(const std::string &data)
 {
     std::string newData;
     Input *input = NULL;
+    bool imported = false;
+
+    m_layoutOptions.clear();
+
+    // Keep the MIDI timemap of the current document if the same data is loaded again with the same timing options
+    const std::string midiTimemapKey = this->GetMidiTimemapKey(data);
+    if ((m_midiTimemapKey == midiTimemapKey) && m_doc.HasMidiTimemap()
+        && ((m_midiTimemapData.m_key != midiTimemapKey)
+            || (m_midiTimemapData.m_tempoAdjustment != m_options->m_midiTempoAdjustment.GetValue()))) {
+        m_doc.GetMidiTimemapData(m_midiTimemapData);
+        m_midiTimemapData.m_key = midiTimemapKey;
+    }
+    else if (m_midiTimemapData.m_key != midiTimemapKey) {
+        m_midiTimemapData.Reset();
+    }
+    m_midiTimemapKey.clear();
 
 #ifndef NO_HUMDRUM_SUPPORT
     ClearHumdrumBuffer();
@@ -465,6 +556,7 @@ bool Toolkit::LoadData(const std::string &data)
             delete input;
             return false;
         }
+        imported = true;
         SetHumdrumBuffer(((HumdrumInput *)input)->GetHumdrumString().c_str());
         if (GetOutputTo() == HUMDRUM) {
             // Humdrum data will be output (post-filtering data),
@@ -532,39 +624,24 @@ bool Toolkit::LoadData(const std::string &data)
         SetHumdrumBuffer(buffer.c_str());
 
         // Now convert Humdrum into MEI:
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion.str())) {
+        input = this->ImportConvertedHumdrum(conversion.str(), newData);
+        if (!input) {
             LogError("Error importing Humdrum data (2)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        imported = newData.empty();
     }
 
     else if (inputFormat == MEIHUM) {
         ConvertMEIToHumdrum(data);
 
         // Now convert Humdrum into MEI:
-        std::string conversion = GetHumdrumBuffer();
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion)) {
+        input = this->ImportConvertedHumdrum(GetHumdrumBuffer(), newData);
+        if (!input) {
             LogError("Error importing Humdrum data (3)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        imported = newData.empty();
     }
 
     else if (inputFormat == MUSEDATAHUM) {
@@ -580,19 +657,12 @@ bool Toolkit::LoadData(const std::string &data)
         SetHumdrumBuffer(buffer.c_str());
 
         // Now convert Humdrum into MEI:
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion.str())) {
+        input = this->ImportConvertedHumdrum(conversion.str(), newData);
+        if (!input) {
             LogError("Error importing Humdrum data (4)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        imported = newData.empty();
     }
 
     else if (inputFormat == ESAC) {
@@ -608,19 +678,12 @@ bool Toolkit::LoadData(const std::string &data)
         SetHumdrumBuffer(buffer.c_str());
 
         // Now convert Humdrum into MEI:
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion.str())) {
+        input = this->ImportConvertedHumdrum(conversion.str(), newData);
+        if (!input) {
             LogError("Error importing Humdrum data (5)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        imported = newData.empty();
     }
 #endif
     else {
@@ -635,7 +698,7 @@ bool Toolkit::LoadData(const std::string &data)
     }
 
     // load the file
-    if (inputFormat != HUMDRUM) {
+    if (!imported) {
         if (!input->Import(newData.size() ? newData : data)) {
             LogError("Error importing data");
             delete input;
@@ -643,6 +706,19 @@ bool Toolkit::LoadData(const std::string &data)
         }
     }
 
+    if (!this->PrepareImportedDoc(input)) return false;
+
+    // The timemap will be restored from the data when needed
+    m_midiTimemapKey = midiTimemapKey;
+    if (m_midiTimemapData.m_key == midiTimemapKey) m_doc.SetMidiTimemapData(&m_midiTimemapData);
+
+    return true;
+}
+
+bool Toolkit::PrepareImportedDoc(Input *input)
+{
+    assert(input);
+
     bool adjustPageHeight = m_options->m_adjustPageHeight.GetValue();
     int footerOption = m_options->m_footer.GetValue();
     // With adjusted page height, show the footer if explicitly set (i.e., not with "auto")
@@ -709,6 +785,14 @@ bool Toolkit::LoadData(const std::string &data)
         }
     }
 
+    // Keep the options for the incremental layout if the cast-off is the one RedoLayout would do
+    if (!m_doc.IsMensuralMusicOnly()
+        && ((breaks == BREAKS_auto)
+            || (input->HasLayoutInformation() && (breaks == BREAKS_line || breaks == BREAKS_smart)))) {
+        m_doc.ResetLayoutModified();
+        m_layoutOptions = this->GetLayoutOptions();
+    }
+
     delete input;
     m_view.SetDoc(&m_doc);
 
@@ -788,6 +872,37 @@ bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptio
     return true;
 }
 
+std::string Toolkit::GetMidiTimemapKey(const std::string &data) const
+{
+    // The data is identified with its size and a hash
+    std::string key = std::to_string(data.size()) + ":" + std::to_string(std::hash<std::string>()(data)) + "\n";
+    key += "inputFrom=" + std::to_string(m_inputFrom) + "\n";
+
+    // The options changing the content loaded
+    std::vector<Option *> options = { &m_options->m_expand, &m_options->m_humType, &m_options->m_mensuralToMeasure,
+        &m_options->m_preserveAnalyticalMarkup };
+    const std::vector<Option *> *selectors = m_options->m_selectors.GetOptions();
+    options.insert(options.end(), selectors->begin(), selectors->end());
+    for (Option *option : options) {
+        key += option->GetKey() + "=" + option->GetStrValue() + "\n";
+    }
+
+    return key;
+}
+
+std::string Toolkit::GetLayoutOptions() const
+{
+    std::string layoutOptions;
+
+    const MapOfStrOptions *params = m_options->GetItems();
+    MapOfStrOptions::const_iterator iter;
+    for (iter = params->begin(); iter != params->end(); ++iter) {
+        layoutOptions += iter->first + "=" + iter->second->GetStrValue() + "\n";
+    }
+
+    return layoutOptions;
+}
+
 std::string Toolkit::GetOptions(bool defaultValues) const
 {
     jsonxx::Object o;
@@ -974,6 +1089,7 @@ bool Toolkit::SetOptions(const std::string &jsonOptions)
     if (!Resources::SetFont(m_options->m_font.GetValue())) {
         LogWarning("Font '%s' could not be loaded", m_options->m_font.GetValue().c_str());
     }
+    m_doc.GetTextExtentCache()->Reset();
 
     return true;
 }
@@ -997,6 +1113,7 @@ bool Toolkit::SetOption(const std::string &option, const std::string &value)
     }
     Option *opt = m_options->GetItems()->at(option);
     assert(opt);
+    m_doc.GetTextExtentCache()->Reset();
     return opt->SetValue(value);
 }
 
@@ -1059,7 +1176,20 @@ bool Toolkit::Edit(const std::string &editorAction)
 {
     this->ResetLogBuffer();
 
-    return m_editorToolkit->ParseEditorAction(editorAction);
+    // The document will not match the data loaded anymore
+    m_midiTimemapKey.clear();
+
+    bool success = m_editorToolkit->ParseEditorAction(editorAction);
+
+    // The layout is redone once when a transaction is committed or a step undone
+    if (m_editorToolkit->EndAction()) {
+        std::vector<std::string> editLog;
+        editLog.swap(logBuffer);
+        this->RedoLayout();
+        logBuffer.insert(logBuffer.begin(), editLog.begin(), editLog.end());
+    }
+
+    return success;
 }
 
 std::string Toolkit::EditInfo()
@@ -1091,11 +1221,18 @@ void Toolkit::RedoLayout()
 {
     this->ResetLogBuffer();
 
-    if ((GetPageCount() == 0) || (m_doc.GetType() == Transcription) || (m_doc.GetType() == Facs)) {
+    // Pending pages of a progressive cast-off are left as they are if the layout can be redone incrementally
+    if ((m_doc.GetPageCount() == 0) || (m_doc.GetType() == Transcription) || (m_doc.GetType() == Facs)) {
         LogWarning("No data to re-layout");
         return;
     }
 
+    // With unchanged options, only the pages with modified measures need to be laid out again
+    const std::string layoutOptions = this->GetLayoutOptions();
+    if ((layoutOptions == m_layoutOptions) && m_doc.LayOutModifiedMeasures()) {
+        return;
+    }
+
     m_doc.UnCastOffDoc();
     if (m_options->m_breaks.GetValue() == BREAKS_line) {
         m_doc.CastOffLineDoc();
@@ -1106,6 +1243,9 @@ void Toolkit::RedoLayout()
     else {
         m_doc.CastOffDoc();
     }
+
+    m_doc.ResetLayoutModified();
+    m_layoutOptions = layoutOptions;
 }
 
 void Toolkit::RedoPagePitchPosLayout()
@@ -1124,7 +1264,16 @@ void Toolkit::RedoPagePitchPosLayout()
 
 bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
 {
-    if (pageNo > GetPageCount()) {
+    return this->RenderToDeviceContext(&m_view, pageNo, deviceContext);
+}
+
+bool Toolkit::RenderToDeviceContext(View *view, int pageNo, DeviceContext *deviceContext)
+{
+    assert(view);
+
+    // The pages before the pending one of a progressive cast-off can be rendered before the rest is cast off
+    const bool isPageCastOff = m_doc.IsCastOffPending() && (pageNo < m_doc.GetPageCount());
+    if (!isPageCastOff && (pageNo > GetPageCount())) {
         LogWarning("Page %d does not exist", pageNo);
         return false;
     }
@@ -1133,7 +1282,7 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     pageNo--;
 
     // Get the current system for the SVG clipping size
-    m_view.SetPage(pageNo);
+    view->SetPage(pageNo);
 
     // Adjusting page width and height according to the options
     int width = m_options->m_pageWidth.GetUnfactoredValue();
@@ -1153,7 +1302,7 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     // set dimensions
     deviceContext->SetWidth(width);
     deviceContext->SetHeight(height);
-    double userScale = m_view.GetPPUFactor() * m_options->m_scale.GetValue() / 100;
+    double userScale = view->GetPPUFactor() * m_options->m_scale.GetValue() / 100;
     deviceContext->SetUserScale(userScale, userScale);
 
     if (m_doc.GetType() == Facs) {
@@ -1162,7 +1311,7 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     }
 
     // render the page
-    m_view.DrawCurrentPage(deviceContext, false);
+    view->DrawCurrentPage(deviceContext, false);
 
     return true;
 }
@@ -1172,6 +1321,15 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
     this->ResetLogBuffer();
 
     int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    std::string out_str = this->RenderToSVG(&m_view, pageNo, xmlDeclaration);
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return out_str;
+}
+
+std::string Toolkit::RenderToSVG(View *view, int pageNo, bool xmlDeclaration)
+{
     // Create the SVG object, h & w come from the system
     // We will need to set the size of the page after having drawn it depending on the options
     SvgDeviceContext svg;
@@ -1201,11 +1359,82 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
     svg.SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
 
     // render the page
-    RenderToDeviceContext(pageNo, &svg);
+    this->RenderToDeviceContext(view, pageNo, &svg);
 
-    std::string out_str = svg.GetStringSVG(xmlDeclaration);
-    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
-    return out_str;
+    return svg.GetStringSVG(xmlDeclaration);
+}
+
+std::vector<std::string> Toolkit::RenderAllPagesToSVG(int threads, bool xmlDeclaration)
+{
+    this->ResetLogBuffer();
+
+    std::vector<std::string> output(this->GetPageCount());
+    if (output.empty()) return output;
+
+    // Set the current scoreDef and fill the staffDef list of the doc once, before the pages are laid out in parallel
+    m_doc.ScoreDefSetCurrentDoc();
+    m_doc.m_mdivScoreDef.GetStaffNs();
+    // Also mark the ancestors of the pages as modified since laying out a page marks them as modified
+    m_doc.GetPages()->Modify();
+
+    const std::vector<std::pair<int, int>> pageRanges = m_doc.GetIndependentPageRanges();
+    threads = std::max(1, std::min(threads, (int)pageRanges.size()));
+
+    // Each thread has its own drawing values with its own copy of the running elements
+    std::vector<DrawingPageValues> drawingValues(threads);
+    for (DrawingPageValues &values : drawingValues) {
+        m_doc.CopyRunningElements(&values);
+    }
+
+    // The view sets its slur thickness coefficient when drawing the first slur and keeps it for the following pages.
+    // The pages up to the first slur are rendered with the toolkit view, which is then copied for the other pages.
+    int sequentialRanges = 0;
+    Object *slur = m_doc.FindDescendantByType(SLUR);
+    Object *slurPage = (slur) ? slur->GetFirstAncestor(PAGE) : NULL;
+    if (slurPage) {
+        while (pageRanges.at(sequentialRanges).second < slurPage->GetIdx()) ++sequentialRanges;
+        ++sequentialRanges;
+    }
+    m_doc.SetThreadDrawingValues(&drawingValues.at(0));
+    for (int range = 0; range < sequentialRanges; ++range) {
+        for (int idx = pageRanges.at(range).first; idx <= pageRanges.at(range).second; ++idx) {
+            output.at(idx) = this->RenderToSVG(&m_view, idx + 1, xmlDeclaration);
+        }
+    }
+    m_doc.SetThreadDrawingValues(NULL);
+
+    const std::string font = m_options->m_font.GetValue();
+    std::atomic<int> nextRange(sequentialRanges);
+
+    auto renderPageRanges = [&](int thread) {
+        // The fonts are shared but the threads we start need to select them
+        if (thread > 0) {
+            Resources::InitFonts();
+            Resources::SetFont(font);
+        }
+        m_doc.SetThreadDrawingValues(&drawingValues.at(thread));
+        for (int range = nextRange++; range < (int)pageRanges.size(); range = nextRange++) {
+            // Use a view for each range for the output not to depend on the pages previously drawn by the thread
+            View view;
+            view.SetDoc(&m_doc);
+            view.CopyThicknessCoeficients(m_view);
+            for (int idx = pageRanges.at(range).first; idx <= pageRanges.at(range).second; ++idx) {
+                output.at(idx) = this->RenderToSVG(&view, idx + 1, xmlDeclaration);
+            }
+        }
+        m_doc.SetThreadDrawingValues(NULL);
+    };
+
+    std::vector<std::thread> workers;
+    for (int thread = 1; thread < threads; ++thread) {
+        workers.push_back(std::thread(renderPageRanges, thread));
+    }
+    renderPageRanges(0);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    return output;
 }
 
 bool Toolkit::RenderToSVGFile(const std::string &filename, int pageNo)
@@ -1269,6 +1498,26 @@ std::string Toolkit::RenderToMIDI()
     return outputstr;
 }
 
+bool Toolkit::RenderToMIDIBinary(std::vector<unsigned char> &output)
+{
+    this->ResetLogBuffer();
+
+    smf::MidiFile outputfile;
+    outputfile.absoluteTicks();
+    m_doc.ExportMIDI(&outputfile);
+    outputfile.sortTracks();
+
+    std::stringstream strstrem;
+    if (!outputfile.write(strstrem)) {
+        output.clear();
+        return false;
+    }
+    const std::string &data = strstrem.str();
+    output.assign(data.begin(), data.end());
+
+    return true;
+}
+
 std::string Toolkit::RenderToPAE()
 {
     this->ResetLogBuffer();
@@ -1314,35 +1563,62 @@ std::string Toolkit::GetElementsAtTime(int millisec)
 {
     this->ResetLogBuffer();
 
-    jsonxx::Object o;
+    // Here we need to check that the midi timemap is done
+    if (!m_doc.HasMidiTimemap()) {
+        // generate MIDI timemap before progressing
+        m_doc.CalculateMidiTimemap();
+    }
+
+    return this->GetElementsAtTimeObject(millisec).json();
+}
+
+std::string Toolkit::GetElementsAtTimes(const std::string &jsonTimes)
+{
+    this->ResetLogBuffer();
+
+    jsonxx::Array times;
     jsonxx::Array a;
 
+    if (!times.parse(jsonTimes)) {
+        LogError("Cannot parse JSON std::string.");
+        return a.json();
+    }
+
     // Here we need to check that the midi timemap is done
     if (!m_doc.HasMidiTimemap()) {
         // generate MIDI timemap before progressing
         m_doc.CalculateMidiTimemap();
     }
 
-    MeasureOnsetOffsetComparison matchMeasureTime(millisec);
-    Measure *measure = dynamic_cast<Measure *>(m_doc.FindDescendantByComparison(&matchMeasureTime));
+    for (int i = 0; i < (int)times.size(); ++i) {
+        if (!times.has<jsonxx::Number>(i)) {
+            LogWarning("Skipping time at position %d, which is not a number", i);
+            a << jsonxx::Object();
+            continue;
+        }
+        a << this->GetElementsAtTimeObject(times.get<jsonxx::Number>(i));
+    }
+
+    return a.json();
+}
+
+jsonxx::Object Toolkit::GetElementsAtTimeObject(int millisec)
+{
+    jsonxx::Object o;
+    jsonxx::Array a;
+
+    ListOfObjects notes;
+    Measure *measure = m_doc.FindNotesAtTime(millisec, &notes);
 
     if (!measure) {
-        return o.json();
+        return o;
     }
 
-    int repeat = measure->EnclosesTime(millisec);
-    int measureTimeOffset = measure->GetRealTimeOffsetMilliseconds(repeat);
-
     // Get the pageNo from the first note (if any)
     int pageNo = -1;
     Page *page = dynamic_cast<Page *>(measure->GetFirstAncestor(PAGE));
     if (page) pageNo = page->GetIdx() + 1;
 
-    NoteOnsetOffsetComparison matchNoteTime(millisec - measureTimeOffset);
-    ListOfObjects notes;
-
-    measure->FindAllDescendantByComparison(&notes, &matchNoteTime);
-
     // Fill the JSON object
     ListOfObjects::iterator iter;
     for (iter = notes.begin(); iter != notes.end(); ++iter) {
@@ -1351,7 +1627,7 @@ std::string Toolkit::GetElementsAtTime(int millisec)
     o << "notes" << a;
     o << "page" << pageNo;
 
-    return o.json();
+    return o;
 }
 
 bool Toolkit::RenderToMIDIFile(const std::string &filename)
@@ -1383,13 +1659,41 @@ bool Toolkit::RenderToTimemapFile(const std::string &filename)
     return true;
 }
 
+bool Toolkit::RenderToTimemapBinary(std::vector<unsigned char> &output)
+{
+    this->ResetLogBuffer();
+
+    return m_doc.ExportTimemapBinary(output);
+}
+
+bool Toolkit::RenderToTimemapBinaryFile(const std::string &filename)
+{
+    this->ResetLogBuffer();
+
+    std::vector<unsigned char> outputBuffer;
+    if (!m_doc.ExportTimemapBinary(outputBuffer)) return false;
+
+    std::ofstream output(filename.c_str(), std::ios::binary);
+    if (!output.is_open()) {
+        return false;
+    }
+    output.write(reinterpret_cast<const char *>(outputBuffer.data()), outputBuffer.size());
+
+    return true;
+}
+
 int Toolkit::GetPageCount()
 {
+    // The page count is known only once the entire document is cast off
+    m_doc.CastOffPendingDoc();
+
     return m_doc.GetPageCount();
 }
 
 int Toolkit::GetPageWithElement(const std::string &xmlId)
 {
+    m_doc.CastOffPendingDoc();
+
     Object *element = m_doc.FindDescendantByUuid(xmlId);
     if (!element) {
         return 0;
@@ -1565,6 +1869,17 @@ void Toolkit::SetCString(const std::string &data)
     strcpy(m_cString, data.c_str());
 }
 
+void Toolkit::SetCBuffer(std::vector<unsigned char> &data)
+{
+    m_cBuffer.swap(data);
+    data.clear();
+}
+
+const unsigned char *Toolkit::GetCBuffer()
+{
+    return (m_cBuffer.empty()) ? NULL : m_cBuffer.data();
+}
+
 const char *Toolkit::GetCString()
 {
     if (m_cString) {
@@ -239,6 +239,76 @@ SystemAligner::SpacingType SystemAligner::CalculateSpacingAbove(StaffDef *staffD
     return spacingType;
 }
 
+//----------------------------------------------------------------------------
+// HorizontalBBoxIndex
+//----------------------------------------------------------------------------
+
+HorizontalBBoxIndex::HorizontalBBoxIndex(int bucketWidth)
+{
+    assert(bucketWidth > 0);
+
+    m_bucketWidth = bucketWidth;
+}
+
+int HorizontalBBoxIndex::GetBucket(int x) const
+{
+    // round towards negative infinity
+    return (x >= 0) ? (x / m_bucketWidth) : (-((-x - 1) / m_bucketWidth) - 1);
+}
+
+void HorizontalBBoxIndex::Add(BoundingBox *box)
+{
+    assert(box);
+
+    if (!box->HasContentBB()) return;
+
+    Entry entry;
+    entry.m_box = box;
+    entry.m_left = box->GetContentLeft();
+    entry.m_right = box->GetContentRight();
+
+    const int index = (int)m_entries.size();
+    m_entries.push_back(entry);
+    const int last = this->GetBucket(entry.m_right);
+    for (int bucket = this->GetBucket(entry.m_left); bucket <= last; ++bucket) {
+        m_buckets[bucket].push_back(index);
+    }
+}
+
+void HorizontalBBoxIndex::Clear()
+{
+    m_entries.clear();
+    m_buckets.clear();
+}
+
+void HorizontalBBoxIndex::FindHorizontalContentOverlaps(const BoundingBox *box, ArrayOfBoundingBoxes &overlaps)
+{
+    assert(box);
+
+    overlaps.clear();
+    if (!box->HasContentBB()) return;
+
+    const int left = box->GetContentLeft();
+    const int right = box->GetContentRight();
+
+    m_candidates.clear();
+    auto end = m_buckets.upper_bound(this->GetBucket(right));
+    for (auto iter = m_buckets.lower_bound(this->GetBucket(left)); iter != end; ++iter) {
+        m_candidates.insert(m_candidates.end(), iter->second.begin(), iter->second.end());
+    }
+    // boxes covering several buckets are found more than once
+    std::sort(m_candidates.begin(), m_candidates.end());
+    m_candidates.erase(std::unique(m_candidates.begin(), m_candidates.end()), m_candidates.end());
+
+    // same test as in BoundingBox::HorizontalContentOverlap
+    for (int index : m_candidates) {
+        const Entry &entry = m_entries.at(index);
+        if (right <= entry.m_left) continue;
+        if (left >= entry.m_right) continue;
+        overlaps.push_back(entry.m_box);
+    }
+}
+
 //----------------------------------------------------------------------------
 // StaffAlignment
 //----------------------------------------------------------------------------
@@ -260,6 +330,16 @@ StaffAlignment::~StaffAlignment()
     ClearPositioners();
 }
 
+void *StaffAlignment::operator new(size_t size)
+{
+    return LayoutPool::Allocate(size);
+}
+
+void StaffAlignment::operator delete(void *block, size_t size)
+{
+    LayoutPool::Release(block, size);
+}
+
 void StaffAlignment::ClearPositioners()
 {
     ArrayOfFloatingPositioners::iterator iter;
@@ -573,11 +653,9 @@ void StaffAlignment::ReAdjustFloatingPositionersGrps(AdjustFloatingPositionerGrp
 // Functors methods
 //----------------------------------------------------------------------------
 
-int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
+void StaffAlignment::AdjustFloatingPositionersForClass(AdjustFloatingPositionersParams *params,
+    HorizontalBBoxIndex &overflowAboveIndex, HorizontalBBoxIndex &overflowBelowIndex)
 {
-    AdjustFloatingPositionersParams *params = vrv_params_cast<AdjustFloatingPositionersParams *>(functorParams);
-    assert(params);
-
     int staffSize = this->GetStaffSize();
 
     if (params->m_classId == SYL) {
@@ -593,8 +671,9 @@ int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
             // For now just clear the overflowBelow, which avoids the overlap to be calculated. We could also keep them
             // and check if they are some lyrics in order to know if the overlap needs to be calculated or not.
             m_overflowBelowBBoxes.clear();
+            overflowBelowIndex.Clear();
         }
-        return FUNCTOR_SIBLINGS;
+        return;
     }
 
     ArrayOfFloatingPositioners::iterator iter;
@@ -639,6 +718,7 @@ int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
                 // LogMessage("%sparams->m_doc top overflow: %d", this->GetUuid().c_str(), overflowAbove);
                 this->SetOverflowAbove(overflowAbove);
                 m_overflowAboveBBoxes.push_back((*iter));
+                overflowAboveIndex.Add((*iter));
             }
 
             int overflowBelow = 0;
@@ -647,6 +727,7 @@ int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
                 // LogMessage("%s bottom overflow: %d", this->GetUuid().c_str(), overflowBelow);
                 this->SetOverflowBelow(overflowBelow);
                 m_overflowBelowBBoxes.push_back((*iter));
+                overflowBelowIndex.Add((*iter));
             }
             continue;
         }
@@ -655,36 +736,80 @@ int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
         (*iter)->CalcDrawingYRel(params->m_doc, this, NULL);
 
         ArrayOfBoundingBoxes *overflowBoxes = &m_overflowBelowBBoxes;
+        HorizontalBBoxIndex *overflowIndex = &overflowBelowIndex;
         // above?
         data_STAFFREL place = (*iter)->GetDrawingPlace();
         if (place == STAFFREL_above) {
             overflowBoxes = &m_overflowAboveBBoxes;
+            overflowIndex = &overflowAboveIndex;
         }
-        auto i = overflowBoxes->begin();
-        auto end = overflowBoxes->end();
-        while (i != end) {
-            // find all the overflowing elements from the staff that overlap horizontally
-            i = std::find_if(i, end, [iter](BoundingBox *elem) { return (*iter)->HorizontalContentOverlap(elem); });
-            if (i != end) {
-                // update the yRel accordingly
-                (*iter)->CalcDrawingYRel(params->m_doc, this, *i);
-                i++;
-            }
+        // find all the overflowing elements from the staff that overlap horizontally
+        overflowIndex->FindHorizontalContentOverlaps((*iter), params->m_overlappingBBoxes);
+        for (BoundingBox *overlappingBBox : params->m_overlappingBBoxes) {
+            // update the yRel accordingly
+            (*iter)->CalcDrawingYRel(params->m_doc, this, overlappingBBox);
         }
         //  Now update the staffAlignment max overflow (above or below) and add the positioner to the list of
         //  overflowing elements
         if (place == STAFFREL_above) {
             int overflowAbove = this->CalcOverflowAbove((*iter));
             overflowBoxes->push_back((*iter));
+            overflowIndex->Add((*iter));
             this->SetOverflowAbove(overflowAbove);
         }
         // below (or between)
         else {
             int overflowBelow = this->CalcOverflowBelow((*iter));
             overflowBoxes->push_back((*iter));
+            overflowIndex->Add((*iter));
             this->SetOverflowBelow(overflowBelow);
         }
     }
+}
+
+int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
+{
+    AdjustFloatingPositionersParams *params = vrv_params_cast<AdjustFloatingPositionersParams *>(functorParams);
+    assert(params);
+
+    // The order in which the classes are processed, with the classes of the groups to adjust after each of them
+    static const std::vector<std::pair<ClassId, std::vector<ClassId>>> classIds = { { GLISS, {} }, { TIE, {} },
+        { SLUR, {} }, { PHRASE, {} }, { MORDENT, {} }, { TURN, {} }, { TRILL, {} }, { DYNAM, {} },
+        { HAIRPIN, { DYNAM, HAIRPIN } }, { BRACKETSPAN, {} }, { OCTAVE, {} }, { BREATH, {} }, { FERMATA, {} },
+        { FING, {} }, { DIR, { DIR } }, { TEMPO, {} }, { PEDAL, { PEDAL } }, { HARM, { HARM } },
+        { ENDING, { ENDING } }, { REH, {} },
+        // SYL check if they are some lyrics and make space for them if any
+        { SYL, {} } };
+
+    // The overflowing boxes are indexed once for all the classes of the staff
+    const int bucketWidth = OVERFLOW_BBOX_BUCKET_WIDTH * params->m_doc->GetDrawingUnit(this->GetStaffSize());
+    HorizontalBBoxIndex overflowAboveIndex(bucketWidth);
+    HorizontalBBoxIndex overflowBelowIndex(bucketWidth);
+    for (BoundingBox *box : m_overflowAboveBBoxes) overflowAboveIndex.Add(box);
+    for (BoundingBox *box : m_overflowBelowBBoxes) overflowBelowIndex.Add(box);
+
+    AdjustFloatingPositionerGrpsParams adjustFloatingPositionerGrpsParams(params->m_doc);
+
+    params->m_inBetween = false;
+    for (auto const &classId : classIds) {
+        params->m_classId = classId.first;
+        this->AdjustFloatingPositionersForClass(params, overflowAboveIndex, overflowBelowIndex);
+        if (classId.second.empty()) continue;
+
+        adjustFloatingPositionerGrpsParams.m_classIds = classId.second;
+        adjustFloatingPositionerGrpsParams.m_place = STAFFREL_above;
+        this->AdjustFloatingPositionerGrps(&adjustFloatingPositionerGrpsParams);
+        adjustFloatingPositionerGrpsParams.m_place = STAFFREL_below;
+        this->AdjustFloatingPositionerGrps(&adjustFloatingPositionerGrpsParams);
+    }
+
+    /**** Process elements that needs to be put in between ****/
+
+    params->m_inBetween = true;
+    // All of them with no particular processing order.
+    // The resulting layout order will correspond to the order in the encoding.
+    params->m_classId = OBJECT;
+    this->AdjustFloatingPositionersForClass(params, overflowAboveIndex, overflowBelowIndex);
 
     return FUNCTOR_SIBLINGS;
 }
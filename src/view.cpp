@@ -63,6 +63,12 @@ void View::SetDoc(Doc *doc)
     m_pageIdx = 0;
 }
 
+void View::CopyThicknessCoeficients(const View &view)
+{
+    m_tieThicknessCoeficient = view.m_tieThicknessCoeficient;
+    m_slurThicknessCoeficient = view.m_slurThicknessCoeficient;
+}
+
 void View::SetPage(int pageIdx, bool doLayout)
 {
     assert(m_doc); // Page cannot be NULL
@@ -128,7 +134,7 @@ int View::ToDeviceContextY(int i)
         return 0;
     }
 
-    return (m_doc->m_drawingPageContentHeight - i); // flipped
+    return (m_doc->GetDrawingValues()->m_pageContentHeight - i); // flipped
 }
 
 /** y value in the Logical world  */
@@ -138,7 +144,7 @@ int View::ToLogicalY(int i)
         return 0;
     }
 
-    return m_doc->m_drawingPageContentHeight - i; // flipped
+    return m_doc->GetDrawingValues()->m_pageContentHeight - i; // flipped
 }
 
 Point View::ToDeviceContext(Point p)
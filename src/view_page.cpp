@@ -64,6 +64,8 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
 
     m_currentPage = m_doc->SetDrawingPage(m_pageIdx);
 
+    dc->SetTextExtentCache(m_doc->GetTextExtentCache());
+
     int i;
 
     // Keep the width of the initial scoreDef
@@ -80,11 +82,13 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
         dc->SetContentHeight(dc->GetHeight());
     }
 
-    // if (background) dc->DrawRectangle(0, 0, m_doc->m_drawingPageWidth, m_doc->m_drawingPageHeight);
+    // if (background) dc->DrawRectangle(0, 0, m_doc->GetDrawingValues()->m_pageWidth,
+    // m_doc->GetDrawingValues()->m_pageHeight);
     dc->DrawBackgroundImage();
 
     Point origin = dc->GetLogicalOrigin();
-    dc->SetLogicalOrigin(origin.x - m_doc->m_drawingPageMarginLeft, origin.y - m_doc->m_drawingPageMarginTop);
+    dc->SetLogicalOrigin(origin.x - m_doc->GetDrawingValues()->m_pageMarginLeft,
+        origin.y - m_doc->GetDrawingValues()->m_pageMarginTop);
 
     dc->StartPage();
 
@@ -159,8 +163,9 @@ void View::DrawSystem(DeviceContext *dc, System *system)
 
     DrawSystemDivider(dc, system, firstMeasure);
 
-    // first we need to clear the drawing list of postponed elements
+    // first we need to clear the drawing list of postponed elements and the index of spanned elements
     system->ResetDrawingList();
+    system->ResetSpannedElementIndex();
 
     if (firstMeasure) {
         DrawScoreDef(dc, system->GetDrawingScoreDef(), firstMeasure, system->GetDrawingX(), NULL);
@@ -26,10 +26,12 @@
 #include "measure.h"
 #include "note.h"
 #include "options.h"
+#include "page.h"
 #include "slur.h"
 #include "staff.h"
 #include "system.h"
 #include "timeinterface.h"
+#include "verticalaligner.h"
 #include "vrv.h"
 
 namespace vrv {
@@ -49,8 +51,12 @@ void View::DrawSlur(DeviceContext *dc, Slur *slur, int x1, int x2, Staff *staff,
     FloatingCurvePositioner *curve = vrv_cast<FloatingCurvePositioner *>(positioner);
     assert(curve);
 
-    if (dc->Is(BBOX_DEVICE_CONTEXT) && (curve->GetDir() == curvature_CURVEDIR_NONE || curve->IsCrossStaff())) {
-        this->DrawSlurInitial(curve, slur, x1, x2, staff, spanningType);
+    if (dc->Is(BBOX_DEVICE_CONTEXT)) {
+        if (curve->GetDir() == curvature_CURVEDIR_NONE || curve->IsCrossStaff()) {
+            this->DrawSlurInitial(curve, slur, x1, x2, staff, spanningType);
+        }
+        // Keep the parameters for redrawing only the curve in View::DrawCurrentPageSlurs
+        curve->SetDrawingParams(x1, x2, staff, spanningType, graphic);
     }
 
     Point points[4];
@@ -92,6 +98,41 @@ void View::DrawSlur(DeviceContext *dc, Slur *slur, int x1, int x2, Staff *staff,
         dc->EndGraphic(slur, this);
 }
 
+void View::DrawCurrentPageSlurs(DeviceContext *dc)
+{
+    assert(dc);
+    assert(dc->Is(BBOX_DEVICE_CONTEXT));
+    assert(m_doc);
+
+    m_currentPage = m_doc->SetDrawingPage(m_pageIdx);
+
+    for (auto child : *m_currentPage->GetChildren()) {
+        if (!child->Is(SYSTEM)) continue;
+        System *system = vrv_cast<System *>(child);
+        assert(system);
+
+        // The content bounding box of the system is updated as when drawing the page
+        dc->ResumeGraphic(system, system->GetUuid());
+        for (auto alignmentChild : *system->m_systemAligner.GetChildren()) {
+            StaffAlignment *alignment = vrv_cast<StaffAlignment *>(alignmentChild);
+            assert(alignment);
+            for (FloatingPositioner *positioner : alignment->GetFloatingPositioners()) {
+                if (!positioner->GetObject()->Is({ PHRASE, SLUR })) continue;
+                FloatingCurvePositioner *curve = vrv_cast<FloatingCurvePositioner *>(positioner);
+                assert(curve);
+                // The slur was not drawn with the page
+                if (!curve->HasDrawingParams()) continue;
+                Slur *slur = vrv_cast<Slur *>(curve->GetObject());
+                assert(slur);
+                slur->SetCurrentFloatingPositioner(curve);
+                this->DrawSlur(dc, slur, curve->GetDrawingX1(), curve->GetDrawingX2(), curve->GetDrawingStaff(),
+                    curve->GetDrawingSpanningType(), curve->GetDrawingGraphic());
+            }
+        }
+        dc->EndResumedGraphic(system, this);
+    }
+}
+
 void View::DrawSlurInitial(FloatingCurvePositioner *curve, Slur *slur, int x1, int x2, Staff *staff, char spanningType)
 {
     Beam *parentBeam = NULL;
@@ -570,17 +611,12 @@ float View::CalcInitialSlur(
         staffNumbers.emplace(endStaff->GetN());
     }
 
-    // With the way FindSpannedLayerElements is implemented it's not currently possible to use AttNIntegerAnyComparison
-    // for the filter, since processing goes staff by staff and process stops as soon as maxPos is reached. To
-    // circumvent that, we're going to process each staff separately and add all overlapping elements together in the
-    // end
+    // With the way FindSpannedLayerElements is implemented the search stops as soon as maxPos is reached in a staff.
+    // For this reason, we're going to look at each staff separately and add all overlapping elements together in the
+    // end. The system keeps an index of its layer elements by staff for this.
     std::vector<LayerElement *> elements;
     for (const auto staffNumber : staffNumbers) {
-        ArrayOfComparisons filters;
-        AttNIntegerComparison matchStaff(STAFF, staffNumber);
-        filters.push_back(&matchStaff);
-        Functor findSpannedLayerElements(&Object::FindSpannedLayerElements);
-        system->Process(&findSpannedLayerElements, &findSpannedLayerElementsParams, NULL, &filters);
+        system->FindSpannedLayerElements(&findSpannedLayerElementsParams, staffNumber);
 
         if (!findSpannedLayerElementsParams.m_elements.empty()) {
             elements.insert(elements.end(), std::make_move_iterator(findSpannedLayerElementsParams.m_elements.begin()),
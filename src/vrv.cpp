@@ -12,6 +12,7 @@
 #include <assert.h>
 #include <cmath>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <stdarg.h>
 #include <stdio.h>
@@ -60,50 +61,116 @@ namespace vrv {
 // Static members with some default values
 //----------------------------------------------------------------------------
 
-thread_local std::string Resources::s_path = "/usr/local/share/verovio";
-thread_local Resources::GlyphTextMap Resources::s_textFont;
-thread_local Resources::GlyphMap Resources::s_font;
+std::string Resources::s_path = "/usr/local/share/verovio";
+std::map<std::string, std::unique_ptr<const Resources::MusicFont>> Resources::s_musicFonts;
+std::map<std::string, std::shared_ptr<const Resources::GlyphMap>> Resources::s_fontGlyphs;
+std::map<std::string, std::unique_ptr<const Resources::GlyphTextMap>> Resources::s_textFonts;
+thread_local const Resources::MusicFont *Resources::s_currentFont = NULL;
+thread_local const Resources::GlyphTextMap *Resources::s_currentTextFonts = NULL;
 thread_local Resources::StyleAttributes Resources::s_currentStyle;
 const Resources::StyleAttributes Resources::k_defaultStyle{ data_FONTWEIGHT::FONTWEIGHT_normal,
     data_FONTSTYLE::FONTSTYLE_normal };
+std::map<std::string, std::shared_ptr<const pugi::xml_document>> Resources::s_xmlResources;
+
+/** Mutex protecting Resources::s_xmlResources */
+static std::mutex xmlResourcesMutex;
+
+/** Mutex protecting the resource path and the fonts loaded in Resources */
+static std::mutex fontStoreMutex;
+
+/** The SMuFL private use area */
+static const wchar_t smuflPuaFirst = 0xE000;
+static const wchar_t smuflPuaLast = 0xF8FF;
+
+//----------------------------------------------------------------------------
+// Resources::MusicFont
+//----------------------------------------------------------------------------
+
+const Glyph *Resources::MusicFont::GetGlyph(wchar_t smuflCode) const
+{
+    if ((smuflCode >= smuflPuaFirst) && (smuflCode <= smuflPuaLast)) {
+        return m_table[smuflCode - smuflPuaFirst];
+    }
+    auto it = m_otherGlyphs.find(smuflCode);
+    return (it != m_otherGlyphs.end()) ? it->second : NULL;
+}
+
+void Resources::MusicFont::AddGlyphs(const std::shared_ptr<const GlyphMap> &glyphs)
+{
+    m_glyphs.push_back(glyphs);
+    m_table.resize(smuflPuaLast - smuflPuaFirst + 1, NULL);
+    for (const auto &glyph : *glyphs) {
+        const Glyph *&entry = ((glyph.first >= smuflPuaFirst) && (glyph.first <= smuflPuaLast))
+            ? m_table.at(glyph.first - smuflPuaFirst)
+            : m_otherGlyphs[glyph.first];
+        if (!entry) ++m_glyphCount;
+        entry = &glyph.second;
+    }
+}
 
 //----------------------------------------------------------------------------
 // Font related methods
 //----------------------------------------------------------------------------
 
+std::string Resources::GetPath()
+{
+    std::lock_guard<std::mutex> lock(fontStoreMutex);
+    return s_path;
+}
+
+void Resources::SetPath(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(fontStoreMutex);
+    s_path = path;
+}
+
 bool Resources::InitFonts()
 {
+    std::lock_guard<std::mutex> lock(fontStoreMutex);
+
     // We will need to rethink this for adding the option to add custom fonts
     // Font Bravura first since it is expected to have always all symbols
-    if (!LoadFont("Bravura")) LogError("Bravura font could not be loaded.");
     // The Leipzig as the default font
-    if (!LoadFont("Leipzig")) LogError("Leipzig font could not be loaded.");
+    const MusicFont *font = GetMusicFont(s_path, "Leipzig");
+    if (font) s_currentFont = font;
 
-    if (s_font.size() < SMUFL_COUNT) {
-        LogError("Expected %d default SMuFL glyphs but could load only %d.", SMUFL_COUNT, s_font.size());
+    if (!font || (font->GetGlyphCount() < SMUFL_COUNT)) {
+        LogError("Expected %d default SMuFL glyphs but could load only %d.", SMUFL_COUNT,
+            font ? font->GetGlyphCount() : 0);
         return false;
     }
 
-    struct TextFontInfo_type {
-        const StyleAttributes m_style;
-        const std::string m_fileName;
-        bool m_isMandatory;
-    };
-
-    static const TextFontInfo_type textFontInfos[] = { { k_defaultStyle, "Times", true },
-        { k_defaultStyle, "VerovioText-1.0", true }, { { FONTWEIGHT_bold, FONTSTYLE_normal }, "Times-bold", false },
-        { { FONTWEIGHT_bold, FONTSTYLE_normal }, "VerovioText-1.0", false },
-        { { FONTWEIGHT_bold, FONTSTYLE_italic }, "Times-bold-italic", false },
-        { { FONTWEIGHT_bold, FONTSTYLE_italic }, "VerovioText-1.0", false },
-        { { FONTWEIGHT_normal, FONTSTYLE_italic }, "Times-italic", false },
-        { { FONTWEIGHT_normal, FONTSTYLE_italic }, "VerovioText-1.0", false } };
-
-    for (const auto &textFontInfo : textFontInfos) {
-        if (!InitTextFont(textFontInfo.m_fileName, textFontInfo.m_style) && textFontInfo.m_isMandatory) {
-            LogError("Text font could not be initialized.");
-            return false;
+    auto textFonts = s_textFonts.find(s_path);
+    if (textFonts == s_textFonts.end()) {
+        struct TextFontInfo_type {
+            const StyleAttributes m_style;
+            const std::string m_fileName;
+            bool m_isMandatory;
+        };
+
+        static const TextFontInfo_type textFontInfos[] = { { k_defaultStyle, "Times", true },
+            { k_defaultStyle, "VerovioText-1.0", true }, { { FONTWEIGHT_bold, FONTSTYLE_normal }, "Times-bold", false },
+            { { FONTWEIGHT_bold, FONTSTYLE_normal }, "VerovioText-1.0", false },
+            { { FONTWEIGHT_bold, FONTSTYLE_italic }, "Times-bold-italic", false },
+            { { FONTWEIGHT_bold, FONTSTYLE_italic }, "VerovioText-1.0", false },
+            { { FONTWEIGHT_normal, FONTSTYLE_italic }, "Times-italic", false },
+            { { FONTWEIGHT_normal, FONTSTYLE_italic }, "VerovioText-1.0", false } };
+
+        std::unique_ptr<GlyphTextMap> glyphTextMap(new GlyphTextMap());
+        for (const auto &textFontInfo : textFontInfos) {
+            if (!LoadTextFont(s_path, textFontInfo.m_fileName, (*glyphTextMap)[textFontInfo.m_style])
+                && textFontInfo.m_isMandatory) {
+                LogError("Text font could not be initialized.");
+                return false;
+            }
         }
+        // Styles for which the font could not be loaded are not kept
+        for (auto it = glyphTextMap->begin(); it != glyphTextMap->end();) {
+            it = (it->second.empty()) ? glyphTextMap->erase(it) : std::next(it);
+        }
+        textFonts = s_textFonts.emplace(s_path, std::move(glyphTextMap)).first;
     }
+    s_currentTextFonts = textFonts->second.get();
 
     s_currentStyle = k_defaultStyle;
 
@@ -112,16 +179,21 @@ bool Resources::InitFonts()
 
 bool Resources::SetFont(const std::string &fontName)
 {
-    return LoadFont(fontName);
+    std::lock_guard<std::mutex> lock(fontStoreMutex);
+
+    const MusicFont *font = GetMusicFont(s_path, fontName);
+    if (!font) return false;
+    s_currentFont = font;
+    return true;
 }
 
-Glyph *Resources::GetGlyph(wchar_t smuflCode)
+const Glyph *Resources::GetGlyph(wchar_t smuflCode)
 {
-    if (!s_font.count(smuflCode)) return NULL;
-    return &s_font[smuflCode];
+    if (!s_currentFont) return NULL;
+    return s_currentFont->GetGlyph(smuflCode);
 }
 
-Glyph *Resources::GetGlyph(const std::string &smuflName)
+const Glyph *Resources::GetGlyph(const std::string &smuflName)
 {
     wchar_t code = GetGlyphCode(smuflName);
     if (code == 0) return NULL;
@@ -145,38 +217,101 @@ void Resources::SelectTextFont(data_FONTWEIGHT fontWeight, data_FONTSTYLE fontSt
     }
 
     s_currentStyle = std::make_pair(fontWeight, fontStyle);
-    if (s_textFont.count(s_currentStyle) == 0) {
+    if (!s_currentTextFonts || (s_currentTextFonts->count(s_currentStyle) == 0)) {
         LogWarning("Text font for style (%d, %d) is not loaded. Use default", fontWeight, fontStyle);
         s_currentStyle = k_defaultStyle;
     }
 }
 
-Glyph *Resources::GetTextGlyph(wchar_t code)
+const Glyph *Resources::GetTextGlyph(wchar_t code)
 {
-    GlyphMap *currentMap = &s_textFont[s_textFont.count(s_currentStyle) != 0 ? s_currentStyle : k_defaultStyle];
+    if (!s_currentTextFonts) return NULL;
+
+    auto currentMap = s_currentTextFonts->find(s_currentStyle);
+    if (currentMap == s_currentTextFonts->end()) currentMap = s_currentTextFonts->find(k_defaultStyle);
+    if (currentMap == s_currentTextFonts->end()) return NULL;
 
-    if (currentMap->count(code) == 0) {
+    auto glyph = currentMap->second.find(code);
+    if (glyph == currentMap->second.end()) {
         return NULL;
     }
 
-    return &currentMap->at(code);
+    return &glyph->second;
+}
+
+std::shared_ptr<const pugi::xml_document> Resources::GetXmlResource(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(xmlResourcesMutex);
+
+    auto it = s_xmlResources.find(filename);
+    if (it != s_xmlResources.end()) return it->second;
+
+    auto doc = std::make_shared<pugi::xml_document>();
+    if (!doc->load_file(filename.c_str())) return NULL;
+    s_xmlResources[filename] = doc;
+    return doc;
 }
 
-bool Resources::LoadFont(const std::string &fontName)
+const Resources::MusicFont *Resources::GetMusicFont(const std::string &path, const std::string &fontName)
 {
+    const std::string key = path + "/" + fontName;
+    auto it = s_musicFonts.find(key);
+    if (it != s_musicFonts.end()) return it->second.get();
+
+    // The glyphs missing in the font are taken from Bravura
+    std::unique_ptr<MusicFont> font(new MusicFont());
+    if (fontName != "Bravura") {
+        std::shared_ptr<const GlyphMap> bravura = LoadFont(path, "Bravura");
+        if (!bravura) {
+            LogError("Bravura font could not be loaded.");
+        }
+        else {
+            font->AddGlyphs(bravura);
+        }
+    }
+    std::shared_ptr<const GlyphMap> glyphs = LoadFont(path, fontName);
+    if (!glyphs) {
+        LogError("%s font could not be loaded.", fontName.c_str());
+        return NULL;
+    }
+    font->AddGlyphs(glyphs);
+
+    return s_musicFonts.emplace(key, std::move(font)).first->second.get();
+}
+
+std::shared_ptr<const Resources::GlyphMap> Resources::LoadFont(const std::string &path, const std::string &fontName)
+{
+    const std::string key = path + "/" + fontName;
+    auto it = s_fontGlyphs.find(key);
+    if (it != s_fontGlyphs.end()) return it->second;
+
+    // First load the bounding box file (if provided) - its units-per-em applies to all the glyphs of the font
+    pugi::xml_document doc;
+    std::string filename = path + "/" + fontName + ".xml";
+    pugi::xml_parse_result result = doc.load_file(filename.c_str());
+    pugi::xml_node root = doc.first_child();
+    int unitsPerEm = 0;
+    if (result && root.attribute("units-per-em")) {
+        unitsPerEm = atoi(root.attribute("units-per-em").value());
+    }
+
     ::DIR *dir;
     dirent *pdir;
-    std::string dirname = Resources::GetPath() + "/" + fontName;
+    std::string dirname = path + "/" + fontName;
     dir = opendir(dirname.c_str());
 
     if (!dir) {
         LogError("Font directory '%s' cannot be read", dirname.c_str());
-        return false;
+        return NULL;
     }
 
-    // First loop through the fontName directory and load each glyph
+    std::shared_ptr<GlyphMap> glyphs = std::make_shared<GlyphMap>();
+    s_fontGlyphs[key] = glyphs;
+
+    // Then loop through the fontName directory and create each glyph
     // Since the filename starts with the Unicode code, it is used
     // to assign the glyph to the corresponding position in m_fonts
+    // When the units-per-em are known, the glyph file is not parsed here but only when first used
     while ((pdir = readdir(dir))) {
         if (strstr(pdir->d_name, ".xml")) {
             // E.g, : E053-gClef8va.xml => strtol extracts E053 as hex
@@ -187,38 +322,38 @@ bool Resources::LoadFont(const std::string &fontName)
             }
             std::string codeStr = pdir->d_name;
             codeStr = codeStr.substr(0, 4);
-            Glyph glyph(Resources::GetPath() + "/" + fontName + "/" + pdir->d_name, codeStr);
-            s_font[smuflCode] = glyph;
+            std::string glyphPath = path + "/" + fontName + "/" + pdir->d_name;
+            if (unitsPerEm > 0) {
+                (*glyphs)[smuflCode] = Glyph(glyphPath, codeStr, unitsPerEm);
+            }
+            else {
+                (*glyphs)[smuflCode] = Glyph(glyphPath, codeStr);
+            }
         }
     }
 
     closedir(dir);
 
-    // Then load the bounding boxes (if bounding box file is provided)
-    pugi::xml_document doc;
-    std::string filename = Resources::GetPath() + "/" + fontName + ".xml";
-    pugi::xml_parse_result result = doc.load_file(filename.c_str());
+    // Then load the bounding boxes
     if (!result) {
         // File not found, default bounding boxes will be used
         LogMessage("Font loaded without bounding boxes");
-        return true;
+        return glyphs;
     }
-    pugi::xml_node root = doc.first_child();
-    if (!root.attribute("units-per-em")) {
+    if (unitsPerEm == 0) {
         LogWarning("No units-per-em attribute in bouding box file");
-        return true;
+        return glyphs;
     }
-    int unitsPerEm = atoi(root.attribute("units-per-em").value());
     pugi::xml_node current;
     for (current = root.child("g"); current; current = current.next_sibling("g")) {
         Glyph *glyph = NULL;
         if (current.attribute("c")) {
             wchar_t smuflCode = (wchar_t)strtol(current.attribute("c").value(), NULL, 16);
-            if (!s_font.count(smuflCode)) {
+            if (!glyphs->count(smuflCode)) {
                 LogWarning("Glyph with code '%d' not found.", smuflCode);
                 continue;
             }
-            glyph = &s_font[smuflCode];
+            glyph = &(*glyphs)[smuflCode];
             if (glyph->GetUnitsPerEm() != unitsPerEm * 10) {
                 LogWarning("Glyph and bounding box units-per-em for code '%d' miss-match (bounding box: %d)", smuflCode,
                     unitsPerEm);
@@ -247,16 +382,16 @@ bool Resources::LoadFont(const std::string &fontName)
         }
     }
 
-    return true;
+    return glyphs;
 }
 
-bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes &style)
+bool Resources::LoadTextFont(const std::string &path, const std::string &fontName, GlyphMap &glyphs)
 {
     // For the text font, we load the bounding boxes only
     pugi::xml_document doc;
     // For now, we have only Times bounding boxes for ASCII chars
     // For any other char, we currently use 'o' bounding box
-    std::string filename = Resources::GetPath() + "/text/" + fontName + ".xml";
+    std::string filename = path + "/text/" + fontName + ".xml";
     pugi::xml_parse_result result = doc.load_file(filename.c_str());
     if (!result) {
         // File not found, default bounding boxes will be used
@@ -270,10 +405,6 @@ bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes
     }
     int unitsPerEm = atoi(root.attribute("units-per-em").value());
     pugi::xml_node current;
-    if (s_textFont.count(style) == 0) {
-        s_textFont[style] = GlyphMap{};
-    }
-    GlyphMap &currentMap = s_textFont.at(style);
     for (current = root.child("g"); current; current = current.next_sibling("g")) {
         if (current.attribute("c")) {
             wchar_t code = (wchar_t)strtol(current.attribute("c").value(), NULL, 16);
@@ -288,15 +419,71 @@ bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes
             if (current.attribute("h")) height = atof(current.attribute("h").value());
             glyph.SetBoundingBox(x, y, width, height);
             if (current.attribute("h-a-x")) glyph.SetHorizAdvX(atof(current.attribute("h-a-x").value()));
-            if (currentMap.count(code) > 0) {
+            if (glyphs.count(code) > 0) {
                 LogDebug("Redefining %d with %s", code, fontName.c_str());
             }
-            currentMap[code] = glyph;
+            glyphs[code] = glyph;
         }
     }
     return true;
 }
 
+//----------------------------------------------------------------------------
+// LayoutPool
+//----------------------------------------------------------------------------
+
+/** Size classes are multiples of 16 bytes up to 512 bytes, with 64 blocks per chunk */
+static const size_t layoutPoolGranularity = 16;
+static const size_t layoutPoolSizeClasses = 32;
+static const size_t layoutPoolChunkBlocks = 64;
+
+/** The free list of each size class and the chunks they are carved out of */
+static void *layoutPoolFreeLists[layoutPoolSizeClasses] = { NULL };
+static std::vector<void *> layoutPoolChunks;
+
+/** Mutex protecting the pool when pages are rendered in parallel */
+static std::mutex layoutPoolMutex;
+
+void *LayoutPool::Allocate(size_t size)
+{
+    const size_t sizeClass = (size + layoutPoolGranularity - 1) / layoutPoolGranularity;
+    if ((sizeClass == 0) || (sizeClass > layoutPoolSizeClasses)) return ::operator new(size);
+
+    std::lock_guard<std::mutex> lock(layoutPoolMutex);
+    void *&freeList = layoutPoolFreeLists[sizeClass - 1];
+    if (!freeList) {
+        const size_t blockSize = sizeClass * layoutPoolGranularity;
+        layoutPoolChunks.reserve(layoutPoolChunks.size() + 1);
+        char *chunk = static_cast<char *>(::operator new(blockSize * layoutPoolChunkBlocks));
+        layoutPoolChunks.push_back(chunk);
+        // Chain the blocks of the chunk in the free list, the first bytes of a free block pointing to the next one
+        for (size_t i = layoutPoolChunkBlocks; i > 0; --i) {
+            void *block = chunk + (i - 1) * blockSize;
+            *static_cast<void **>(block) = freeList;
+            freeList = block;
+        }
+    }
+    void *block = freeList;
+    freeList = *static_cast<void **>(block);
+    return block;
+}
+
+void LayoutPool::Release(void *block, size_t size)
+{
+    if (!block) return;
+
+    const size_t sizeClass = (size + layoutPoolGranularity - 1) / layoutPoolGranularity;
+    if ((sizeClass == 0) || (sizeClass > layoutPoolSizeClasses)) {
+        ::operator delete(block);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(layoutPoolMutex);
+    void *&freeList = layoutPoolFreeLists[sizeClass - 1];
+    *static_cast<void **>(block) = freeList;
+    freeList = block;
+}
+
 //----------------------------------------------------------------------------
 // Logging related methods
 //----------------------------------------------------------------------------
@@ -312,6 +499,9 @@ bool loggingToBuffer = false;
 
 std::vector<std::string> logBuffer;
 
+/** Mutex protecting logBuffer when pages are rendered in parallel */
+static std::mutex logBufferMutex;
+
 void LogElapsedTimeStart()
 {
     gettimeofday(&start, NULL);
@@ -390,6 +580,7 @@ void EnableLogToBuffer(bool value)
 void LogString(std::string message, consoleLogLevel level)
 {
     if (loggingToBuffer) {
+        std::lock_guard<std::mutex> lock(logBufferMutex);
         if (LogBufferContains(message)) return;
         logBuffer.push_back(message);
     }
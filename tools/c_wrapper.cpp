@@ -65,6 +65,12 @@ const char *vrvToolkit_getAvailableOptions(void *tkPtr)
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_getBinaryBuffer(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->GetCBuffer();
+}
+
 const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -79,6 +85,13 @@ const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getElementsAtTimes(void *tkPtr, const char *jsonTimes)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetElementsAtTimes(jsonTimes));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -201,6 +214,15 @@ const char *vrvToolkit_renderToMIDI(void *tkPtr, const char *c_options)
     return tk->GetCString();
 }
 
+int vrvToolkit_renderToMIDIBinary(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    std::vector<unsigned char> output;
+    tk->RenderToMIDIBinary(output);
+    tk->SetCBuffer(output);
+    return tk->GetCBufferSize();
+}
+
 const char *vrvToolkit_renderToPAE(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -222,6 +244,15 @@ const char *vrvToolkit_renderToTimemap(void *tkPtr)
     return tk->GetCString();
 }
 
+int vrvToolkit_renderToTimemapBinary(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    std::vector<unsigned char> output;
+    tk->RenderToTimemapBinary(output);
+    tk->SetCBuffer(output);
+    return tk->GetCBufferSize();
+}
+
 void vrvToolkit_redoLayout(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -19,8 +19,10 @@ void *vrvToolkit_constructorResourcePath(const char * resourcePath);
 void vrvToolkit_destructor(void *tkPtr);
 bool vrvToolkit_edit(void *tkPtr, const char *editorAction);
 const char *vrvToolkit_getAvailableOptions(void *tkPtr);
+const unsigned char *vrvToolkit_getBinaryBuffer(void *tkPtr);
 const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec);
+const char *vrvToolkit_getElementsAtTimes(void *tkPtr, const char *jsonTimes);
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getHumdrum(void *tkPtr);
 const char *vrvToolkit_convertHumdrumToHumdrum(void *tkPtr, const char *humdrumData);
@@ -38,9 +40,11 @@ bool vrvToolkit_loadData(void *tkPtr, const char *data);
 bool vrvToolkit_loadZipDataBase64(void *tkPtr, const char *data);
 bool vrvToolkit_loadZipDataBuffer(void *tkPtr, const unsigned char *data, int length);
 const char *vrvToolkit_renderToMIDI(void *tkPtr, const char *c_options);
+int vrvToolkit_renderToMIDIBinary(void *tkPtr);
 const char *vrvToolkit_renderToPAE(void *tkPtr);
 const char *vrvToolkit_renderToSVG(void *tkPtr, int page_no, const char *c_options);
 const char *vrvToolkit_renderToTimemap(void *tkPtr);
+int vrvToolkit_renderToTimemapBinary(void *tkPtr);
 void vrvToolkit_redoLayout(void *tkPtr);
 void vrvToolkit_redoPagePitchPosLayout(void *tkPtr);
 const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options);
@@ -14,7 +14,11 @@
 #include <sys/stat.h>
 
 #ifndef _WIN32
+#include <csignal>
 #include <getopt.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #else
 #include "win_getopt.h"
 #endif
@@ -199,18 +203,266 @@ void display_usage()
     }
 }
 
+// Serialize a JSON object on a single line
+// jsonxx indents with newlines and tabs but always escapes them in strings
+std::string json_line(const jsonxx::Object &o)
+{
+    std::string line = o.json();
+    line.erase(std::remove_if(line.begin(), line.end(), [](char c) { return (c == '\n') || (c == '\t'); }), line.end());
+    return line;
+}
+
+// The settings given on the command line and restored after each job in server mode
+struct ServerSettings {
+    vrv::Options options;
+    std::string inputFrom = "auto";
+    int scale = DEFAULT_SCALE;
+    int xmlIdSeed = 0;
+    int threads = 1;
+};
+
+// Run a job and fill the response - return an error message or an empty string
+std::string run_job(vrv::Toolkit &toolkit, const jsonxx::Object &job, jsonxx::Object &response, std::string &log,
+    const ServerSettings &settings)
+{
+    // Option deltas for this job only
+    if (job.has<jsonxx::Object>("options")) {
+        toolkit.SetOptions(job.get<jsonxx::Object>("options").json());
+        log += toolkit.GetLog();
+    }
+
+    if (settings.xmlIdSeed) vrv::Object::SeedUuid(settings.xmlIdSeed);
+
+    bool loaded = false;
+    if (job.has<jsonxx::String>("data")) {
+        loaded = toolkit.LoadData(job.get<jsonxx::String>("data"));
+    }
+    else if (job.has<jsonxx::String>("input")) {
+        loaded = toolkit.LoadFile(job.get<jsonxx::String>("input"));
+    }
+    else {
+        return "The job has no 'input' or 'data'";
+    }
+    log += toolkit.GetLog();
+    if (!loaded) return "The input could not be loaded";
+
+    std::vector<std::string> outputs;
+    if (job.has<jsonxx::Array>("outputs")) {
+        const jsonxx::Array &values = job.get<jsonxx::Array>("outputs");
+        for (int i = 0; i < (int)values.size(); ++i) {
+            if (values.has<jsonxx::String>(i)) outputs.push_back(values.get<jsonxx::String>(i));
+        }
+    }
+    else {
+        outputs.push_back("svg");
+    }
+
+    const int pageCount = toolkit.GetPageCount();
+    response << "pageCount" << pageCount;
+
+    for (const std::string &output : outputs) {
+        if (output == "svg") {
+            std::vector<std::string> pages;
+            // One page or all of them
+            if (job.has<jsonxx::Number>("page")) {
+                const int page = (int)job.get<jsonxx::Number>("page");
+                if ((page < 1) || (page > pageCount)) {
+                    return vrv::StringFormat("The page requested (%d) is not in the page range (max is %d)", page,
+                        pageCount);
+                }
+                pages.push_back(toolkit.RenderToSVG(page));
+            }
+            else if (settings.threads > 1) {
+                pages = toolkit.RenderAllPagesToSVG(settings.threads);
+            }
+            else {
+                for (int p = 1; p <= pageCount; ++p) {
+                    pages.push_back(toolkit.RenderToSVG(p));
+                }
+            }
+            jsonxx::Array svg;
+            for (const std::string &page : pages) svg << page;
+            response << "svg" << svg;
+        }
+        else if (output == "midi") {
+            response << "midi" << toolkit.RenderToMIDI();
+        }
+        else if (output == "timemap") {
+            response << "timemap" << toolkit.RenderToTimemap();
+        }
+        else if ((output == "mei") || (output == "pb-mei")) {
+            const char *scoreBased = (output == "mei") ? "true" : "false";
+            const char *removeIds = (toolkit.GetOptions()->m_removeIds.GetValue()) ? "true" : "false";
+            std::string params = vrv::StringFormat("{'scoreBased': %s, 'removeIds': %s}", scoreBased, removeIds);
+            response << output << toolkit.GetMEI(params);
+        }
+        else if (output == "pae") {
+            response << "pae" << toolkit.RenderToPAE();
+        }
+        else {
+            return "Output format (" + output + ") can only be 'mei', 'pb-mei', 'svg', 'midi', 'timemap' or 'pae'";
+        }
+        log += toolkit.GetLog();
+    }
+
+    return "";
+}
+
+// Process one line of newline-delimited JSON and return the response line
+std::string process_job(vrv::Toolkit &toolkit, const std::string &line, const ServerSettings &settings)
+{
+    jsonxx::Object job;
+    jsonxx::Object response;
+
+    if (!job.parse(line)) {
+        response << "status"
+                 << "error";
+        response << "error"
+                 << "The job could not be parsed as JSON";
+        return json_line(response);
+    }
+
+    if (job.kv_map().count("id")) response.import("id", *job.kv_map().at("id"));
+
+    std::string log;
+    std::string error = run_job(toolkit, job, response, log, settings);
+
+    // Restore the options of the command line for the next job
+    if (job.has<jsonxx::Object>("options")) {
+        *toolkit.GetOptions() = settings.options;
+        toolkit.GetOptions()->Sync();
+        toolkit.SetScale(settings.scale);
+        toolkit.SetInputFrom(settings.inputFrom);
+        vrv::Resources::SetFont(settings.options.m_font.GetValue());
+        log += toolkit.GetLog();
+    }
+
+    if (error.empty()) {
+        response << "status"
+                 << "ok";
+    }
+    else {
+        response << "status"
+                 << "error";
+        response << "error" << error;
+    }
+    if (!log.empty()) response << "log" << log;
+
+    return json_line(response);
+}
+
+#ifndef _WIN32
+// Write the whole response to a socket client
+bool write_response(int client, const std::string &response)
+{
+    for (size_t written = 0; written < response.size();) {
+        ssize_t count = write(client, response.c_str() + written, response.size() - written);
+        if (count <= 0) return false;
+        written += count;
+    }
+    return true;
+}
+
+// Read the jobs from the clients of a local socket, one client after the other
+bool run_socket_server(vrv::Toolkit &toolkit, const std::string &path, const ServerSettings &settings)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "The socket path '" << path << "' is too long." << std::endl;
+        return false;
+    }
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if ((server < 0) || (bind(server, (sockaddr *)&address, sizeof(address)) < 0) || (listen(server, 8) < 0)) {
+        std::cerr << "The socket '" << path << "' could not be opened." << std::endl;
+        if (server >= 0) close(server);
+        return false;
+    }
+    // A client closing the connection must not stop the server
+    signal(SIGPIPE, SIG_IGN);
+    std::cerr << "Listening on " << path << "." << std::endl;
+
+    char buffer[65536];
+    while (true) {
+        int client = accept(server, NULL, NULL);
+        if (client < 0) continue;
+
+        std::string data;
+        ssize_t size = 0;
+        bool connected = true;
+        while (connected && ((size = read(client, buffer, sizeof(buffer))) > 0)) {
+            data.append(buffer, size);
+            size_t start = 0;
+            size_t end = 0;
+            while (connected && ((end = data.find('\n', start)) != std::string::npos)) {
+                std::string line = data.substr(start, end - start);
+                start = end + 1;
+                if (line.empty()) continue;
+                connected = write_response(client, process_job(toolkit, line, settings) + "\n");
+            }
+            data.erase(0, start);
+        }
+        // the last job might not end with a newline
+        if (connected && !data.empty()) {
+            write_response(client, process_job(toolkit, data, settings) + "\n");
+        }
+        close(client);
+    }
+
+    close(server);
+    return true;
+}
+#endif
+
+// Process the jobs read from the standard input or from a socket
+// Each job is one line of JSON, for example:
+//   {"id": 1, "input": "file.mei", "options": {"pageWidth": 1500}, "outputs": ["svg", "midi"], "page": 1}
+// with "data" instead of "input" for inline data. The outputs are "svg" (default), "midi" (base64), "timemap",
+// "mei", "pb-mei" and "pae", and SVG is rendered for all pages unless "page" is given. The options apply to the job
+// only. The response is one line of JSON with the "id", the "status" ("ok" or "error"), the "pageCount", the outputs
+// and the "error" and "log" messages if any.
+int run_server(vrv::Toolkit &toolkit, const std::string &socketPath, const ServerSettings &settings)
+{
+    // The log is returned with each response
+    vrv::EnableLogToBuffer(true);
+
+    if (!socketPath.empty()) {
+#ifndef _WIN32
+        return (run_socket_server(toolkit, socketPath, settings)) ? 0 : 1;
+#else
+        std::cerr << "Sockets are not supported on this platform." << std::endl;
+        return 1;
+#endif
+    }
+
+    for (std::string line; getline(std::cin, line);) {
+        if (line.empty()) continue;
+        std::cout << process_job(toolkit, line, settings) << std::endl;
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     std::string infile;
     std::string svgdir;
     std::string outfile;
     std::string outformat = "svg";
+    std::string input_from = "auto";
+    std::string server_socket;
     bool std_output = false;
 
     int all_pages = 0;
     int page = 1;
+    int threads = 1;
     int show_help = 0;
     int show_version = 0;
+    int server = 0;
+    int xml_id_seed = 0;
 
     // Create the toolkit instance without loading the font because
     // the resource path might be specified in the parameters
@@ -227,6 +479,7 @@ int main(int argc, char **argv)
         = { { "all-pages", no_argument, 0, 'a' },
             { "from", required_argument, 0, 'f' },
             { "help", no_argument, 0, 'h' },
+            { "threads", required_argument, 0, 'j' },
             { "outfile", required_argument, 0, 'o' },
             { "page", required_argument, 0, 'p' },
             { "resources", required_argument, 0, 'r' },
@@ -236,6 +489,9 @@ int main(int argc, char **argv)
             { "xml-id-seed", required_argument, 0, 'x' },
             // standard input - long options only or - as filename
             { "stdin", no_argument, 0, 'z' },
+            // server mode - long options only
+            { "server", no_argument, 0, 'S' },
+            { "server-socket", required_argument, 0, 'U' },
             { 0, 0, 0, 0 }
         };
 
@@ -281,7 +537,7 @@ int main(int argc, char **argv)
     int option_index = 0;
     vrv::Option *opt = NULL;
     vrv::OptionBool *optBool = NULL;
-    while ((c = getopt_long(argc, argv, "ab:f:ho:p:r:s:t:vx:z", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "ab:f:hj:o:p:r:s:t:vx:z", long_options, &option_index)) != -1) {
         switch (c) {
             case 0:
                 key = long_options[option_index].name;
@@ -318,8 +574,11 @@ int main(int argc, char **argv)
                 if (!toolkit.SetInputFrom(std::string(optarg))) {
                     exit(1);
                 };
+                input_from = std::string(optarg);
                 break;
 
+            case 'j': threads = atoi(optarg); break;
+
             case 'o': outfile = std::string(optarg); break;
 
             case 'p': page = atoi(optarg); break;
@@ -339,7 +598,10 @@ int main(int argc, char **argv)
 
             case 'v': show_version = 1; break;
 
-            case 'x': vrv::Object::SeedUuid(atoi(optarg)); break;
+            case 'x':
+                xml_id_seed = atoi(optarg);
+                vrv::Object::SeedUuid(xml_id_seed);
+                break;
 
             case 'z':
                 if (!strcmp(long_options[option_index].name, "stdin")) {
@@ -347,6 +609,13 @@ int main(int argc, char **argv)
                 }
                 break;
 
+            case 'S': server = 1; break;
+
+            case 'U':
+                server = 1;
+                server_socket = std::string(optarg);
+                break;
+
             case 'h': display_usage(); exit(0); break;
 
             case '?': display_usage(); exit(1); break;
@@ -370,7 +639,7 @@ int main(int argc, char **argv)
     if (optind <= argc - 1) {
         infile = std::string(argv[optind]);
     }
-    else if (infile != "-") {
+    else if ((infile != "-") && !server) {
         std::cerr << "Incorrect number of arguments: expected one input file but found none." << std::endl << std::endl;
         display_usage();
         exit(1);
@@ -397,9 +666,21 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    if (server) {
+        ServerSettings settings;
+        settings.options = *options;
+        settings.inputFrom = input_from;
+        settings.scale = toolkit.GetScale();
+        settings.xmlIdSeed = xml_id_seed;
+        settings.threads = threads;
+        free(long_options);
+        return run_server(toolkit, server_socket, settings);
+    }
+
     if ((outformat != "svg") && (outformat != "mei") && (outformat != "midi") && (outformat != "timemap")
+        && (outformat != "timemap-bin")
         && (outformat != "humdrum") && (outformat != "hum") && (outformat != "pae") && (outformat != "pb-mei")) {
-        std::cerr << "Output format (" << outformat << ") can only be 'mei', 'pb-mei', 'svg', 'midi', 'humdrum' or 'pae'." << std::endl;
+        std::cerr << "Output format (" << outformat << ") can only be 'mei', 'pb-mei', 'svg', 'midi', 'timemap', 'timemap-bin', 'humdrum' or 'pae'." << std::endl;
         exit(1);
     }
 
@@ -460,7 +741,25 @@ int main(int argc, char **argv)
         to = toolkit.GetPageCount() + 1;
     }
 
-    if (outformat == "svg") {
+    if ((outformat == "svg") && all_pages && (threads > 1)) {
+        std::vector<std::string> pages = toolkit.RenderAllPagesToSVG(threads, !std_output);
+        int p;
+        for (p = from; p < to; ++p) {
+            if (std_output) {
+                std::cout << pages.at(p - 1);
+                continue;
+            }
+            std::string cur_outfile = outfile + vrv::StringFormat("_%03d", p) + ".svg";
+            std::ofstream svgfile(cur_outfile.c_str());
+            if (!svgfile.is_open()) {
+                std::cerr << "Unable to write SVG to " << cur_outfile << "." << std::endl;
+                exit(1);
+            }
+            svgfile << pages.at(p - 1);
+            std::cerr << "Output written to " << cur_outfile << "." << std::endl;
+        }
+    }
+    else if (outformat == "svg") {
         int p;
         for (p = from; p < to; ++p) {
             std::string cur_outfile = outfile;
@@ -509,6 +808,21 @@ int main(int argc, char **argv)
             std::cerr << "Output written to " << outfile << "." << std::endl;
         }
     }
+    else if (outformat == "timemap-bin") {
+        outfile += ".timemap";
+        if (std_output) {
+            std::vector<unsigned char> output;
+            toolkit.RenderToTimemapBinary(output);
+            std::cout.write(reinterpret_cast<const char *>(output.data()), output.size());
+        }
+        else if (!toolkit.RenderToTimemapBinaryFile(outfile)) {
+            std::cerr << "Unable to write timemap to " << outfile << "." << std::endl;
+            exit(1);
+        }
+        else {
+            std::cerr << "Output written to " << outfile << "." << std::endl;
+        }
+    }
     else if (outformat == "humdrum" || outformat == "hum") {
         if (toolkit.GetInputFrom() == vrv::MEI) {
             std::string meidata;